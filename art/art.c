@@ -0,0 +1,782 @@
+/*
+ * Adaptívny radix strom (ART)
+ *
+ * Podľa V. Leis, A. Kemper, T. Neumann: The Adaptive Radix Tree: ARTful
+ * Indexing for Main-Memory Databases (ICDE 2013).
+ *
+ * Kľúč sa indexuje vrátane ukončovacieho znaku '\0', preto žiadny kľúč nie
+ * je prefixom iného a každý kľúč končí v liste. Listy sa od uzlov odlišujú
+ * najnižším bitom ukazovateľa.
+ *
+ * Prefix uzlu je pesimistický do ART_MAX_PREFIX bajtov a optimistický nad
+ * túto dĺžku: hľadanie zvyšok prefixu preskočí a kľúč overí až v liste,
+ * vkladanie a mazanie prefixu dočíta chýbajúce bajty z ľubovoľného listu
+ * pod uzlom.
+ *
+ * Uzol s 16 potomkami hľadá kľúč jedným porovnaním SSE2, ak je k dispozícii.
+ */
+
+#include "art.h"
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#define ART_IS_LEAF(NODE) (((uintptr_t)(NODE)) & 1)
+#define ART_LEAF(NODE) ((art_leaf_t *)((uintptr_t)(NODE) & ~(uintptr_t)1))
+#define ART_TAG_LEAF(LEAF) ((art_node_t *)((uintptr_t)(LEAF) | 1))
+
+#define ART_MIN(A, B) ((A) < (B) ? (A) : (B))
+
+struct art_node {
+    uint8_t type;              // art_node_type_t
+    uint16_t children_count;   // počet potomkov
+    uint32_t prefix_length;    // celá dĺžka prefixu
+    unsigned char prefix[ART_MAX_PREFIX]; // začiatok prefixu
+};
+
+typedef struct art_node4 {
+    art_node_t node;
+    unsigned char keys[4]; // zoradené bajty potomkov
+    art_node_t *children[4];
+} art_node4_t;
+
+typedef struct art_node16 {
+    art_node_t node;
+    unsigned char keys[16]; // zoradené bajty potomkov
+    art_node_t *children[16];
+} art_node16_t;
+
+typedef struct art_node48 {
+    art_node_t node;
+    unsigned char index[256]; // index potomka + 1 pre každý bajt, 0 bez potomka
+    art_node_t *children[48];
+} art_node48_t;
+
+typedef struct art_node256 {
+    art_node_t node;
+    art_node_t *children[256];
+} art_node256_t;
+
+static const size_t art_node_sizes[ART_NODE_TYPES] = {
+    sizeof(art_node4_t), sizeof(art_node16_t), sizeof(art_node48_t),
+    sizeof(art_node256_t)};
+
+static art_node_t *art_alloc_node(art_node_type_t type) {
+    art_node_t *node = calloc(1, art_node_sizes[type]);
+    if (node == NULL) abort();
+    node->type = (uint8_t)type;
+    return node;
+}
+
+static void art_copy_header(art_node_t *dest, const art_node_t *src) {
+    dest->children_count = src->children_count;
+    dest->prefix_length = src->prefix_length;
+    memcpy(dest->prefix, src->prefix,
+           ART_MIN(src->prefix_length, ART_MAX_PREFIX));
+}
+
+static bool art_leaf_matches(const art_leaf_t *leaf, const char *key,
+                             size_t length) {
+    return leaf->key_length == length && memcmp(leaf->key, key, length) == 0;
+}
+
+/*
+ * Pozícia potomka 16-uzlu pre bajt c alebo -1.
+ */
+static int art_node16_find(const art_node16_t *node, unsigned char c) {
+#ifdef __SSE2__
+    __m128i keys = _mm_loadu_si128((const __m128i *)node->keys);
+    __m128i equal = _mm_cmpeq_epi8(_mm_set1_epi8((char)c), keys);
+    unsigned mask = (unsigned)_mm_movemask_epi8(equal) &
+                    ((1u << node->node.children_count) - 1);
+    return mask != 0 ? __builtin_ctz(mask) : -1;
+#else
+    for (int i = 0; i < node->node.children_count; i++) {
+        if (node->keys[i] == c) return i;
+    }
+    return -1;
+#endif
+}
+
+/*
+ * Ukazovateľ na odkaz potomka pre bajt c alebo NULL.
+ */
+static art_node_t **art_find_child(art_node_t *node, unsigned char c) {
+    switch (node->type) {
+    case ART_NODE4: {
+        art_node4_t *n = (art_node4_t *)node;
+        for (int i = 0; i < node->children_count; i++) {
+            if (n->keys[i] == c) return &n->children[i];
+        }
+        return NULL;
+    }
+    case ART_NODE16: {
+        art_node16_t *n = (art_node16_t *)node;
+        int i = art_node16_find(n, c);
+        return i >= 0 ? &n->children[i] : NULL;
+    }
+    case ART_NODE48: {
+        art_node48_t *n = (art_node48_t *)node;
+        return n->index[c] != 0 ? &n->children[n->index[c] - 1] : NULL;
+    }
+    default: {
+        art_node256_t *n = (art_node256_t *)node;
+        return n->children[c] != NULL ? &n->children[c] : NULL;
+    }
+    }
+}
+
+static art_leaf_t *art_minimum(art_node_t *node) {
+    while (!ART_IS_LEAF(node)) {
+        switch (node->type) {
+        case ART_NODE4:
+            node = ((art_node4_t *)node)->children[0];
+            break;
+        case ART_NODE16:
+            node = ((art_node16_t *)node)->children[0];
+            break;
+        case ART_NODE48: {
+            art_node48_t *n = (art_node48_t *)node;
+            int c = 0;
+            while (n->index[c] == 0) c++;
+            node = n->children[n->index[c] - 1];
+            break;
+        }
+        default: {
+            art_node256_t *n = (art_node256_t *)node;
+            int c = 0;
+            while (n->children[c] == NULL) c++;
+            node = n->children[c];
+            break;
+        }
+        }
+    }
+    return ART_LEAF(node);
+}
+
+/*
+ * Počet zhodných bajtov kľúča s uloženou časťou prefixu uzlu.
+ */
+static size_t art_check_prefix(const art_node_t *node, const char *key,
+                               size_t length, size_t depth) {
+    size_t limit = ART_MIN(ART_MIN(node->prefix_length, ART_MAX_PREFIX),
+                           length - depth);
+    size_t i = 0;
+    while (i < limit && node->prefix[i] == (unsigned char)key[depth + i]) i++;
+    return i;
+}
+
+/*
+ * Počet zhodných bajtov kľúča s celým prefixom uzlu. Bajty nad
+ * ART_MAX_PREFIX sa porovnajú s najmenším listom pod uzlom.
+ */
+static size_t art_prefix_mismatch(art_node_t *node, const char *key,
+                                  size_t length, size_t depth) {
+    size_t i = art_check_prefix(node, key, length, depth);
+    if (i < ART_MAX_PREFIX || node->prefix_length <= ART_MAX_PREFIX) return i;
+
+    art_leaf_t *leaf = art_minimum(node);
+    size_t limit = ART_MIN(ART_MIN(leaf->key_length, length) - depth,
+                           node->prefix_length);
+    while (i < limit && leaf->key[depth + i] == key[depth + i]) i++;
+    return i;
+}
+
+static art_leaf_t *art_make_leaf(char *key, size_t length, float value) {
+    art_leaf_t *leaf = malloc(sizeof(art_leaf_t));
+    if (leaf == NULL) abort();
+    leaf->key = key;
+    leaf->value = value;
+    leaf->key_length = (uint32_t)length;
+    return leaf;
+}
+
+static void art_add_child(art_node_t *node, art_node_t **ref, unsigned char c,
+                          art_node_t *child);
+
+static void art_add_child256(art_node256_t *node, unsigned char c,
+                             art_node_t *child) {
+    node->children[c] = child;
+    node->node.children_count++;
+}
+
+static void art_add_child48(art_node48_t *node, art_node_t **ref,
+                            unsigned char c, art_node_t *child) {
+    if (node->node.children_count < 48) {
+        int position = 0;
+        while (node->children[position] != NULL) position++;
+        node->children[position] = child;
+        node->index[c] = (unsigned char)(position + 1);
+        node->node.children_count++;
+        return;
+    }
+
+    art_node256_t *grown = (art_node256_t *)art_alloc_node(ART_NODE256);
+    for (int i = 0; i < 256; i++) {
+        if (node->index[i] != 0) {
+            grown->children[i] = node->children[node->index[i] - 1];
+        }
+    }
+    art_copy_header(&grown->node, &node->node);
+    *ref = &grown->node;
+    free(node);
+    art_add_child256(grown, c, child);
+}
+
+static void art_add_child16(art_node16_t *node, art_node_t **ref,
+                            unsigned char c, art_node_t *child) {
+    int count = node->node.children_count;
+
+    if (count < 16) {
+        int position = 0;
+        while (position < count && node->keys[position] < c) position++;
+        memmove(node->keys + position + 1, node->keys + position,
+                count - position);
+        memmove(node->children + position + 1, node->children + position,
+                (count - position) * sizeof(art_node_t *));
+        node->keys[position] = c;
+        node->children[position] = child;
+        node->node.children_count++;
+        return;
+    }
+
+    art_node48_t *grown = (art_node48_t *)art_alloc_node(ART_NODE48);
+    for (int i = 0; i < count; i++) {
+        grown->children[i] = node->children[i];
+        grown->index[node->keys[i]] = (unsigned char)(i + 1);
+    }
+    art_copy_header(&grown->node, &node->node);
+    *ref = &grown->node;
+    free(node);
+    art_add_child48(grown, ref, c, child);
+}
+
+static void art_add_child4(art_node4_t *node, art_node_t **ref,
+                           unsigned char c, art_node_t *child) {
+    int count = node->node.children_count;
+
+    if (count < 4) {
+        int position = 0;
+        while (position < count && node->keys[position] < c) position++;
+        memmove(node->keys + position + 1, node->keys + position,
+                count - position);
+        memmove(node->children + position + 1, node->children + position,
+                (count - position) * sizeof(art_node_t *));
+        node->keys[position] = c;
+        node->children[position] = child;
+        node->node.children_count++;
+        return;
+    }
+
+    art_node16_t *grown = (art_node16_t *)art_alloc_node(ART_NODE16);
+    memcpy(grown->keys, node->keys, count);
+    memcpy(grown->children, node->children, count * sizeof(art_node_t *));
+    art_copy_header(&grown->node, &node->node);
+    *ref = &grown->node;
+    free(node);
+    art_add_child16(grown, ref, c, child);
+}
+
+static void art_add_child(art_node_t *node, art_node_t **ref, unsigned char c,
+                          art_node_t *child) {
+    switch (node->type) {
+    case ART_NODE4:
+        art_add_child4((art_node4_t *)node, ref, c, child);
+        break;
+    case ART_NODE16:
+        art_add_child16((art_node16_t *)node, ref, c, child);
+        break;
+    case ART_NODE48:
+        art_add_child48((art_node48_t *)node, ref, c, child);
+        break;
+    default:
+        art_add_child256((art_node256_t *)node, c, child);
+        break;
+    }
+}
+
+static bool art_insert_at(art_node_t **ref, char *key, size_t length,
+                          float value, size_t depth) {
+    art_node_t *node = *ref;
+
+    if (node == NULL) {
+        *ref = ART_TAG_LEAF(art_make_leaf(key, length, value));
+        return true;
+    }
+
+    if (ART_IS_LEAF(node)) {
+        art_leaf_t *leaf = ART_LEAF(node);
+        if (art_leaf_matches(leaf, key, length)) {
+            leaf->value = value;
+            return false;
+        }
+
+        // Dva rôzne kľúče: nový 4-uzol so spoločnou časťou ako prefixom
+        size_t common = 0;
+        while (leaf->key[depth + common] == key[depth + common]) common++;
+
+        art_node4_t *split = (art_node4_t *)art_alloc_node(ART_NODE4);
+        split->node.prefix_length = (uint32_t)common;
+        memcpy(split->node.prefix, key + depth, ART_MIN(common, ART_MAX_PREFIX));
+        art_add_child4(split, ref, (unsigned char)leaf->key[depth + common],
+                       node);
+        art_add_child4(split, ref, (unsigned char)key[depth + common],
+                       ART_TAG_LEAF(art_make_leaf(key, length, value)));
+        *ref = &split->node;
+        return true;
+    }
+
+    if (node->prefix_length > 0) {
+        size_t mismatch = art_prefix_mismatch(node, key, length, depth);
+
+        if (mismatch < node->prefix_length) {
+            // Kľúč sa odkláňa v prefixe: prefix sa rozdelí novým 4-uzlom
+            art_node4_t *split = (art_node4_t *)art_alloc_node(ART_NODE4);
+            split->node.prefix_length = (uint32_t)mismatch;
+            memcpy(split->node.prefix, node->prefix,
+                   ART_MIN(mismatch, ART_MAX_PREFIX));
+
+            if (node->prefix_length <= ART_MAX_PREFIX) {
+                art_add_child4(split, ref, node->prefix[mismatch], node);
+                node->prefix_length -= (uint32_t)mismatch + 1;
+                memmove(node->prefix, node->prefix + mismatch + 1,
+                        ART_MIN(node->prefix_length, ART_MAX_PREFIX));
+            } else {
+                art_leaf_t *leaf = art_minimum(node);
+                node->prefix_length -= (uint32_t)mismatch + 1;
+                art_add_child4(split, ref,
+                               (unsigned char)leaf->key[depth + mismatch],
+                               node);
+                memcpy(node->prefix, leaf->key + depth + mismatch + 1,
+                       ART_MIN(node->prefix_length, ART_MAX_PREFIX));
+            }
+
+            art_add_child4(split, ref, (unsigned char)key[depth + mismatch],
+                           ART_TAG_LEAF(art_make_leaf(key, length, value)));
+            *ref = &split->node;
+            return true;
+        }
+        depth += node->prefix_length;
+    }
+
+    art_node_t **child = art_find_child(node, (unsigned char)key[depth]);
+    if (child != NULL) {
+        return art_insert_at(child, key, length, value, depth + 1);
+    }
+
+    art_add_child(node, ref, (unsigned char)key[depth],
+                  ART_TAG_LEAF(art_make_leaf(key, length, value)));
+    return true;
+}
+
+static void art_remove_child256(art_node256_t *node, art_node_t **ref,
+                                unsigned char c) {
+    node->children[c] = NULL;
+    node->node.children_count--;
+
+    // Zmenšenie s rezervou, aby striedavé vkladanie a mazanie nemenilo uzol
+    if (node->node.children_count == 37) {
+        art_node48_t *shrunk = (art_node48_t *)art_alloc_node(ART_NODE48);
+        int position = 0;
+        for (int i = 0; i < 256; i++) {
+            if (node->children[i] != NULL) {
+                shrunk->children[position] = node->children[i];
+                shrunk->index[i] = (unsigned char)(position + 1);
+                position++;
+            }
+        }
+        art_copy_header(&shrunk->node, &node->node);
+        *ref = &shrunk->node;
+        free(node);
+    }
+}
+
+static void art_remove_child48(art_node48_t *node, art_node_t **ref,
+                               unsigned char c) {
+    node->children[node->index[c] - 1] = NULL;
+    node->index[c] = 0;
+    node->node.children_count--;
+
+    if (node->node.children_count == 12) {
+        art_node16_t *shrunk = (art_node16_t *)art_alloc_node(ART_NODE16);
+        int position = 0;
+        for (int i = 0; i < 256; i++) {
+            if (node->index[i] != 0) {
+                shrunk->keys[position] = (unsigned char)i;
+                shrunk->children[position] = node->children[node->index[i] - 1];
+                position++;
+            }
+        }
+        art_copy_header(&shrunk->node, &node->node);
+        *ref = &shrunk->node;
+        free(node);
+    }
+}
+
+static void art_remove_child16(art_node16_t *node, art_node_t **ref,
+                               art_node_t **slot) {
+    int position = (int)(slot - node->children);
+    int count = node->node.children_count;
+
+    memmove(node->keys + position, node->keys + position + 1,
+            count - position - 1);
+    memmove(node->children + position, node->children + position + 1,
+            (count - position - 1) * sizeof(art_node_t *));
+    node->node.children_count--;
+
+    if (node->node.children_count == 3) {
+        art_node4_t *shrunk = (art_node4_t *)art_alloc_node(ART_NODE4);
+        art_copy_header(&shrunk->node, &node->node);
+        memcpy(shrunk->keys, node->keys, 3);
+        memcpy(shrunk->children, node->children, 3 * sizeof(art_node_t *));
+        *ref = &shrunk->node;
+        free(node);
+    }
+}
+
+static void art_remove_child4(art_node4_t *node, art_node_t **ref,
+                              art_node_t **slot) {
+    int position = (int)(slot - node->children);
+    int count = node->node.children_count;
+
+    memmove(node->keys + position, node->keys + position + 1,
+            count - position - 1);
+    memmove(node->children + position, node->children + position + 1,
+            (count - position - 1) * sizeof(art_node_t *));
+    node->node.children_count--;
+
+    if (node->node.children_count == 1) {
+        // Uzol s jediným potomkom sa zlúči s potomkom
+        art_node_t *child = node->children[0];
+        if (!ART_IS_LEAF(child)) {
+            size_t prefix = node->node.prefix_length;
+            if (prefix < ART_MAX_PREFIX) {
+                node->node.prefix[prefix++] = node->keys[0];
+            }
+            if (prefix < ART_MAX_PREFIX) {
+                size_t part = ART_MIN(child->prefix_length,
+                                      ART_MAX_PREFIX - prefix);
+                memcpy(node->node.prefix + prefix, child->prefix, part);
+                prefix += part;
+            }
+            memcpy(child->prefix, node->node.prefix,
+                   ART_MIN(prefix, ART_MAX_PREFIX));
+            child->prefix_length += node->node.prefix_length + 1;
+        }
+        *ref = child;
+        free(node);
+    }
+}
+
+static void art_remove_child(art_node_t *node, art_node_t **ref,
+                             unsigned char c, art_node_t **slot) {
+    switch (node->type) {
+    case ART_NODE4:
+        art_remove_child4((art_node4_t *)node, ref, slot);
+        break;
+    case ART_NODE16:
+        art_remove_child16((art_node16_t *)node, ref, slot);
+        break;
+    case ART_NODE48:
+        art_remove_child48((art_node48_t *)node, ref, c);
+        break;
+    default:
+        art_remove_child256((art_node256_t *)node, ref, c);
+        break;
+    }
+}
+
+static art_leaf_t *art_delete_at(art_node_t **ref, const char *key,
+                                 size_t length, size_t depth) {
+    art_node_t *node = *ref;
+    if (node == NULL) return NULL;
+
+    if (ART_IS_LEAF(node)) {
+        art_leaf_t *leaf = ART_LEAF(node);
+        if (!art_leaf_matches(leaf, key, length)) return NULL;
+        *ref = NULL;
+        return leaf;
+    }
+
+    if (node->prefix_length > 0) {
+        if (art_check_prefix(node, key, length, depth) !=
+            ART_MIN(node->prefix_length, ART_MAX_PREFIX)) {
+            return NULL;
+        }
+        depth += node->prefix_length;
+    }
+    if (depth >= length) return NULL;
+
+    unsigned char c = (unsigned char)key[depth];
+    art_node_t **child = art_find_child(node, c);
+    if (child == NULL) return NULL;
+
+    if (ART_IS_LEAF(*child)) {
+        art_leaf_t *leaf = ART_LEAF(*child);
+        if (!art_leaf_matches(leaf, key, length)) return NULL;
+        art_remove_child(node, ref, c, child);
+        return leaf;
+    }
+    return art_delete_at(child, key, length, depth + 1);
+}
+
+static void art_free_node(art_node_t *node) {
+    if (node == NULL) return;
+    if (ART_IS_LEAF(node)) {
+        free(ART_LEAF(node));
+        return;
+    }
+
+    switch (node->type) {
+    case ART_NODE4: {
+        art_node4_t *n = (art_node4_t *)node;
+        for (int i = 0; i < node->children_count; i++) {
+            art_free_node(n->children[i]);
+        }
+        break;
+    }
+    case ART_NODE16: {
+        art_node16_t *n = (art_node16_t *)node;
+        for (int i = 0; i < node->children_count; i++) {
+            art_free_node(n->children[i]);
+        }
+        break;
+    }
+    case ART_NODE48: {
+        art_node48_t *n = (art_node48_t *)node;
+        for (int i = 0; i < 48; i++) {
+            art_free_node(n->children[i]);
+        }
+        break;
+    }
+    default: {
+        art_node256_t *n = (art_node256_t *)node;
+        for (int i = 0; i < 256; i++) {
+            art_free_node(n->children[i]);
+        }
+        break;
+    }
+    }
+    free(node);
+}
+
+static int art_iterate_node(art_node_t *node, art_callback_t callback,
+                            void *context) {
+    if (node == NULL) return 0;
+    if (ART_IS_LEAF(node)) return callback(ART_LEAF(node), context);
+
+    int result = 0;
+    switch (node->type) {
+    case ART_NODE4: {
+        art_node4_t *n = (art_node4_t *)node;
+        for (int i = 0; result == 0 && i < node->children_count; i++) {
+            result = art_iterate_node(n->children[i], callback, context);
+        }
+        break;
+    }
+    case ART_NODE16: {
+        art_node16_t *n = (art_node16_t *)node;
+        for (int i = 0; result == 0 && i < node->children_count; i++) {
+            result = art_iterate_node(n->children[i], callback, context);
+        }
+        break;
+    }
+    case ART_NODE48: {
+        art_node48_t *n = (art_node48_t *)node;
+        for (int c = 0; result == 0 && c < 256; c++) {
+            if (n->index[c] != 0) {
+                result = art_iterate_node(n->children[n->index[c] - 1],
+                                          callback, context);
+            }
+        }
+        break;
+    }
+    default: {
+        art_node256_t *n = (art_node256_t *)node;
+        for (int c = 0; result == 0 && c < 256; c++) {
+            result = art_iterate_node(n->children[c], callback, context);
+        }
+        break;
+    }
+    }
+    return result;
+}
+
+static void art_count_node(art_node_t *node, size_t counts[ART_NODE_TYPES]) {
+    if (node == NULL || ART_IS_LEAF(node)) return;
+    counts[node->type]++;
+
+    switch (node->type) {
+    case ART_NODE4:
+        for (int i = 0; i < node->children_count; i++) {
+            art_count_node(((art_node4_t *)node)->children[i], counts);
+        }
+        break;
+    case ART_NODE16:
+        for (int i = 0; i < node->children_count; i++) {
+            art_count_node(((art_node16_t *)node)->children[i], counts);
+        }
+        break;
+    case ART_NODE48:
+        for (int i = 0; i < 48; i++) {
+            art_count_node(((art_node48_t *)node)->children[i], counts);
+        }
+        break;
+    default:
+        for (int i = 0; i < 256; i++) {
+            art_count_node(((art_node256_t *)node)->children[i], counts);
+        }
+        break;
+    }
+}
+
+/*
+ * Inicializácia stromu — zavolá sa pred prvým použitím stromu.
+ */
+void art_init(art_tree_t *tree) {
+    tree->root = NULL;
+    tree->size = 0;
+}
+
+/*
+ * Vyhľadanie listu v strome.
+ *
+ * V prípade úspechu vráti ukazovateľ na nájdený list; v opačnom prípade
+ * vráti hodnotu NULL.
+ */
+art_leaf_t *art_search(art_tree_t *tree, char *key) {
+    size_t length = strlen(key) + 1;
+    art_node_t *node = tree->root;
+    size_t depth = 0;
+
+    while (node != NULL) {
+        if (ART_IS_LEAF(node)) {
+            art_leaf_t *leaf = ART_LEAF(node);
+            return art_leaf_matches(leaf, key, length) ? leaf : NULL;
+        }
+
+        if (node->prefix_length > 0) {
+            if (art_check_prefix(node, key, length, depth) !=
+                ART_MIN(node->prefix_length, ART_MAX_PREFIX)) {
+                return NULL;
+            }
+            depth += node->prefix_length;
+        }
+        if (depth >= length) return NULL;
+
+        art_node_t **child = art_find_child(node, (unsigned char)key[depth]);
+        node = child != NULL ? *child : NULL;
+        depth++;
+    }
+    return NULL;
+}
+
+/*
+ * Vloženie nového kľúča do stromu.
+ *
+ * Pokiaľ kľúč už v strome existuje, nahradí sa jeho hodnota.
+ */
+void art_insert(art_tree_t *tree, char *key, float value) {
+    if (art_insert_at(&tree->root, key, strlen(key) + 1, value, 0)) {
+        tree->size++;
+    }
+}
+
+/*
+ * Získanie hodnoty zo stromu.
+ *
+ * V prípade úspechu vráti funkcia ukazovateľ na hodnotu listu, v opačnom
+ * prípade hodnotu NULL.
+ */
+float *art_get(art_tree_t *tree, char *key) {
+    art_leaf_t *leaf = art_search(tree, key);
+
+    return leaf == NULL ? NULL : &leaf->value;
+}
+
+/*
+ * Zmazanie kľúča zo stromu. Pokiaľ kľúč neexistuje, funkcia nerobí nič.
+ */
+void art_delete(art_tree_t *tree, char *key) {
+    art_leaf_t *leaf = art_delete_at(&tree->root, key, strlen(key) + 1, 0);
+    if (leaf != NULL) {
+        free(leaf);
+        tree->size--;
+    }
+}
+
+/*
+ * Zmazanie všetkých kľúčov a uvedenie stromu do stavu po inicializácii.
+ */
+void art_delete_all(art_tree_t *tree) {
+    art_free_node(tree->root);
+    art_init(tree);
+}
+
+/*
+ * Prechod všetkými listami vo vzostupnom poradí kľúčov.
+ *
+ * Funkcia vráti prvú nenulovú hodnotu funkcie callback (prechod sa ňou
+ * ukončí) alebo 0.
+ */
+int art_iterate(art_tree_t *tree, art_callback_t callback, void *context) {
+    return art_iterate_node(tree->root, callback, context);
+}
+
+/*
+ * Prechod listami, ktorých kľúč začína reťazcom prefix, vo vzostupnom
+ * poradí kľúčov.
+ *
+ * Funkcia zostúpi k uzlu, pod ktorým ležia práve kľúče s daným prefixom,
+ * a prejde iba jeho podstrom. Návratová hodnota je rovnaká ako pri
+ * art_iterate.
+ */
+int art_iterate_prefix(art_tree_t *tree, const char *prefix,
+                       art_callback_t callback, void *context) {
+    size_t length = strlen(prefix);
+    art_node_t *node = tree->root;
+    size_t depth = 0;
+
+    while (node != NULL) {
+        if (ART_IS_LEAF(node)) {
+            art_leaf_t *leaf = ART_LEAF(node);
+            if (leaf->key_length > length &&
+                memcmp(leaf->key, prefix, length) == 0) {
+                return callback(leaf, context);
+            }
+            return 0;
+        }
+
+        if (depth == length) {
+            return art_iterate_node(node, callback, context);
+        }
+
+        if (node->prefix_length > 0) {
+            size_t matched = art_prefix_mismatch(node, prefix, length, depth);
+            if (depth + matched == length) {
+                return art_iterate_node(node, callback, context);
+            }
+            if (matched < node->prefix_length) return 0;
+            depth += node->prefix_length;
+        }
+
+        art_node_t **child =
+            art_find_child(node, (unsigned char)prefix[depth]);
+        node = child != NULL ? *child : NULL;
+        depth++;
+    }
+    return 0;
+}
+
+/*
+ * Počty vnútorných uzlov jednotlivých druhov.
+ */
+void art_node_counts(art_tree_t *tree, size_t counts[ART_NODE_TYPES]) {
+    for (int type = 0; type < ART_NODE_TYPES; type++) {
+        counts[type] = 0;
+    }
+    art_count_node(tree->root, counts);
+}
@@ -0,0 +1,66 @@
+/*
+ * Hlavičkový súbor pre adaptívny radix strom (ART) s reťazcovými kľúčmi.
+ *
+ * Strom indexuje kľúče po bajtoch. Vnútorné uzly majú podľa počtu potomkov
+ * jednu zo štyroch veľkostí (4, 16, 48 a 256 potomkov) a spoločnú časť
+ * kľúčov pod uzlom si pamätajú ako prefix, takže reťaze uzlov s jediným
+ * potomkom nevznikajú. Listy nesú kľúč a hodnotu.
+ *
+ * Rozhranie zodpovedá funkciám ht_* z tabuľky s rozptýlenými položkami:
+ * kľúče sú reťazce ukončené znakom '\0', strom ich nekopíruje ani
+ * neuvoľňuje a hodnoty sú typu float. Navyše strom umožňuje prechod kľúčmi
+ * vo vzostupnom poradí (podľa bajtov ako strcmp) a výber kľúčov s daným
+ * prefixom.
+ */
+
+#ifndef IAL_ART_H
+#define IAL_ART_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Počet bajtov prefixu uložených priamo v uzle, dlhší prefix sa dočíta z listu
+#define ART_MAX_PREFIX 10
+
+// Druhy vnútorných uzlov
+typedef enum art_node_type {
+  ART_NODE4,
+  ART_NODE16,
+  ART_NODE48,
+  ART_NODE256,
+  ART_NODE_TYPES
+} art_node_type_t;
+
+// List stromu
+typedef struct art_leaf {
+  char *key;           // kľúč listu
+  float value;         // hodnota listu
+  uint32_t key_length; // dĺžka kľúča vrátane ukončovacieho znaku '\0'
+} art_leaf_t;
+
+// Vnútorný uzol (jednotlivé druhy sú definované v art.c)
+typedef struct art_node art_node_t;
+
+// Strom
+typedef struct art_tree {
+  art_node_t *root; // koreň (uzol alebo označený list)
+  size_t size;      // počet kľúčov
+} art_tree_t;
+
+// Funkcia volaná pre listy pri prechode, nenulová hodnota prechod ukončí
+typedef int (*art_callback_t)(art_leaf_t *leaf, void *context);
+
+void art_init(art_tree_t *tree);
+art_leaf_t *art_search(art_tree_t *tree, char *key);
+void art_insert(art_tree_t *tree, char *key, float value);
+float *art_get(art_tree_t *tree, char *key);
+void art_delete(art_tree_t *tree, char *key);
+void art_delete_all(art_tree_t *tree);
+
+int art_iterate(art_tree_t *tree, art_callback_t callback, void *context);
+int art_iterate_prefix(art_tree_t *tree, const char *prefix,
+                       art_callback_t callback, void *context);
+void art_node_counts(art_tree_t *tree, size_t counts[ART_NODE_TYPES]);
+
+#endif
@@ -0,0 +1,227 @@
+/*
+ * Výkonnostné testy adaptívneho radix stromu oproti tabuľke s rozptýlenými
+ * položkami.
+ *
+ * Spustenie: ./bench [názov testu]
+ * Bez argumentu sa spustia všetky testy.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "art.h"
+#include "../hashtable/hashtable.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+static double bench_now(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+static unsigned long bench_seed = 42;
+
+static unsigned long bench_random(void) {
+    bench_seed = bench_seed * 6364136223846793005ul + 1442695040888963407ul;
+    return bench_seed >> 33;
+}
+
+/*
+ * Náhodný kľúč z tlačiteľných znakov s dĺžkou z intervalu <min,max>.
+ */
+static char *bench_key(size_t min, size_t max) {
+    size_t length = min + bench_random() % (max - min + 1);
+    char *key = malloc(length + 1);
+    for (size_t i = 0; i < length; i++) {
+        key[i] = (char)(' ' + 1 + bench_random() % 94);
+    }
+    key[length] = '\0';
+    return key;
+}
+
+/*
+ * Kľúč so spoločným prefixom a poradovým číslom, napr. "user/000042/name".
+ */
+static char *bench_path_key(int number) {
+    static const char *fields[] = {"name", "email", "created", "settings"};
+    char *key = malloc(32);
+    snprintf(key, 32, "user/%06d/%s", number / 4, fields[number % 4]);
+    return key;
+}
+
+static void bench_free_keys(char **keys, int count) {
+    for (int i = 0; i < count; i++) {
+        free(keys[i]);
+    }
+    free(keys);
+}
+
+/*
+ * Vyhľadanie existujúcich aj chýbajúcich kľúčov pomocou art_get a ht_get.
+ */
+static void bench_get_keys(const char *name, char **keys, char **missing,
+                           int count) {
+    const int lookups = 500000;
+    ht_table_t *table = malloc(sizeof(ht_table_t));
+    art_tree_t tree;
+    HT_SIZE = MAX_HT_SIZE;
+
+    ht_init(table);
+    art_init(&tree);
+    for (int i = 0; i < count; i++) {
+        ht_insert(table, keys[i], (float)i);
+        art_insert(&tree, keys[i], (float)i);
+    }
+
+    char **order = malloc(lookups * sizeof(char *));
+    for (int i = 0; i < lookups; i++) {
+        int k = (int)(bench_random() % count);
+        order[i] = bench_random() % 4 == 0 ? missing[k] : keys[k];
+    }
+
+    volatile long sink = 0;
+    double start = bench_now();
+    for (int i = 0; i < lookups; i++) {
+        sink += ht_get(table, order[i]) != NULL;
+    }
+    double hashed = bench_now() - start;
+
+    start = bench_now();
+    for (int i = 0; i < lookups; i++) {
+        sink += art_get(&tree, order[i]) != NULL;
+    }
+    double radix = bench_now() - start;
+    (void)sink;
+
+    size_t nodes[ART_NODE_TYPES];
+    art_node_counts(&tree, nodes);
+    printf("%-8s %8d %14.0f %14.0f %10.2f   nodes 4/16/48/256: "
+           "%zu/%zu/%zu/%zu\n",
+           name, count, lookups / hashed, lookups / radix, hashed / radix,
+           nodes[ART_NODE4], nodes[ART_NODE16], nodes[ART_NODE48],
+           nodes[ART_NODE256]);
+
+    free(order);
+    art_delete_all(&tree);
+    ht_delete_all(table);
+    free(table);
+}
+
+/*
+ * Vyhľadávanie pri náhodných kľúčoch a pri kľúčoch so spoločnými prefixmi;
+ * štvrtina hľadaných kľúčov v štruktúrach nie je.
+ */
+static void bench_get(void) {
+    const int counts[] = {1000, 100000};
+
+    printf("%-8s %8s %14s %14s %10s\n", "keys", "count", "ht_get/s",
+           "art_get/s", "speedup");
+    for (size_t c = 0; c < sizeof(counts) / sizeof(counts[0]); c++) {
+        int count = counts[c];
+        char **keys = malloc(count * sizeof(char *));
+        char **missing = malloc(count * sizeof(char *));
+
+        for (int i = 0; i < count; i++) {
+            keys[i] = bench_key(8, 24);
+            missing[i] = bench_key(8, 24);
+        }
+        bench_get_keys("random", keys, missing, count);
+        bench_free_keys(keys, count);
+        bench_free_keys(missing, count);
+
+        keys = malloc(count * sizeof(char *));
+        missing = malloc(count * sizeof(char *));
+        for (int i = 0; i < count; i++) {
+            keys[i] = bench_path_key(i);
+            missing[i] = bench_path_key(count + i);
+        }
+        bench_get_keys("path", keys, missing, count);
+        bench_free_keys(keys, count);
+        bench_free_keys(missing, count);
+    }
+    printf("\n");
+}
+
+static int bench_count_leaf(art_leaf_t *leaf, void *context) {
+    (*(long *)context)++;
+    return 0;
+}
+
+/*
+ * Výber kľúčov s prefixom: art_iterate_prefix oproti prechodu všetkými
+ * položkami tabuľky s porovnaním prefixu.
+ */
+static void bench_prefix(void) {
+    const int count = 100000;
+    const int rounds = 2000;
+    ht_table_t *table = malloc(sizeof(ht_table_t));
+    char **keys = malloc(count * sizeof(char *));
+    art_tree_t tree;
+    HT_SIZE = MAX_HT_SIZE;
+
+    ht_init(table);
+    art_init(&tree);
+    for (int i = 0; i < count; i++) {
+        keys[i] = bench_path_key(i);
+        ht_insert(table, keys[i], (float)i);
+        art_insert(&tree, keys[i], (float)i);
+    }
+
+    char prefix[32];
+    long found_table = 0, found_tree = 0;
+    double start = bench_now();
+    for (int r = 0; r < rounds; r++) {
+        snprintf(prefix, sizeof(prefix), "user/%05d",
+                 (int)(bench_random() % (count / 40)));
+        size_t length = strlen(prefix);
+        for (int i = 0; i < HT_SIZE; i++) {
+            for (ht_item_t *item = (*table)[i]; item != NULL;
+                 item = item->next) {
+                found_table += strncmp(item->key, prefix, length) == 0;
+            }
+        }
+    }
+    double scanned = bench_now() - start;
+
+    bench_seed = 42;
+    start = bench_now();
+    for (int r = 0; r < rounds; r++) {
+        snprintf(prefix, sizeof(prefix), "user/%05d",
+                 (int)(bench_random() % (count / 40)));
+        art_iterate_prefix(&tree, prefix, bench_count_leaf, &found_tree);
+    }
+    double radix = bench_now() - start;
+
+    printf("%-10s %14s %10s %10s\n", "method", "queries/s", "keys",
+           "speedup");
+    printf("%-10s %14.0f %10ld %10.2f\n", "ht scan", rounds / scanned,
+           found_table, 1.0);
+    printf("%-10s %14.0f %10ld %10.2f\n", "art", rounds / radix, found_tree,
+           scanned / radix);
+    printf("\n");
+
+    art_delete_all(&tree);
+    ht_delete_all(table);
+    bench_free_keys(keys, count);
+    free(table);
+}
+
+typedef struct {
+    const char *name;
+    void (*run)(void);
+} bench_t;
+
+static const bench_t BENCHMARKS[] = {
+    {"get", bench_get},
+    {"prefix", bench_prefix},
+};
+
+int main(int argc, char *argv[]) {
+    for (size_t i = 0; i < sizeof(BENCHMARKS) / sizeof(BENCHMARKS[0]); i++) {
+        if (argc > 1 && strcmp(argv[1], BENCHMARKS[i].name) != 0) continue;
+        printf("[%s]\n", BENCHMARKS[i].name);
+        BENCHMARKS[i].run();
+    }
+}
@@ -0,0 +1,136 @@
+#include "art.h"
+#include "test_util.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#define INSERT_TEST_DATA(TREE)                                                 \
+  for (int i = 0; i < sizeof(TEST_DATA) / sizeof(TEST_DATA[0]); i++) {         \
+    art_insert(TREE, TEST_DATA[i].key, TEST_DATA[i].value);                    \
+  }
+
+const art_leaf_t TEST_DATA[15] = {
+    {"Bitcoin", 53247.71}, {"Ethereum", 3208.67}, {"Binance Coin", 409.15},
+    {"Cardano", 1.82},     {"Tether", 0.86},      {"XRP", 0.93},
+    {"Solana", 134.50},    {"Polkadot", 34.99},   {"Dogecoin", 0.22},
+    {"USD Coin", 0.86},    {"Uniswap", 21.68},    {"Terra", 30.67},
+    {"Litecoin", 156.87},  {"Avalanche", 47.03},  {"Chainlink", 21.90}};
+
+// Kľúče "k!" až "kz" pre rast a zmenšovanie uzlu pod prefixom "k"
+#define GROWTH_COUNT 90
+char GROWTH_KEYS[GROWTH_COUNT][3];
+
+void init_test() {
+  printf("Adaptive Radix Tree - testing script\n");
+  printf("------------------------------------\n");
+  for (int i = 0; i < GROWTH_COUNT; i++) {
+    snprintf(GROWTH_KEYS[i], sizeof(GROWTH_KEYS[i]), "k%c", '!' + i);
+  }
+  printf("\n");
+}
+
+TEST(test_tree_init, "Initialize the tree")
+ENDTEST
+
+TEST(test_search_nonexist, "Search for a non-existing item")
+art_print_leaf(art_search(&test_tree, "Ethereum"));
+ENDTEST
+
+TEST(test_insert_simple, "Insert a new item")
+art_insert(&test_tree, "Ethereum", 3208.67);
+ENDTEST
+
+TEST(test_search_exist, "Search for an existing item")
+art_insert(&test_tree, "Ethereum", 3208.67);
+art_print_leaf(art_search(&test_tree, "Ethereum"));
+ENDTEST
+
+TEST(test_insert_many, "Insert many new items")
+INSERT_TEST_DATA(&test_tree)
+ENDTEST
+
+TEST(test_search_prefix_key, "Search for keys sharing a prefix")
+art_insert(&test_tree, "Bit", 1);
+art_insert(&test_tree, "Bitcoin", 2);
+art_insert(&test_tree, "Bitcoin Cash", 3);
+art_print_leaf(art_search(&test_tree, "Bit"));
+art_print_leaf(art_search(&test_tree, "Bitcoin"));
+art_print_leaf(art_search(&test_tree, "Bitcoin Cash"));
+art_print_leaf(art_search(&test_tree, "Bitco"));
+art_print_leaf(art_search(&test_tree, "Bitcoin Gold"));
+ENDTEST
+
+TEST(test_insert_update, "Update an item")
+INSERT_TEST_DATA(&test_tree)
+art_insert(&test_tree, "Ethereum", 12.34);
+ENDTEST
+
+TEST(test_get, "Get an item's value")
+INSERT_TEST_DATA(&test_tree)
+art_print_item_value(art_get(&test_tree, "Ethereum"));
+art_print_item_value(art_get(&test_tree, "Monero"));
+ENDTEST
+
+TEST(test_delete, "Delete an item")
+INSERT_TEST_DATA(&test_tree)
+art_delete(&test_tree, "Terra");
+art_delete(&test_tree, "Tether");
+art_delete(&test_tree, "Monero");
+art_print_leaf(art_search(&test_tree, "Terra"));
+ENDTEST
+
+TEST(test_delete_all, "Delete all the items")
+INSERT_TEST_DATA(&test_tree)
+art_delete_all(&test_tree);
+ENDTEST
+
+TEST(test_prefix_scan, "Iterate keys with a given prefix")
+INSERT_TEST_DATA(&test_tree)
+art_insert(&test_tree, "Bitcoin Cash", 512.30);
+art_insert(&test_tree, "Bitcoin SV", 180.43);
+art_print_prefix(&test_tree, "Bit");
+art_print_prefix(&test_tree, "Bitcoin");
+art_print_prefix(&test_tree, "Bitcoin ");
+art_print_prefix(&test_tree, "T");
+art_print_prefix(&test_tree, "U");
+art_print_prefix(&test_tree, "Z");
+art_print_prefix(&test_tree, "");
+ENDTEST
+
+TEST(test_node_growth, "Grow and shrink inner nodes")
+const int grow_at[] = {4, 5, 16, 17, 48, 49, GROWTH_COUNT};
+const int shrink_at[] = {38, 37, 13, 12, 4, 3, 1};
+int count = 0;
+for (int s = 0; s < sizeof(grow_at) / sizeof(grow_at[0]); s++) {
+  for (; count < grow_at[s]; count++) {
+    art_insert(&test_tree, GROWTH_KEYS[count], (float)count);
+  }
+  printf("%2zu keys: ", test_tree.size);
+  art_print_node_counts(&test_tree);
+}
+for (int s = 0; s < sizeof(shrink_at) / sizeof(shrink_at[0]); s++) {
+  for (; count > shrink_at[s]; count--) {
+    art_delete(&test_tree, GROWTH_KEYS[count - 1]);
+  }
+  printf("%2zu keys: ", test_tree.size);
+  art_print_node_counts(&test_tree);
+}
+art_print_item_value(art_get(&test_tree, "k!"));
+art_print_item_value(art_get(&test_tree, "k\""));
+ENDTEST
+
+int main(int argc, char *argv[]) {
+  init_test();
+
+  test_tree_init();
+  test_search_nonexist();
+  test_insert_simple();
+  test_search_exist();
+  test_insert_many();
+  test_search_prefix_key();
+  test_insert_update();
+  test_get();
+  test_delete();
+  test_delete_all();
+  test_prefix_scan();
+  test_node_growth();
+}
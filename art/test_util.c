@@ -0,0 +1,55 @@
+#include "test_util.h"
+#include "art.h"
+#include <stdio.h>
+
+void art_print_item_value(float *value) {
+  if (value != NULL) {
+    printf("%.2f\n", *value);
+  } else {
+    printf("NULL\n");
+  }
+}
+
+void art_print_leaf(art_leaf_t *leaf) {
+  if (leaf != NULL) {
+    printf("(%s,%.2f)\n", leaf->key, leaf->value);
+  } else {
+    printf("NULL\n");
+  }
+}
+
+static int art_print_callback(art_leaf_t *leaf, void *context) {
+  int *count = context;
+  printf("(%s,%.2f)", leaf->key, leaf->value);
+  (*count)++;
+  return 0;
+}
+
+void art_print_tree(art_tree_t *tree) {
+  int count = 0;
+
+  printf("--------------ART TREE--------------\n");
+  art_iterate(tree, art_print_callback, &count);
+  if (count > 0) {
+    printf("\n");
+  }
+  printf("------------------------------------\n");
+  printf("Total items in tree: %i\n", count);
+  printf("------------------------------------\n");
+}
+
+void art_print_prefix(art_tree_t *tree, const char *prefix) {
+  int count = 0;
+
+  printf("Prefix \"%s\": ", prefix);
+  art_iterate_prefix(tree, prefix, art_print_callback, &count);
+  printf(" [%i]\n", count);
+}
+
+void art_print_node_counts(art_tree_t *tree) {
+  size_t counts[ART_NODE_TYPES];
+
+  art_node_counts(tree, counts);
+  printf("Nodes: 4=%zu 16=%zu 48=%zu 256=%zu\n", counts[ART_NODE4],
+         counts[ART_NODE16], counts[ART_NODE48], counts[ART_NODE256]);
+}
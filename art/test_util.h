@@ -0,0 +1,25 @@
+#ifndef IAL_ART_TEST_UTIL_H
+#define IAL_ART_TEST_UTIL_H
+
+#include "art.h"
+
+#define TEST(NAME, DESCRIPTION)                                                \
+  void NAME() {                                                                \
+    printf("[%s] %s\n", #NAME, DESCRIPTION);                                   \
+    art_tree_t test_tree;                                                      \
+    art_init(&test_tree);
+
+#define ENDTEST                                                                \
+  printf("\n");                                                                \
+  art_print_tree(&test_tree);                                                  \
+  art_delete_all(&test_tree);                                                  \
+  printf("\n");                                                                \
+  }
+
+void art_print_item_value(float *value);
+void art_print_leaf(art_leaf_t *leaf);
+void art_print_tree(art_tree_t *tree);
+void art_print_prefix(art_tree_t *tree, const char *prefix);
+void art_print_node_counts(art_tree_t *tree);
+
+#endif
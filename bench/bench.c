@@ -0,0 +1,719 @@
+/*
+ * Porovnanie štruktúr na rovnakom prúde operácií.
+ *
+ * Spustenie: ./bench [-n operácie] [-k kľúče] [-m get/insert/delete]
+ *                    [-d uniform|zipf] [-l min-max] [-s semienko]
+ *                    [-t súbor] [-b štruktúry] [-o súbor.csv]
+ *
+ * Program vytvorí syntetický záznam operácií (pomer get/insert/delete,
+ * rozdelenie kľúčov a rozsah ich dĺžok) alebo načíta zaznamenaný záznam
+ * zo súboru (-t) a prehrá ho na každej štruktúre z tohto repozitára:
+ * tabuľke s rozptýlenými položkami (aj s HT_MOVE_TO_FRONT), adaptívnom
+ * radix strome, binárnom vyhľadávacom strome (variant TREE z Makefile),
+ * jeho splay hľadaní a perzistentných verziách.
+ *
+ * Zaznamenaný záznam má na každom riadku jednu operáciu:
+ *   get KĽÚČ | insert KĽÚČ HODNOTA | delete KĽÚČ
+ * Kľúč nesmie obsahovať medzery. Syntetický záznam pred meraním vloží každý
+ * druhý kľúč, zaznamenaný záznam sa prehrá od prázdnej štruktúry.
+ *
+ * Každá štruktúra beží vo vlastnom procese, aby sa jej špičková obsadená
+ * pamäť (RSS) nemiešala s ostatnými. Výsledky sa vypíšu ako CSV na
+ * štandardný výstup alebo sa pripoja do súboru (-o), takže ich možno
+ * porovnávať v čase. Latencia sa meria pre každú operáciu a zahŕňa aj
+ * čítanie hodín. Počet výpadkov cache sa zisťuje cez perf_event; ak nie je
+ * dostupný (iný systém, zakázaný prístup), stĺpec zostane prázdny, rovnako
+ * ako spotreba pamäte štruktúr, ktoré ju neevidujú. Stĺpec hits (počet
+ * úspešných get) musí byť pre všetky štruktúry rovnaký.
+ *
+ * Stromy majú kľúče typu char, zvládnu preto najviac 256 rôznych kľúčov;
+ * pri väčšom počte kľúčov sa vynechajú.
+ */
+
+#define _DEFAULT_SOURCE
+
+#include "../art/art.h"
+#include "../btree/btree.h"
+#include "../btree/memory.h"
+#include "../btree/persistent.h"
+#include "../btree/splay.h"
+#include "../hashtable/hashtable.h"
+#include "../hashtable/memory.h"
+#include "../hashtable/search.h"
+#include <limits.h>
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#endif
+
+#ifndef BENCH_TREE
+#define BENCH_TREE "iter"
+#endif
+
+#define BENCH_TREE_KEYS (UCHAR_MAX + 1)
+#define BENCH_UNKNOWN SIZE_MAX
+#define BENCH_LINE 256
+
+typedef enum bench_op_type {
+    BENCH_GET,
+    BENCH_INSERT,
+    BENCH_DELETE
+} bench_op_type_t;
+
+// Operácia záznamu, kľúč je index do poľa kľúčov
+typedef struct bench_op {
+    bench_op_type_t type;
+    int key;
+    float value;
+} bench_op_t;
+
+typedef struct bench_trace {
+    char name[BENCH_LINE];
+    char **keys;
+    int key_count;
+    bench_op_t *prefill; // nemerané operácie pred záznamom
+    size_t prefill_count;
+    bench_op_t *ops;
+    size_t count;
+} bench_trace_t;
+
+// Štruktúra, na ktorej sa záznam prehráva
+typedef struct bench_backend {
+    const char *name;
+    int max_keys; // najväčší počet rôznych kľúčov, 0 bez obmedzenia
+    void (*init)(void);
+    bool (*apply)(const bench_op_t *op, char *key, int index);
+    size_t (*memory)(void); // spotreba v bajtoch alebo BENCH_UNKNOWN
+} bench_backend_t;
+
+// Výsledok merania jednej štruktúry (posiela sa z procesu merania)
+typedef struct bench_result {
+    double seconds;
+    uint64_t p50, p99, p999; // latencie v ns
+    size_t memory;
+    long long cache_misses; // -1 ak nie je dostupné
+    long hits;              // počet úspešných get
+} bench_result_t;
+
+static unsigned long bench_seed = 42;
+
+static unsigned long bench_random(void) {
+    bench_seed = bench_seed * 6364136223846793005ul + 1442695040888963407ul;
+    return bench_seed >> 33;
+}
+
+static uint64_t bench_now_ns(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000u + (uint64_t)now.tv_nsec;
+}
+
+static void *bench_alloc(size_t size) {
+    void *pointer = malloc(size > 0 ? size : 1);
+    if (pointer == NULL) {
+        fprintf(stderr, "bench: out of memory\n");
+        exit(1);
+    }
+    return pointer;
+}
+
+/*
+ * Štruktúry. Každá beží v samostatnom procese, stav preto môže byť
+ * statický.
+ */
+
+static ht_table_t bench_table;
+static ht_memory_t bench_table_memory;
+
+static void bench_ht_init(void) {
+    HT_SIZE = MAX_HT_SIZE;
+    HT_MOVE_TO_FRONT = false;
+    ht_init(&bench_table);
+    ht_memory_attach(&bench_table, &bench_table_memory);
+}
+
+static void bench_ht_mtf_init(void) {
+    bench_ht_init();
+    HT_MOVE_TO_FRONT = true;
+}
+
+static bool bench_ht_apply(const bench_op_t *op, char *key, int index) {
+    switch (op->type) {
+    case BENCH_GET:
+        return ht_get(&bench_table, key) != NULL;
+    case BENCH_INSERT:
+        ht_insert(&bench_table, key, op->value);
+        return true;
+    case BENCH_DELETE:
+        ht_delete(&bench_table, key);
+        return true;
+    }
+    return false;
+}
+
+static size_t bench_ht_memory(void) {
+    ht_memory_t usage;
+    ht_memory_usage(&bench_table, &usage);
+    return usage.total;
+}
+
+static art_tree_t bench_art;
+
+static void bench_art_init(void) {
+    art_init(&bench_art);
+}
+
+static bool bench_art_apply(const bench_op_t *op, char *key, int index) {
+    switch (op->type) {
+    case BENCH_GET:
+        return art_get(&bench_art, key) != NULL;
+    case BENCH_INSERT:
+        art_insert(&bench_art, key, op->value);
+        return true;
+    case BENCH_DELETE:
+        art_delete(&bench_art, key);
+        return true;
+    }
+    return false;
+}
+
+static size_t bench_no_memory(void) {
+    return BENCH_UNKNOWN;
+}
+
+static bst_node_t *bench_tree;
+
+static void bench_bst_init(void) {
+    bst_init(&bench_tree);
+}
+
+static bool bench_bst_apply(const bench_op_t *op, char *key, int index) {
+    int value;
+    switch (op->type) {
+    case BENCH_GET:
+        return bst_search(bench_tree, (char)(CHAR_MIN + index), &value);
+    case BENCH_INSERT:
+        bst_insert(&bench_tree, (char)(CHAR_MIN + index), (int)op->value);
+        return true;
+    case BENCH_DELETE:
+        bst_delete(&bench_tree, (char)(CHAR_MIN + index));
+        return true;
+    }
+    return false;
+}
+
+static bool bench_splay_apply(const bench_op_t *op, char *key, int index) {
+    int value;
+    if (op->type == BENCH_GET) {
+        return bst_splay_search(&bench_tree, (char)(CHAR_MIN + index), &value);
+    }
+    return bench_bst_apply(op, key, index);
+}
+
+static size_t bench_bst_memory(void) {
+    bst_memory_t usage;
+    bst_memory_usage(&bench_tree, &usage);
+    return usage.total;
+}
+
+static bst_pnode_t *bench_version;
+
+static void bench_persistent_init(void) {
+    bench_version = NULL;
+}
+
+static bool bench_persistent_apply(const bench_op_t *op, char *key,
+                                   int index) {
+    int value;
+    bst_pnode_t *next;
+    switch (op->type) {
+    case BENCH_GET:
+        return bst_persistent_search(bench_version, (char)(CHAR_MIN + index),
+                                     &value);
+    case BENCH_INSERT:
+        next = bst_persistent_insert(bench_version, (char)(CHAR_MIN + index),
+                                     (int)op->value);
+        break;
+    case BENCH_DELETE:
+        next = bst_persistent_delete(bench_version, (char)(CHAR_MIN + index));
+        break;
+    default:
+        return false;
+    }
+    bst_persistent_release(bench_version);
+    bench_version = next;
+    return true;
+}
+
+static const bench_backend_t BACKENDS[] = {
+    {"ht", 0, bench_ht_init, bench_ht_apply, bench_ht_memory},
+    {"ht_mtf", 0, bench_ht_mtf_init, bench_ht_apply, bench_ht_memory},
+    {"art", 0, bench_art_init, bench_art_apply, bench_no_memory},
+    {"bst_" BENCH_TREE, BENCH_TREE_KEYS, bench_bst_init, bench_bst_apply,
+     bench_bst_memory},
+    {"splay", BENCH_TREE_KEYS, bench_bst_init, bench_splay_apply,
+     bench_bst_memory},
+    {"persistent", BENCH_TREE_KEYS, bench_persistent_init,
+     bench_persistent_apply, bench_no_memory},
+};
+
+/*
+ * Počítadlo výpadkov cache procesu, -1 ak perf_event nie je dostupný.
+ */
+static int bench_perf_open(void) {
+#ifdef __linux__
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(attr);
+    attr.config = PERF_COUNT_HW_CACHE_MISSES;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    return (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+#else
+    return -1;
+#endif
+}
+
+static void bench_perf_enable(int fd, bool enable) {
+#ifdef __linux__
+    if (fd < 0) return;
+    if (enable) ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+    ioctl(fd, enable ? PERF_EVENT_IOC_ENABLE : PERF_EVENT_IOC_DISABLE, 0);
+#endif
+}
+
+static long long bench_perf_read(int fd) {
+    long long count;
+    if (fd < 0 || read(fd, &count, sizeof(count)) != sizeof(count)) return -1;
+    close(fd);
+    return count;
+}
+
+static int bench_compare_latency(const void *a, const void *b) {
+    uint32_t x = *(const uint32_t *)a, y = *(const uint32_t *)b;
+    return (x > y) - (x < y);
+}
+
+static uint64_t bench_percentile(const uint32_t *sorted, size_t count,
+                                 double fraction) {
+    if (count == 0) return 0;
+    size_t rank = (size_t)ceil(fraction * count);
+    return sorted[rank > 0 ? rank - 1 : 0];
+}
+
+/*
+ * Prehranie záznamu na štruktúre backend (v procese merania).
+ */
+static bench_result_t bench_replay(const bench_backend_t *backend,
+                                   const bench_trace_t *trace) {
+    bench_result_t result = {0};
+    uint32_t *latencies = bench_alloc(trace->count * sizeof(uint32_t));
+
+    backend->init();
+    for (size_t i = 0; i < trace->prefill_count; i++) {
+        const bench_op_t *op = &trace->prefill[i];
+        backend->apply(op, trace->keys[op->key], op->key);
+    }
+
+    int perf = bench_perf_open();
+    bench_perf_enable(perf, true);
+    uint64_t start = bench_now_ns();
+    uint64_t previous = start;
+    for (size_t i = 0; i < trace->count; i++) {
+        const bench_op_t *op = &trace->ops[i];
+        bool found = backend->apply(op, trace->keys[op->key], op->key);
+        result.hits += op->type == BENCH_GET && found;
+        uint64_t now = bench_now_ns();
+        latencies[i] = (uint32_t)(now - previous < UINT32_MAX ? now - previous
+                                                              : UINT32_MAX);
+        previous = now;
+    }
+    result.seconds = (previous - start) / 1e9;
+    bench_perf_enable(perf, false);
+    result.cache_misses = bench_perf_read(perf);
+
+    result.memory = backend->memory();
+    qsort(latencies, trace->count, sizeof(uint32_t), bench_compare_latency);
+    result.p50 = bench_percentile(latencies, trace->count, 0.5);
+    result.p99 = bench_percentile(latencies, trace->count, 0.99);
+    result.p999 = bench_percentile(latencies, trace->count, 0.999);
+    free(latencies);
+    return result;
+}
+
+/*
+ * Meranie štruktúry v samostatnom procese. Do peak_rss zapíše špičkovú
+ * obsadenú pamäť procesu v kB.
+ */
+static bool bench_measure(const bench_backend_t *backend,
+                          const bench_trace_t *trace, bench_result_t *result,
+                          long *peak_rss) {
+    int channel[2];
+    if (pipe(channel) != 0) return false;
+    fflush(NULL);
+
+    pid_t child = fork();
+    if (child < 0) return false;
+    if (child == 0) {
+        close(channel[0]);
+        bench_result_t measured = bench_replay(backend, trace);
+        bool sent = write(channel[1], &measured, sizeof(measured)) ==
+                    sizeof(measured);
+        _exit(sent ? 0 : 1);
+    }
+
+    close(channel[1]);
+    bool received = read(channel[0], result, sizeof(*result)) == sizeof(*result);
+    close(channel[0]);
+
+    int status;
+    struct rusage usage;
+    if (wait4(child, &status, 0, &usage) != child || !WIFEXITED(status) ||
+        WEXITSTATUS(status) != 0) {
+        return false;
+    }
+    *peak_rss = usage.ru_maxrss;
+    return received;
+}
+
+/*
+ * Syntetické kľúče: náhodné tlačiteľné znaky s dĺžkou z <min,max>, kľúče sa
+ * líšia aspoň v poradovom čísle na konci.
+ */
+static char **bench_keys(int count, int min, int max) {
+    char **keys = bench_alloc(count * sizeof(char *));
+    for (int i = 0; i < count; i++) {
+        char suffix[16];
+        int suffix_length = snprintf(suffix, sizeof(suffix), "#%d", i);
+        int length = min + (int)(bench_random() % (max - min + 1));
+        int random = length > suffix_length ? length - suffix_length : 0;
+        keys[i] = bench_alloc(random + suffix_length + 1);
+        for (int j = 0; j < random; j++) {
+            keys[i][j] = (char)('!' + 1 + bench_random() % 93);
+        }
+        memcpy(keys[i] + random, suffix, suffix_length + 1);
+    }
+    return keys;
+}
+
+/*
+ * Syntetický záznam s count operáciami nad key_count kľúčmi. Pri zipf sa
+ * kľúč s poradím r v náhodnej permutácii vyberá s pravdepodobnosťou
+ * úmernou 1/r.
+ */
+static void bench_synthetic(bench_trace_t *trace, size_t count, int key_count,
+                            const int mix[3], bool zipf, int min, int max) {
+    unsigned long seed = bench_seed;
+    trace->key_count = key_count;
+    trace->keys = bench_keys(key_count, min, max);
+
+    int *ranked = bench_alloc(key_count * sizeof(int));
+    double *cdf = bench_alloc(key_count * sizeof(double));
+    double total = 0;
+    for (int i = 0; i < key_count; i++) {
+        ranked[i] = i;
+    }
+    for (int i = key_count - 1; i > 0; i--) {
+        int j = (int)(bench_random() % (i + 1));
+        int swap = ranked[i];
+        ranked[i] = ranked[j];
+        ranked[j] = swap;
+    }
+    for (int i = 0; i < key_count; i++) {
+        total += zipf ? 1.0 / (i + 1) : 1.0;
+        cdf[i] = total;
+    }
+
+    trace->prefill_count = (key_count + 1) / 2;
+    trace->prefill = bench_alloc(trace->prefill_count * sizeof(bench_op_t));
+    for (size_t i = 0; i < trace->prefill_count; i++) {
+        trace->prefill[i] = (bench_op_t){BENCH_INSERT, (int)i * 2, (float)i};
+    }
+
+    trace->count = count;
+    trace->ops = bench_alloc(count * sizeof(bench_op_t));
+    for (size_t i = 0; i < count; i++) {
+        double target = (double)bench_random() / (1ul << 31) * total;
+        int low = 0, high = key_count - 1;
+        while (low < high) {
+            int middle = (low + high) / 2;
+            if (cdf[middle] < target) {
+                low = middle + 1;
+            } else {
+                high = middle;
+            }
+        }
+        int kind = (int)(bench_random() % 100);
+        trace->ops[i].type = kind < mix[0]            ? BENCH_GET
+                             : kind < mix[0] + mix[1] ? BENCH_INSERT
+                                                      : BENCH_DELETE;
+        trace->ops[i].key = ranked[low];
+        trace->ops[i].value = (float)(i % 1000000);
+    }
+    free(cdf);
+    free(ranked);
+
+    snprintf(trace->name, sizeof(trace->name),
+             "mix=%d/%d/%d;dist=%s;len=%d-%d;seed=%lu", mix[0], mix[1], mix[2],
+             zipf ? "zipf" : "uniform", min, max, seed);
+}
+
+/*
+ * Index kľúča key v poli keys; nový kľúč sa pridá. Kľúče sa hľadajú
+ * v tabuľke s otvoreným adresovaním veľkosti capacity (mocnina dvoch).
+ */
+static int bench_intern(bench_trace_t *trace, int **slots, size_t *capacity,
+                        const char *key) {
+    if ((size_t)trace->key_count * 2 >= *capacity) {
+        size_t grown = *capacity > 0 ? *capacity * 2 : 1024;
+        int *table = bench_alloc(grown * sizeof(int));
+        for (size_t i = 0; i < grown; i++) {
+            table[i] = -1;
+        }
+        for (size_t i = 0; i < *capacity; i++) {
+            if ((*slots)[i] < 0) continue;
+            uint64_t hash = 14695981039346656037u;
+            for (const char *c = trace->keys[(*slots)[i]]; *c != '\0'; c++) {
+                hash = (hash ^ (unsigned char)*c) * 1099511628211u;
+            }
+            size_t slot = hash & (grown - 1);
+            while (table[slot] >= 0) slot = (slot + 1) & (grown - 1);
+            table[slot] = (*slots)[i];
+        }
+        free(*slots);
+        *slots = table;
+        *capacity = grown;
+        trace->keys = realloc(trace->keys, grown / 2 * sizeof(char *));
+        if (trace->keys == NULL) {
+            fprintf(stderr, "bench: out of memory\n");
+            exit(1);
+        }
+    }
+
+    uint64_t hash = 14695981039346656037u;
+    for (const char *c = key; *c != '\0'; c++) {
+        hash = (hash ^ (unsigned char)*c) * 1099511628211u;
+    }
+    size_t slot = hash & (*capacity - 1);
+    while ((*slots)[slot] >= 0) {
+        if (strcmp(trace->keys[(*slots)[slot]], key) == 0) {
+            return (*slots)[slot];
+        }
+        slot = (slot + 1) & (*capacity - 1);
+    }
+    char *copy = bench_alloc(strlen(key) + 1);
+    strcpy(copy, key);
+    trace->keys[trace->key_count] = copy;
+    (*slots)[slot] = trace->key_count;
+    return trace->key_count++;
+}
+
+/*
+ * Načítanie zaznamenaného záznamu zo súboru path.
+ */
+static bool bench_load(bench_trace_t *trace, const char *path) {
+    FILE *file = fopen(path, "r");
+    if (file == NULL) {
+        perror(path);
+        return false;
+    }
+
+    int *slots = NULL;
+    size_t capacity = 0, allocated = 0;
+    char line[BENCH_LINE], command[16], key[BENCH_LINE];
+    unsigned long number = 0;
+    bool ok = true;
+
+    while (fgets(line, sizeof(line), file) != NULL) {
+        number++;
+        float value = 0;
+        int fields = sscanf(line, "%15s %255s %f", command, key, &value);
+        if (fields <= 0 || command[0] == '#') continue;
+
+        bench_op_t op;
+        if (strcmp(command, "get") == 0 && fields == 2) {
+            op.type = BENCH_GET;
+        } else if (strcmp(command, "insert") == 0 && fields == 3) {
+            op.type = BENCH_INSERT;
+        } else if (strcmp(command, "delete") == 0 && fields == 2) {
+            op.type = BENCH_DELETE;
+        } else {
+            fprintf(stderr, "%s:%lu: invalid operation\n", path, number);
+            ok = false;
+            break;
+        }
+        op.key = bench_intern(trace, &slots, &capacity, key);
+        op.value = value;
+
+        if (trace->count == allocated) {
+            allocated = allocated > 0 ? allocated * 2 : 4096;
+            trace->ops = realloc(trace->ops, allocated * sizeof(bench_op_t));
+            if (trace->ops == NULL) {
+                fprintf(stderr, "bench: out of memory\n");
+                exit(1);
+            }
+        }
+        trace->ops[trace->count++] = op;
+    }
+    fclose(file);
+    free(slots);
+
+    const char *name = strrchr(path, '/');
+    snprintf(trace->name, sizeof(trace->name), "file=%s",
+             name != NULL ? name + 1 : path);
+    return ok;
+}
+
+static void bench_usage(const char *program) {
+    fprintf(stderr,
+            "Usage: %s [-n operations] [-k keys] [-m get/insert/delete]\n"
+            "       [-d uniform|zipf] [-l min-max] [-s seed] [-t trace]\n"
+            "       [-b backend,...] [-o file.csv]\n",
+            program);
+}
+
+int main(int argc, char *argv[]) {
+    size_t count = 1000000;
+    int key_count = BENCH_TREE_KEYS;
+    int mix[3] = {80, 10, 10};
+    bool zipf = false;
+    int min = 4, max = 16;
+    const char *trace_path = NULL, *selected = NULL, *output = NULL;
+    int option;
+
+    while ((option = getopt(argc, argv, "n:k:m:d:l:s:t:b:o:")) != -1) {
+        switch (option) {
+        case 'n':
+            count = strtoul(optarg, NULL, 10);
+            break;
+        case 'k':
+            key_count = atoi(optarg);
+            break;
+        case 'm':
+            if (sscanf(optarg, "%d/%d/%d", &mix[0], &mix[1], &mix[2]) != 3 ||
+                mix[0] < 0 || mix[1] < 0 || mix[2] < 0 ||
+                mix[0] + mix[1] + mix[2] != 100) {
+                fprintf(stderr, "bench: -m needs three percentages summing "
+                                "to 100\n");
+                return 1;
+            }
+            break;
+        case 'd':
+            zipf = strcmp(optarg, "zipf") == 0;
+            break;
+        case 'l':
+            if (sscanf(optarg, "%d-%d", &min, &max) != 2 || min < 1 ||
+                max < min || max >= BENCH_LINE) {
+                fprintf(stderr, "bench: -l needs min-max key lengths\n");
+                return 1;
+            }
+            break;
+        case 's':
+            bench_seed = strtoul(optarg, NULL, 10);
+            break;
+        case 't':
+            trace_path = optarg;
+            break;
+        case 'b':
+            selected = optarg;
+            break;
+        case 'o':
+            output = optarg;
+            break;
+        default:
+            bench_usage(argv[0]);
+            return 1;
+        }
+    }
+    if (key_count < 1) {
+        bench_usage(argv[0]);
+        return 1;
+    }
+
+    bench_trace_t trace;
+    memset(&trace, 0, sizeof(trace));
+    if (trace_path != NULL) {
+        if (!bench_load(&trace, trace_path)) return 1;
+    } else {
+        bench_synthetic(&trace, count, key_count, mix, zipf, min, max);
+    }
+
+    FILE *csv = stdout;
+    if (output != NULL) {
+        csv = fopen(output, "a");
+        if (csv == NULL) {
+            perror(output);
+            return 1;
+        }
+    }
+    if (ftell(csv) <= 0) {
+        fprintf(csv, "date,trace,backend,operations,keys,ops_per_sec,p50_ns,"
+                     "p99_ns,p999_ns,hits,peak_rss_kb,memory_bytes,cache_misses\n");
+    }
+
+    char date[32];
+    time_t now = time(NULL);
+    strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%SZ", gmtime(&now));
+
+    int status = 0;
+    for (size_t b = 0; b < sizeof(BACKENDS) / sizeof(BACKENDS[0]); b++) {
+        const bench_backend_t *backend = &BACKENDS[b];
+        if (selected != NULL) {
+            size_t length = strlen(backend->name);
+            const char *match = strstr(selected, backend->name);
+            while (match != NULL &&
+                   ((match != selected && match[-1] != ',') ||
+                    (match[length] != '\0' && match[length] != ','))) {
+                match = strstr(match + 1, backend->name);
+            }
+            if (match == NULL) continue;
+        }
+        if (backend->max_keys > 0 && trace.key_count > backend->max_keys) {
+            fprintf(stderr, "bench: skipping %s, %d keys exceed its %d\n",
+                    backend->name, trace.key_count, backend->max_keys);
+            continue;
+        }
+
+        bench_result_t result;
+        long peak_rss;
+        if (!bench_measure(backend, &trace, &result, &peak_rss)) {
+            fprintf(stderr, "bench: measuring %s failed\n", backend->name);
+            status = 1;
+            continue;
+        }
+
+        fprintf(csv, "%s,%s,%s,%zu,%d,%.0f,%llu,%llu,%llu,%ld,%ld,", date,
+                trace.name, backend->name, trace.count, trace.key_count,
+                result.seconds > 0 ? trace.count / result.seconds : 0.0,
+                (unsigned long long)result.p50, (unsigned long long)result.p99,
+                (unsigned long long)result.p999, result.hits, peak_rss);
+        if (result.memory != BENCH_UNKNOWN) fprintf(csv, "%zu", result.memory);
+        fprintf(csv, ",");
+        if (result.cache_misses >= 0) fprintf(csv, "%lld", result.cache_misses);
+        fprintf(csv, "\n");
+        fflush(csv);
+    }
+
+    if (csv != stdout) fclose(csv);
+    for (int i = 0; i < trace.key_count; i++) {
+        free(trace.keys[i]);
+    }
+    free(trace.keys);
+    free(trace.prefill);
+    free(trace.ops);
+    return status;
+}
@@ -0,0 +1,84 @@
+/*
+ * Dávkové vykonávanie operácií nad binárnym vyhľadávacím stromom
+ *
+ * Operácie sa stabilne zoradia podľa kľúča triedením počítaním (kľúče sú
+ * typu char). Pre každý kľúč sa od koreňa zostúpi k odkazu, na ktorom uzol
+ * s kľúčom je alebo by bol, a všetky operácie s kľúčom sa vykonajú
+ * funkciami bst_* nad podstromom od tohto odkazu. Vloženie ani zmazanie
+ * nemení uzly nad odkazom, preto zostáva platný pre celú skupinu.
+ *
+ * Stabilné triedenie zachová poradie operácií nad rovnakým kľúčom, výsledok
+ * je preto rovnaký ako pri postupnom vykonaní operácií.
+ */
+
+#include "batch.h"
+#include <limits.h>
+#include <stdlib.h>
+
+#define BATCH_KEYS (UCHAR_MAX + 1)
+
+static void batch_apply(bst_node_t **link, bst_batch_op_t *op) {
+    int value;
+    op->found = bst_search(*link, op->key, &value);
+
+    switch (op->type) {
+    case BST_BATCH_SEARCH:
+        if (op->found) op->value = value;
+        break;
+    case BST_BATCH_INSERT:
+        bst_insert(link, op->key, op->value);
+        break;
+    case BST_BATCH_DELETE:
+        if (op->found) bst_delete(link, op->key);
+        break;
+    }
+}
+
+/*
+ * Vykonanie count operácií dávky ops nad stromom.
+ *
+ * Výsledok je rovnaký ako pri postupnom vykonaní operácií v poradí poľa.
+ * Pre každú operáciu sa do found zapíše, či kľúč pred operáciou v strome
+ * bol, a pri nájdenom kľúči hľadania sa do value zapíše jeho hodnota.
+ *
+ * Ak sa nepodarí alokovať pomocné pole, funkcia strom nezmení a vráti
+ * hodnotu false.
+ */
+bool bst_batch(bst_node_t **tree, bst_batch_op_t ops[], size_t count) {
+    if (count == 0) return true;
+
+    size_t *order = malloc(count * sizeof(size_t));
+    if (order == NULL) return false;
+
+    size_t start[BATCH_KEYS + 1] = {0};
+    for (size_t i = 0; i < count; i++) {
+        start[(unsigned char)(ops[i].key - CHAR_MIN) + 1]++;
+    }
+    for (int key = 0; key < BATCH_KEYS; key++) {
+        start[key + 1] += start[key];
+    }
+
+    size_t position[BATCH_KEYS];
+    for (int key = 0; key < BATCH_KEYS; key++) {
+        position[key] = start[key];
+    }
+    for (size_t i = 0; i < count; i++) {
+        order[position[(unsigned char)(ops[i].key - CHAR_MIN)]++] = i;
+    }
+
+    for (int key = 0; key < BATCH_KEYS; key++) {
+        if (start[key] == start[key + 1]) continue;
+
+        char group_key = ops[order[start[key]]].key;
+        bst_node_t **link = tree;
+        while (*link != NULL && (*link)->key != group_key) {
+            link = (*link)->key > group_key ? &(*link)->left : &(*link)->right;
+        }
+        for (size_t o = start[key]; o < start[key + 1]; o++) {
+            batch_apply(link, &ops[order[o]]);
+        }
+    }
+
+    free(order);
+    return true;
+}
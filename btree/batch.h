@@ -0,0 +1,34 @@
+/*
+ * Hlavičkový súbor pre dávkové vykonávanie operácií nad binárnym
+ * vyhľadávacím stromom.
+ *
+ * Operácie dávky sa zoskupia podľa kľúča a každá skupina sa vykoná nad
+ * podstromom, ku ktorému sa zostúpi iba raz. Výsledky sa zapíšu do operácií
+ * v pôvodnom poradí.
+ */
+
+#ifndef IAL_BTREE_BATCH_H
+#define IAL_BTREE_BATCH_H
+
+#include "btree.h"
+#include <stdbool.h>
+#include <stddef.h>
+
+// Druh operácie dávky
+typedef enum bst_batch_type {
+  BST_BATCH_SEARCH, // ako bst_search
+  BST_BATCH_INSERT, // ako bst_insert
+  BST_BATCH_DELETE  // ako bst_delete
+} bst_batch_type_t;
+
+// Operácia dávky
+typedef struct bst_batch_op {
+  bst_batch_type_t type; // druh operácie
+  char key;              // kľúč
+  int value;             // vkladaná hodnota, pri hľadaní nájdená hodnota
+  bool found;            // výsledok: kľúč v strome pred operáciou bol
+} bst_batch_op_t;
+
+bool bst_batch(bst_node_t **tree, bst_batch_op_t ops[], size_t count);
+
+#endif
@@ -0,0 +1,423 @@
+/*
+ * Výkonnostné testy binárneho vyhľadávacieho stromu.
+ *
+ * Spustenie: ./bench [názov testu]
+ * Bez argumentu sa spustia všetky testy.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "btree.h"
+#include "batch.h"
+#include "parallel.h"
+#include "persistent.h"
+#include "splay.h"
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+static double bench_now(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+/*
+ * Vloženie kľúčov z intervalu <low,high> tak, aby bol strom vyvážený.
+ */
+static void bench_insert_balanced(bst_node_t **tree, int low, int high) {
+    if (low > high) return;
+
+    int middle = low + (high - low) / 2;
+    bst_insert(tree, (char)middle, middle);
+    bench_insert_balanced(tree, low, middle - 1);
+    bench_insert_balanced(tree, middle + 1, high);
+}
+
+static long bench_expensive_map(bst_node_t *node, void *context) {
+    unsigned long state = (unsigned long)node->value;
+    for (int i = 0; i < *(int *)context; i++) {
+        state = state * 6364136223846793005ul + 1442695040888963407ul;
+    }
+    return (long)(state >> 60);
+}
+
+static long bench_value(bst_node_t *node, void *context) {
+    return node->value;
+}
+
+static long bench_sum(long left, long right, void *context) {
+    return left + right;
+}
+
+/*
+ * Paralelný prechod stromom s drahou funkciou map pri rôznom počte vlákien.
+ */
+static void bench_parallel_reduce(void) {
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    bst_node_t *tree;
+    bst_init(&tree);
+    bench_insert_balanced(&tree, CHAR_MIN, CHAR_MAX);
+
+    int work = 20000;
+    double start = bench_now();
+    long expected = bst_parallel_reduce(tree, bench_expensive_map, bench_sum,
+                                        0, &work, 1);
+    double serial = bench_now() - start;
+
+    printf("%-8s %12s %10s\n", "threads", "nodes/s", "speedup");
+    for (long threads = 1; threads <= (cores > 1 ? cores : 1); threads *= 2) {
+        start = bench_now();
+        long result = bst_parallel_reduce(tree, bench_expensive_map,
+                                          bench_sum, 0, &work, (int)threads);
+        double parallel = bench_now() - start;
+        printf("%-8ld %12.0f %10.2f%s\n", threads, 256 / parallel,
+               serial / parallel, result == expected ? "" : " MISMATCH");
+    }
+    printf("\n");
+
+    // Lacná funkcia map: réžia volania prevládne nad samotným prechodom
+    const int rounds = 2000;
+    expected = bst_parallel_reduce(tree, bench_value, bench_sum, 0, NULL, 1);
+    start = bench_now();
+    for (int r = 0; r < rounds; r++) {
+        bst_parallel_reduce(tree, bench_value, bench_sum, 0, NULL, 1);
+    }
+    serial = (bench_now() - start) / rounds;
+
+    printf("sum of values, serial %.2f us/call\n", serial * 1e6);
+    printf("%-8s %14s %14s\n", "threads", "per call us", "pool us");
+    for (long threads = 2; threads <= (cores > 2 ? cores : 2); threads *= 2) {
+        bool same = true;
+        start = bench_now();
+        for (int r = 0; r < rounds; r++) {
+            same &= bst_parallel_reduce(tree, bench_value, bench_sum, 0, NULL,
+                                        (int)threads) == expected;
+        }
+        double per_call = (bench_now() - start) / rounds;
+
+        bst_pool_t pool;
+        if (!bst_pool_init(&pool, (int)threads)) break;
+        start = bench_now();
+        for (int r = 0; r < rounds; r++) {
+            same &= bst_pool_reduce(&pool, tree, bench_value, bench_sum, 0,
+                                    NULL) == expected;
+        }
+        double pooled = (bench_now() - start) / rounds;
+        bst_pool_dispose(&pool);
+
+        printf("%-8ld %14.2f %14.2f%s\n", threads, per_call * 1e6,
+               pooled * 1e6, same ? "" : " MISMATCH");
+    }
+    printf("\n");
+
+    bst_dispose(&tree);
+}
+
+static unsigned long bench_seed = 42;
+
+static unsigned long bench_random(void) {
+    bench_seed = bench_seed * 6364136223846793005ul + 1442695040888963407ul;
+    return bench_seed >> 33;
+}
+
+/*
+ * Postupnosť count kľúčov so Zipfovým rozdelením (s = 1): kľúč s poradím r
+ * v náhodnej permutácii všetkých kľúčov sa vyberá s pravdepodobnosťou
+ * úmernou 1/r. Pre zipf == false sú kľúče rozdelené rovnomerne.
+ */
+static void bench_zipf_keys(char *keys, int count, bool zipf) {
+    char ranked[256];
+    double cdf[256], total = 0;
+
+    for (int i = 0; i < 256; i++) {
+        ranked[i] = (char)(CHAR_MIN + i);
+    }
+    for (int i = 255; i > 0; i--) {
+        int j = (int)(bench_random() % (i + 1));
+        char swap = ranked[i];
+        ranked[i] = ranked[j];
+        ranked[j] = swap;
+    }
+    for (int i = 0; i < 256; i++) {
+        total += zipf ? 1.0 / (i + 1) : 1.0;
+        cdf[i] = total;
+    }
+
+    for (int i = 0; i < count; i++) {
+        double sample = (double)bench_random() / (1ul << 31) * total;
+        int low = 0, high = 255;
+        while (low < high) {
+            int middle = (low + high) / 2;
+            if (cdf[middle] < sample) {
+                low = middle + 1;
+            } else {
+                high = middle;
+            }
+        }
+        keys[i] = ranked[low];
+    }
+}
+
+/*
+ * Vyhľadávanie pomocou bst_search a bst_splay_search pri rovnomernom a
+ * Zipfovom rozdelení hľadaných kľúčov. Strom obsahuje všetky kľúče vložené
+ * v náhodnom alebo vzostupnom poradí (degenerovaný strom).
+ */
+static void bench_splay(void) {
+    const int lookups = 2000000;
+    char *keys = malloc(lookups);
+    char order[256];
+
+    printf("%-8s %-8s %14s %14s %10s\n", "insert", "access", "search/s",
+           "splay/s", "speedup");
+    for (int sorted = 0; sorted <= 1; sorted++) {
+        for (int i = 0; i < 256; i++) {
+            order[i] = (char)(CHAR_MIN + i);
+        }
+        for (int i = 255; !sorted && i > 0; i--) {
+            int j = (int)(bench_random() % (i + 1));
+            char swap = order[i];
+            order[i] = order[j];
+            order[j] = swap;
+        }
+
+        for (int zipf = 0; zipf <= 1; zipf++) {
+            bst_node_t *tree = NULL;
+            for (int i = 0; i < 256; i++) {
+                bst_insert(&tree, order[i], i);
+            }
+            bench_zipf_keys(keys, lookups, zipf);
+
+            volatile long sink = 0;
+            int value;
+            double start = bench_now();
+            for (int i = 0; i < lookups; i++) {
+                sink += bst_search(tree, keys[i], &value);
+            }
+            double plain = bench_now() - start;
+
+            start = bench_now();
+            for (int i = 0; i < lookups; i++) {
+                sink += bst_splay_search(&tree, keys[i], &value);
+            }
+            double splay = bench_now() - start;
+            (void)sink;
+
+            printf("%-8s %-8s %14.0f %14.0f %10.2f\n",
+                   sorted ? "sorted" : "random", zipf ? "zipf" : "uniform",
+                   lookups / plain, lookups / splay, plain / splay);
+            bst_dispose(&tree);
+        }
+    }
+    printf("\n");
+
+    free(keys);
+}
+
+/*
+ * Pôvodná inicializácia, ktorá alokovala uzol a vracala ho ako koreň
+ * prázdneho stromu (na porovnanie, kľúč je tu kvôli determinizmu nulový).
+ */
+static void bench_init_sentinel(bst_node_t **tree) {
+    *tree = malloc(sizeof(bst_node_t));
+    (*tree)->key = 0;
+    (*tree)->value = 0;
+    (*tree)->left = NULL;
+    (*tree)->right = NULL;
+}
+
+/*
+ * Vytvorenie a zrušenie mnohých malých stromov s bst_init, ktorý nič
+ * nealokuje, a s pôvodnou inicializáciou alokujúcou koreň.
+ */
+static void bench_small_trees(void) {
+    const int trees = 1000000;
+    const int sizes[] = {0, 1, 4};
+
+    printf("%-6s %14s %14s %10s\n", "nodes", "sentinel/s", "bst_init/s",
+           "speedup");
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        double times[2];
+        for (int variant = 0; variant <= 1; variant++) {
+            volatile long sink = 0;
+            double start = bench_now();
+            for (int t = 0; t < trees; t++) {
+                bst_node_t *tree;
+                if (variant == 0) {
+                    bench_init_sentinel(&tree);
+                } else {
+                    bst_init(&tree);
+                }
+                for (int k = 0; k < sizes[s]; k++) {
+                    bst_insert(&tree, (char)('a' + (t + k * 3) % 26), k);
+                }
+                sink += tree != NULL;
+                bst_dispose(&tree);
+            }
+            times[variant] = bench_now() - start;
+            (void)sink;
+        }
+        printf("%-6d %14.0f %14.0f %10.2f\n", sizes[s], trees / times[0],
+               trees / times[1], times[0] / times[1]);
+    }
+    printf("\n");
+}
+
+/*
+ * Zmiešané operácie (80 % hľadanie, 10 % vloženie, 10 % zmazanie) nad
+ * stromom so zoradeným vstupom: postupné volania bst_* oproti dávkam.
+ */
+static void bench_batch(void) {
+    const int operations = 1000000;
+    const int batch_sizes[] = {64, 1024, 16384};
+    bst_batch_op_t *ops = malloc(operations * sizeof(bst_batch_op_t));
+
+    for (int i = 0; i < operations; i++) {
+        int kind = (int)(bench_random() % 10);
+        ops[i].type = kind < 8   ? BST_BATCH_SEARCH
+                      : kind < 9 ? BST_BATCH_INSERT
+                                 : BST_BATCH_DELETE;
+        ops[i].key = (char)(CHAR_MIN + bench_random() % 256);
+        ops[i].value = i;
+    }
+
+    bst_node_t *tree;
+    bst_init(&tree);
+    for (int key = CHAR_MIN; key <= CHAR_MAX; key += 2) {
+        bst_insert(&tree, (char)key, key);
+    }
+    volatile long sink = 0;
+    int value;
+    double start = bench_now();
+    for (int i = 0; i < operations; i++) {
+        switch (ops[i].type) {
+        case BST_BATCH_SEARCH:
+            sink += bst_search(tree, ops[i].key, &value);
+            break;
+        case BST_BATCH_INSERT:
+            bst_insert(&tree, ops[i].key, ops[i].value);
+            break;
+        case BST_BATCH_DELETE:
+            bst_delete(&tree, ops[i].key);
+            break;
+        }
+    }
+    double serial = bench_now() - start;
+    (void)sink;
+    bst_dispose(&tree);
+
+    printf("%-8s %14s %10s\n", "batch", "ops/s", "speedup");
+    printf("%-8s %14.0f %10.2f\n", "serial", operations / serial, 1.0);
+    for (size_t b = 0; b < sizeof(batch_sizes) / sizeof(int); b++) {
+        for (int key = CHAR_MIN; key <= CHAR_MAX; key += 2) {
+            bst_insert(&tree, (char)key, key);
+        }
+        start = bench_now();
+        for (int i = 0; i < operations; i += batch_sizes[b]) {
+            int size = operations - i < batch_sizes[b] ? operations - i
+                                                       : batch_sizes[b];
+            bst_batch(&tree, ops + i, size);
+        }
+        double batched = bench_now() - start;
+        printf("%-8d %14.0f %10.2f\n", batch_sizes[b], operations / batched,
+               serial / batched);
+        bst_dispose(&tree);
+    }
+    printf("\n");
+
+    free(ops);
+}
+
+/*
+ * Hlboká kópia stromu, ktorou sa doteraz robili snímky pre čitateľov.
+ */
+static bst_node_t *bench_copy(bst_node_t *tree) {
+    if (tree == NULL) return NULL;
+    bst_node_t *copy = malloc(sizeof(bst_node_t));
+    copy->key = tree->key;
+    copy->value = tree->value;
+    copy->left = bench_copy(tree->left);
+    copy->right = bench_copy(tree->right);
+    return copy;
+}
+
+/*
+ * Striedanie snímky pre čitateľa (niekoľko hľadaní) a zápisu do stromu
+ * s náhodne vloženými kľúčmi: hlboká kópia oproti perzistentným verziám.
+ */
+static void bench_persistent(void) {
+    const int rounds = 200000;
+    const int sizes[] = {16, 64, 256};
+
+    printf("%-6s %14s %14s %10s\n", "nodes", "copy/s", "persistent/s",
+           "speedup");
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        bst_node_t *tree;
+        bst_init(&tree);
+        for (int i = 0; i < sizes[s]; i++) {
+            bst_insert(&tree, (char)(CHAR_MIN + bench_random() % sizes[s]), i);
+        }
+        bst_pnode_t *version = bst_persistent_from_tree(tree);
+        volatile long sink = 0;
+        int value;
+
+        double start = bench_now();
+        for (int r = 0; r < rounds; r++) {
+            bst_node_t *snapshot = bench_copy(tree);
+            for (int k = 0; k < 4; k++) {
+                sink += bst_search(snapshot, (char)(CHAR_MIN + (r + k) % 256),
+                                   &value);
+            }
+            bst_insert(&tree, (char)(CHAR_MIN + r % sizes[s]), r);
+            bst_dispose(&snapshot);
+        }
+        double copied = bench_now() - start;
+
+        start = bench_now();
+        for (int r = 0; r < rounds; r++) {
+            bst_pnode_t *snapshot = bst_persistent_retain(version);
+            for (int k = 0; k < 4; k++) {
+                sink += bst_persistent_search(
+                    snapshot, (char)(CHAR_MIN + (r + k) % 256), &value);
+            }
+            bst_pnode_t *next = bst_persistent_insert(
+                version, (char)(CHAR_MIN + r % sizes[s]), r);
+            bst_persistent_release(version);
+            version = next;
+            bst_persistent_release(snapshot);
+        }
+        double persistent = bench_now() - start;
+        (void)sink;
+
+        printf("%-6d %14.0f %14.0f %10.2f\n", sizes[s], rounds / copied,
+               rounds / persistent, copied / persistent);
+        bst_persistent_release(version);
+        bst_dispose(&tree);
+    }
+    printf("\n");
+}
+
+typedef struct {
+    const char *name;
+    void (*run)(void);
+} bench_t;
+
+static const bench_t BENCHMARKS[] = {
+    {"parallel_reduce", bench_parallel_reduce},
+    {"splay", bench_splay},
+    {"small_trees", bench_small_trees},
+    {"batch", bench_batch},
+    {"persistent", bench_persistent},
+};
+
+int main(int argc, char *argv[]) {
+    for (size_t i = 0; i < sizeof(BENCHMARKS) / sizeof(BENCHMARKS[0]); i++) {
+        if (argc > 1 && strcmp(argv[1], BENCHMARKS[i].name) != 0) continue;
+        printf("[%s]\n", BENCHMARKS[i].name);
+        BENCHMARKS[i].run();
+    }
+}
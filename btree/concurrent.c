@@ -0,0 +1,303 @@
+/*
+ * Súbežne použiteľný binárny vyhľadávací strom
+ *
+ * Popis synchronizácie je v súbore concurrent.h.
+ *
+ * Keďže kľúče sú typu char, strom nemôže mať viac ako 256 úrovní a cesty
+ * od koreňa sa ukladajú do poľa pevnej veľkosti.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "concurrent.h"
+#include <limits.h>
+#include <stdlib.h>
+
+#define BST_CONCURRENT_MAX_DEPTH (UCHAR_MAX + 1)
+
+/*
+ * Nový uzol. Uzly sa nealokujú cez alokátor z memory.h (pozri tam).
+ */
+static bst_node_t *concurrent_node(char key, int value, bst_node_t *left,
+                                   bst_node_t *right) {
+    bst_node_t *node = malloc(sizeof(bst_node_t));
+    if (node == NULL) abort();
+    node->key = key;
+    node->value = value;
+    node->left = left;
+    node->right = right;
+    return node;
+}
+
+static void concurrent_retire(bst_concurrent_t *map, bst_node_t *node) {
+    if (map->retired_count == map->retired_capacity) {
+        map->retired_capacity =
+            map->retired_capacity > 0 ? map->retired_capacity * 2 : 64;
+        map->retired = realloc(map->retired,
+                               map->retired_capacity * sizeof(bst_retired_t));
+        if (map->retired == NULL) abort();
+    }
+    map->retired[map->retired_count++] =
+        (bst_retired_t){node, atomic_load(&map->epoch)};
+}
+
+/*
+ * Posun globálnej epochy a uvoľnenie uzlov, ktoré už nikto nemôže vidieť.
+ *
+ * Epocha sa posunie iba vtedy, keď všetci práve čítajúci začali čítať
+ * v aktuálnej epoche. Uzol nahradený v epoche e preto môže vidieť iba
+ * čitateľ z epochy e alebo staršej a po dosiahnutí epochy e + 2 žiadny
+ * taký čitateľ neexistuje.
+ */
+static void concurrent_reclaim(bst_concurrent_t *map) {
+    unsigned long epoch = atomic_load(&map->epoch);
+
+    for (int i = 0; i < BST_CONCURRENT_MAX_THREADS; i++) {
+        unsigned long active = atomic_load(&map->slots[i].epoch);
+        if (active != 0 && active != epoch) return;
+    }
+    atomic_store(&map->epoch, ++epoch);
+
+    size_t kept = 0;
+    for (size_t i = 0; i < map->retired_count; i++) {
+        if (map->retired[i].epoch + 2 <= epoch) {
+            free(map->retired[i].node);
+        } else {
+            map->retired[kept++] = map->retired[i];
+        }
+    }
+    map->retired_count = kept;
+}
+
+/*
+ * Skopírovanie predkov na ceste path[0..depth-1] s novým potomkom child.
+ *
+ * Pôvodné uzly cesty sa odložia na uvoľnenie, funkcia vráti nový koreň.
+ */
+static bst_node_t *concurrent_copy_path(bst_concurrent_t *map,
+                                        bst_node_t **path, int depth,
+                                        bst_node_t *child, char key) {
+    for (int i = depth - 1; i >= 0; i--) {
+        bst_node_t *node = path[i];
+        child = node->key > key
+                    ? concurrent_node(node->key, node->value, child, node->right)
+                    : concurrent_node(node->key, node->value, node->left, child);
+        concurrent_retire(map, node);
+    }
+    return child;
+}
+
+static void concurrent_enter(bst_concurrent_t *map, int slot) {
+    unsigned long epoch = atomic_load(&map->epoch);
+    for (;;) {
+        atomic_store(&map->slots[slot].epoch, epoch);
+        unsigned long current = atomic_load(&map->epoch);
+        if (current == epoch) return;
+        epoch = current;
+    }
+}
+
+static void concurrent_exit(bst_concurrent_t *map, int slot) {
+    atomic_store(&map->slots[slot].epoch, 0);
+}
+
+/*
+ * Inicializácia prázdneho stromu.
+ */
+void bst_concurrent_init(bst_concurrent_t *map) {
+    atomic_init(&map->root, NULL);
+    atomic_init(&map->epoch, 1);
+    pthread_mutex_init(&map->writer, NULL);
+    map->retired = NULL;
+    map->retired_count = 0;
+    map->retired_capacity = 0;
+    for (int i = 0; i < BST_CONCURRENT_MAX_THREADS; i++) {
+        atomic_init(&map->slots[i].used, 0);
+        atomic_init(&map->slots[i].epoch, 0);
+    }
+}
+
+/*
+ * Zrušenie stromu.
+ *
+ * So stromom v tej chvíli nesmie pracovať žiadne iné vlákno.
+ */
+void bst_concurrent_dispose(bst_concurrent_t *map) {
+    bst_node_t *stack[BST_CONCURRENT_MAX_DEPTH + 1];
+    int top = 0;
+    bst_node_t *root = atomic_load(&map->root);
+
+    if (root != NULL) stack[top++] = root;
+    while (top > 0) {
+        bst_node_t *node = stack[--top];
+        if (node->left != NULL) stack[top++] = node->left;
+        if (node->right != NULL) stack[top++] = node->right;
+        free(node);
+    }
+
+    for (size_t i = 0; i < map->retired_count; i++) {
+        free(map->retired[i].node);
+    }
+    free(map->retired);
+    pthread_mutex_destroy(&map->writer);
+
+    atomic_store(&map->root, NULL);
+    map->retired = NULL;
+    map->retired_count = 0;
+    map->retired_capacity = 0;
+}
+
+/*
+ * Pridelenie slotu volajúcemu vláknu.
+ *
+ * Funkcia vráti číslo slotu alebo -1, ak sú všetky sloty obsadené.
+ */
+int bst_concurrent_register(bst_concurrent_t *map) {
+    for (int i = 0; i < BST_CONCURRENT_MAX_THREADS; i++) {
+        unsigned long expected = 0;
+        if (atomic_compare_exchange_strong(&map->slots[i].used, &expected,
+                                           1)) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/*
+ * Uvoľnenie slotu vlákna.
+ */
+void bst_concurrent_unregister(bst_concurrent_t *map, int slot) {
+    atomic_store(&map->slots[slot].epoch, 0);
+    atomic_store(&map->slots[slot].used, 0);
+}
+
+/*
+ * Nájdenie uzlu v strome bez zámkov.
+ *
+ * V prípade úspechu vráti funkcia hodnotu true a do premennej value zapíše
+ * hodnotu daného uzlu. V opačnom prípade funkcia vráti hodnotu false a
+ * premenná value ostáva nezmenená.
+ */
+bool bst_concurrent_search(bst_concurrent_t *map, int slot, char key,
+                           int *value) {
+    concurrent_enter(map, slot);
+
+    bst_node_t *node = atomic_load(&map->root);
+    while (node != NULL && node->key != key) {
+        node = node->key > key ? node->left : node->right;
+    }
+    if (node != NULL) {
+        *value = node->value;
+    }
+
+    concurrent_exit(map, slot);
+    return node != NULL;
+}
+
+/*
+ * Vloženie uzlu do stromu.
+ *
+ * Pokiaľ uzol so zadaným kľúčom v strome už existuje, nahradí sa jeho kópiou
+ * s novou hodnotou. Inak sa vloží nový listový uzol.
+ *
+ * Zapisovatelia sa vylučujú zámkom a slot nepotrebujú.
+ */
+void bst_concurrent_insert(bst_concurrent_t *map, char key, int value) {
+    bst_node_t *path[BST_CONCURRENT_MAX_DEPTH];
+    int depth = 0;
+
+    pthread_mutex_lock(&map->writer);
+
+    bst_node_t *node = atomic_load(&map->root);
+    while (node != NULL && node->key != key) {
+        path[depth++] = node;
+        node = node->key > key ? node->left : node->right;
+    }
+
+    bst_node_t *child;
+    if (node != NULL) {
+        child = concurrent_node(key, value, node->left, node->right);
+        concurrent_retire(map, node);
+    } else {
+        child = concurrent_node(key, value, NULL, NULL);
+    }
+
+    atomic_store(&map->root, concurrent_copy_path(map, path, depth, child, key));
+    concurrent_reclaim(map);
+
+    pthread_mutex_unlock(&map->writer);
+}
+
+/*
+ * Odstránenie uzlu zo stromu.
+ *
+ * Pokiaľ uzol so zadaným kľúčom neexistuje, funkcia nič nerobí. Uzol s oboma
+ * podstromami sa nahradí kópiou najpravejšieho uzlu ľavého podstromu;
+ * pôvodné uzly sa nemenia, takže súbežní čitatelia ich môžu ďalej čítať.
+ */
+void bst_concurrent_delete(bst_concurrent_t *map, char key) {
+    bst_node_t *path[BST_CONCURRENT_MAX_DEPTH];
+    int depth = 0;
+
+    pthread_mutex_lock(&map->writer);
+
+    bst_node_t *target = atomic_load(&map->root);
+    while (target != NULL && target->key != key) {
+        path[depth++] = target;
+        target = target->key > key ? target->left : target->right;
+    }
+
+    if (target != NULL) {
+        bst_node_t *replacement;
+
+        if (target->left == NULL) {
+            replacement = target->right;
+        } else if (target->right == NULL) {
+            replacement = target->left;
+        } else {
+            bst_node_t *left_path[BST_CONCURRENT_MAX_DEPTH];
+            int left_depth = 0;
+            bst_node_t *rightmost = target->left;
+            while (rightmost->right != NULL) {
+                left_path[left_depth++] = rightmost;
+                rightmost = rightmost->right;
+            }
+
+            bst_node_t *left = rightmost->left;
+            for (int i = left_depth - 1; i >= 0; i--) {
+                left = concurrent_node(left_path[i]->key, left_path[i]->value,
+                                       left_path[i]->left, left);
+                concurrent_retire(map, left_path[i]);
+            }
+            replacement = concurrent_node(rightmost->key, rightmost->value,
+                                          left, target->right);
+            concurrent_retire(map, rightmost);
+        }
+
+        concurrent_retire(map, target);
+        atomic_store(&map->root, concurrent_copy_path(map, path, depth,
+                                                      replacement, key));
+        concurrent_reclaim(map);
+    }
+
+    pthread_mutex_unlock(&map->writer);
+}
+
+/*
+ * Získanie konzistentnej verzie stromu na čítanie.
+ *
+ * Vrátený koreň (a celý strom pod ním) zostane platný a nemenný až do
+ * volania bst_concurrent_unpin, takže ho možno prechádzať napríklad funkciou
+ * bst_inorder.
+ */
+bst_node_t *bst_concurrent_pin(bst_concurrent_t *map, int slot) {
+    concurrent_enter(map, slot);
+    return atomic_load(&map->root);
+}
+
+/*
+ * Uvoľnenie verzie stromu získanej funkciou bst_concurrent_pin.
+ */
+void bst_concurrent_unpin(bst_concurrent_t *map, int slot) {
+    concurrent_exit(map, slot);
+}
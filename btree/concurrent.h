@@ -0,0 +1,64 @@
+/*
+ * Hlavičkový súbor pre súbežne použiteľný binárny vyhľadávací strom.
+ *
+ * Uzly publikovaného stromu sa nikdy nemenia. Zápis skopíruje uzly na ceste
+ * od koreňa k menenému uzlu a atomicky vymení koreň (copy-on-write), takže
+ * čitatelia prechádzajú strom bez zámkov a vždy vidia konzistentnú verziu.
+ * Zapisovatelia sa navzájom vylučujú zámkom. Nahradené uzly sa uvoľnia až
+ * vtedy, keď ich už žiadny čitateľ nemôže vidieť (epoch-based reclamation).
+ *
+ * Každé vlákno, ktoré zo stromu číta, si najprv vyžiada slot funkciou
+ * bst_concurrent_register a ten potom odovzdáva čítacím operáciám.
+ */
+
+#ifndef IAL_BTREE_CONCURRENT_H
+#define IAL_BTREE_CONCURRENT_H
+
+#include "btree.h"
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// Maximálny počet súčasne registrovaných vlákien
+#define BST_CONCURRENT_MAX_THREADS 64
+
+// Uzol čakajúci na uvoľnenie
+typedef struct bst_retired {
+  bst_node_t *node;
+  unsigned long epoch; // epocha, v ktorej bol uzol nahradený
+} bst_retired_t;
+
+// Slot vlákna
+typedef struct bst_concurrent_slot {
+  atomic_ulong used;  // slot je pridelený vláknu
+  atomic_ulong epoch; // epocha prebiehajúceho čítania, 0 mimo čítania
+  char padding[64 - 2 * sizeof(atomic_ulong)]; // slot na vlastnom riadku cache
+} bst_concurrent_slot_t;
+
+// Strom
+typedef struct bst_concurrent {
+  _Atomic(bst_node_t *) root;
+  atomic_ulong epoch;      // globálna epocha, začína od 1
+  pthread_mutex_t writer;  // vzájomné vylúčenie zapisovateľov
+  bst_retired_t *retired;  // nahradené uzly (chránené zámkom writer)
+  size_t retired_count;
+  size_t retired_capacity;
+  bst_concurrent_slot_t slots[BST_CONCURRENT_MAX_THREADS];
+} bst_concurrent_t;
+
+void bst_concurrent_init(bst_concurrent_t *map);
+void bst_concurrent_dispose(bst_concurrent_t *map);
+
+int bst_concurrent_register(bst_concurrent_t *map);
+void bst_concurrent_unregister(bst_concurrent_t *map, int slot);
+
+bool bst_concurrent_search(bst_concurrent_t *map, int slot, char key,
+                           int *value);
+void bst_concurrent_insert(bst_concurrent_t *map, char key, int value);
+void bst_concurrent_delete(bst_concurrent_t *map, char key);
+
+bst_node_t *bst_concurrent_pin(bst_concurrent_t *map, int slot);
+void bst_concurrent_unpin(bst_concurrent_t *map, int slot);
+
+#endif
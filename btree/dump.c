@@ -0,0 +1,379 @@
+/*
+ * Výpis binárneho vyhľadávacieho stromu
+ *
+ * Strom sa prechádza iteratívne s explicitným zásobníkom rámcov, ktorý rastie
+ * podľa hĺbky stromu, takže výpis nezávisí od veľkosti zásobníka volaní.
+ * Odsadenie textového výpisu sa skladá v jedinom buffri: každý rámec si
+ * pamätá iba dĺžku svojej predpony a potomok k nej dopíše svoj úsek.
+ * Počet alokácií je tak úmerný logaritmu hĺbky, nie počtu uzlov.
+ */
+
+#include "dump.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define DUMP_SEGMENT_LENGTH 3
+
+static const char *dump_subtree_segment = "  |";
+static const char *dump_space_segment = "   ";
+
+typedef enum dump_from { DUMP_ROOT, DUMP_LEFT, DUMP_RIGHT } dump_from_t;
+
+typedef struct dump_frame {
+    bst_node_t *node;
+    dump_from_t from;    // strana, z ktorej sa do uzlu vstúpilo
+    int state;           // 0 pred, 1 medzi a 2 po spracovaní potomkov
+    size_t prefix;       // dĺžka predpony (textový výpis)
+    unsigned long id;    // poradové číslo uzlu (DOT)
+} dump_frame_t;
+
+typedef struct dump_walk {
+    bst_dump_t *dump;
+    dump_frame_t *frames;
+    size_t top;
+    size_t capacity;
+    char *prefix;
+    size_t prefix_capacity;
+} dump_walk_t;
+
+static void dump_reset(bst_dump_t *dump, FILE *file) {
+    dump->file = file;
+    dump->memory = NULL;
+    dump->length = 0;
+    dump->capacity = 0;
+    dump->failed = false;
+    dump->used = 0;
+}
+
+/*
+ * Inicializácia výpisu do súboru.
+ */
+void bst_dump_init_file(bst_dump_t *dump, FILE *file) {
+    dump_reset(dump, file);
+}
+
+/*
+ * Inicializácia výpisu do pamäte.
+ *
+ * Výsledok je po volaní bst_dump_tree v položke memory; uvoľní ho funkcia
+ * bst_dump_free.
+ */
+void bst_dump_init_memory(bst_dump_t *dump) {
+    dump_reset(dump, NULL);
+}
+
+/*
+ * Zápis obsahu vyrovnávacej pamäte do cieľa.
+ *
+ * Výpis do pamäte je po úspešnom volaní ukončený znakom '\0'. Funkcia vráti
+ * hodnotu false, ak niektorý zápis alebo alokácia zlyhali.
+ */
+bool bst_dump_flush(bst_dump_t *dump) {
+    if (dump->failed) {
+        dump->used = 0;
+        return false;
+    }
+
+    if (dump->file != NULL) {
+        if (dump->used > 0 &&
+            fwrite(dump->buffer, 1, dump->used, dump->file) != dump->used) {
+            dump->failed = true;
+        }
+    } else {
+        size_t needed = dump->length + dump->used + 1;
+        if (needed > dump->capacity) {
+            size_t capacity = dump->capacity > 0 ? dump->capacity : 256;
+            while (capacity < needed) capacity *= 2;
+            char *memory = realloc(dump->memory, capacity);
+            if (memory == NULL) {
+                dump->failed = true;
+                dump->used = 0;
+                return false;
+            }
+            dump->memory = memory;
+            dump->capacity = capacity;
+        }
+        memcpy(dump->memory + dump->length, dump->buffer, dump->used);
+        dump->length += dump->used;
+        dump->memory[dump->length] = '\0';
+    }
+
+    dump->used = 0;
+    return !dump->failed;
+}
+
+/*
+ * Uvoľnenie výpisu v pamäti. Súbor výpisu sa nezatvára.
+ */
+void bst_dump_free(bst_dump_t *dump) {
+    free(dump->memory);
+    dump_reset(dump, dump->file);
+}
+
+static void dump_write(bst_dump_t *dump, const char *data, size_t length) {
+    while (length > 0) {
+        if (dump->used == BST_DUMP_BUFFER_SIZE) bst_dump_flush(dump);
+        size_t chunk = BST_DUMP_BUFFER_SIZE - dump->used;
+        if (chunk > length) chunk = length;
+        memcpy(dump->buffer + dump->used, data, chunk);
+        dump->used += chunk;
+        data += chunk;
+        length -= chunk;
+    }
+}
+
+static void dump_string(bst_dump_t *dump, const char *string) {
+    dump_write(dump, string, strlen(string));
+}
+
+static void dump_char(bst_dump_t *dump, char c) {
+    dump_write(dump, &c, 1);
+}
+
+static void dump_number(bst_dump_t *dump, long number) {
+    char digits[24];
+    int length = 0;
+    unsigned long magnitude =
+        number < 0 ? 0ul - (unsigned long)number : (unsigned long)number;
+
+    do {
+        digits[sizeof(digits) - 1 - length++] = (char)('0' + magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude > 0);
+    if (number < 0) digits[sizeof(digits) - 1 - length++] = '-';
+
+    dump_write(dump, digits + sizeof(digits) - length, length);
+}
+
+/*
+ * Kľúč v úvodzovkách. Tlačiteľné znaky ASCII sa zapíšu priamo, ostatné
+ * ako \u00XX (JSON) alebo \\xXX (DOT).
+ */
+static void dump_quoted_key(bst_dump_t *dump, char key, bool json) {
+    static const char hex[] = "0123456789ABCDEF";
+    unsigned char byte = (unsigned char)key;
+
+    dump_char(dump, '"');
+    if (byte == '"' || byte == '\\') {
+        dump_char(dump, '\\');
+        dump_char(dump, key);
+    } else if (byte >= 0x20 && byte < 0x7F) {
+        dump_char(dump, key);
+    } else {
+        dump_string(dump, json ? "\\u00" : "\\\\x");
+        dump_char(dump, hex[byte >> 4]);
+        dump_char(dump, hex[byte & 0xF]);
+    }
+    dump_char(dump, '"');
+}
+
+static bool dump_push(dump_walk_t *walk, bst_node_t *node, dump_from_t from,
+                      size_t prefix) {
+    if (walk->top == walk->capacity) {
+        size_t capacity = walk->capacity > 0 ? walk->capacity * 2 : 64;
+        dump_frame_t *frames =
+            realloc(walk->frames, capacity * sizeof(dump_frame_t));
+        if (frames == NULL) return false;
+        walk->frames = frames;
+        walk->capacity = capacity;
+    }
+    walk->frames[walk->top++] = (dump_frame_t){node, from, 0, prefix, 0};
+    return true;
+}
+
+/*
+ * Vloženie potomka textového výpisu spolu s jeho predponou.
+ */
+static bool dump_push_text(dump_walk_t *walk, bst_node_t *node,
+                           dump_from_t from, size_t prefix, bool subtree) {
+    size_t needed = prefix + DUMP_SEGMENT_LENGTH;
+    if (needed > walk->prefix_capacity) {
+        size_t capacity =
+            walk->prefix_capacity > 0 ? walk->prefix_capacity * 2 : 192;
+        while (capacity < needed) capacity *= 2;
+        char *buffer = realloc(walk->prefix, capacity);
+        if (buffer == NULL) return false;
+        walk->prefix = buffer;
+        walk->prefix_capacity = capacity;
+    }
+    memcpy(walk->prefix + prefix,
+           subtree ? dump_subtree_segment : dump_space_segment,
+           DUMP_SEGMENT_LENGTH);
+    return dump_push(walk, node, from, needed);
+}
+
+/*
+ * Textový diagram totožný s výstupom bst_print_tree: pravý podstrom nad
+ * uzlom, ľavý pod ním.
+ */
+static bool dump_text(dump_walk_t *walk) {
+    bst_dump_t *dump = walk->dump;
+
+    while (walk->top > 0) {
+        dump_frame_t *frame = &walk->frames[walk->top - 1];
+        bst_node_t *node = frame->node;
+        dump_from_t from = frame->from;
+        size_t prefix = frame->prefix;
+
+        switch (frame->state++) {
+        case 0:
+            if (from == DUMP_LEFT) {
+                dump_write(dump, walk->prefix, prefix);
+                dump_string(dump, "  |\n");
+            }
+            if (node->right != NULL &&
+                !dump_push_text(walk, node->right, DUMP_RIGHT, prefix,
+                                from == DUMP_LEFT)) {
+                return false;
+            }
+            break;
+        case 1:
+            dump_write(dump, walk->prefix, prefix);
+            dump_string(dump, "  +-[");
+            dump_char(dump, node->key);
+            dump_char(dump, ',');
+            dump_number(dump, node->value);
+            dump_string(dump, "]\n");
+            if (node->left != NULL &&
+                !dump_push_text(walk, node->left, DUMP_LEFT, prefix,
+                                from == DUMP_RIGHT)) {
+                return false;
+            }
+            break;
+        default:
+            if (from == DUMP_RIGHT) {
+                dump_write(dump, walk->prefix, prefix);
+                dump_string(dump, "  |\n");
+            }
+            walk->top--;
+            break;
+        }
+    }
+    return true;
+}
+
+/*
+ * Vnorené objekty {"key": ..., "value": ..., "left": ..., "right": ...},
+ * chýbajúci potomok je null.
+ */
+static bool dump_json(dump_walk_t *walk) {
+    bst_dump_t *dump = walk->dump;
+
+    while (walk->top > 0) {
+        dump_frame_t *frame = &walk->frames[walk->top - 1];
+        bst_node_t *node = frame->node;
+
+        switch (frame->state++) {
+        case 0:
+            dump_string(dump, "{\"key\":");
+            dump_quoted_key(dump, node->key, true);
+            dump_string(dump, ",\"value\":");
+            dump_number(dump, node->value);
+            dump_string(dump, ",\"left\":");
+            if (node->left == NULL) {
+                dump_string(dump, "null");
+            } else if (!dump_push(walk, node->left, DUMP_LEFT, 0)) {
+                return false;
+            }
+            break;
+        case 1:
+            dump_string(dump, ",\"right\":");
+            if (node->right == NULL) {
+                dump_string(dump, "null");
+            } else if (!dump_push(walk, node->right, DUMP_RIGHT, 0)) {
+                return false;
+            }
+            break;
+        default:
+            dump_char(dump, '}');
+            walk->top--;
+            break;
+        }
+    }
+    return true;
+}
+
+/*
+ * Graf pre Graphviz. Uzly sú očíslované v poradí preorder, hrany nesú
+ * označenie L alebo R.
+ */
+static bool dump_dot(dump_walk_t *walk) {
+    bst_dump_t *dump = walk->dump;
+    unsigned long next_id = 0;
+
+    while (walk->top > 0) {
+        dump_frame_t *frame = &walk->frames[walk->top - 1];
+        bst_node_t *node = frame->node;
+
+        switch (frame->state++) {
+        case 0:
+            frame->id = next_id++;
+            dump_string(dump, "  n");
+            dump_number(dump, (long)frame->id);
+            dump_string(dump, " [label=");
+            dump_quoted_key(dump, node->key, false);
+            dump_string(dump, ", xlabel=\"");
+            dump_number(dump, node->value);
+            dump_string(dump, "\"];\n");
+            if (frame->from != DUMP_ROOT) {
+                dump_string(dump, "  n");
+                dump_number(dump, (long)walk->frames[walk->top - 2].id);
+                dump_string(dump, " -> n");
+                dump_number(dump, (long)frame->id);
+                dump_string(dump, frame->from == DUMP_LEFT
+                                      ? " [label=\"L\"];\n"
+                                      : " [label=\"R\"];\n");
+            }
+            if (node->left != NULL &&
+                !dump_push(walk, node->left, DUMP_LEFT, 0)) {
+                return false;
+            }
+            break;
+        case 1:
+            if (node->right != NULL &&
+                !dump_push(walk, node->right, DUMP_RIGHT, 0)) {
+                return false;
+            }
+            break;
+        default:
+            walk->top--;
+            break;
+        }
+    }
+    return true;
+}
+
+/*
+ * Výpis stromu v zadanom formáte.
+ *
+ * Textový výpis prázdneho stromu je prázdny, JSON je null a DOT prázdny graf.
+ * Na konci sa vyrovnávacia pamäť vyprázdni do cieľa. V prípade úspechu vráti
+ * funkcia hodnotu true, pri chybe zápisu alebo nedostatku pamäte hodnotu
+ * false (výpis môže byť neúplný).
+ */
+bool bst_dump_tree(bst_dump_t *dump, bst_node_t *tree,
+                   bst_dump_format_t format) {
+    dump_walk_t walk = {.dump = dump};
+    bool ok = tree == NULL || dump_push(&walk, tree, DUMP_ROOT, 0);
+
+    switch (format) {
+    case BST_DUMP_TEXT:
+        ok = ok && dump_text(&walk);
+        break;
+    case BST_DUMP_JSON:
+        if (tree == NULL) dump_string(dump, "null");
+        ok = ok && dump_json(&walk);
+        dump_char(dump, '\n');
+        break;
+    case BST_DUMP_DOT:
+        dump_string(dump, "digraph bst {\n");
+        ok = ok && dump_dot(&walk);
+        dump_string(dump, "}\n");
+        break;
+    }
+
+    free(walk.prefix);
+    free(walk.frames);
+    if (!ok) dump->failed = true;
+    return bst_dump_flush(dump);
+}
@@ -0,0 +1,45 @@
+/*
+ * Hlavičkový súbor pre výpis binárneho vyhľadávacieho stromu.
+ *
+ * Výpis prechádza strom bez rekurzie, pre odsadenie používa jediný
+ * opakovane použitý buffer a zapisuje cez vlastnú vyrovnávaciu pamäť do
+ * súboru alebo do pamäte. Zvláda tak aj stromy s miliónmi uzlov.
+ */
+
+#ifndef IAL_BTREE_DUMP_H
+#define IAL_BTREE_DUMP_H
+
+#include "btree.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+
+// Veľkosť vyrovnávacej pamäte výpisu
+#define BST_DUMP_BUFFER_SIZE 8192
+
+// Formát výpisu
+typedef enum bst_dump_format {
+  BST_DUMP_TEXT, // textový diagram ako bst_print_tree
+  BST_DUMP_JSON, // vnorené objekty {"key", "value", "left", "right"}
+  BST_DUMP_DOT   // graf pre Graphviz
+} bst_dump_format_t;
+
+// Výstup výpisu
+typedef struct bst_dump {
+  FILE *file;       // cieľový súbor alebo NULL pre výpis do pamäte
+  char *memory;     // výpis v pamäti ukončený znakom '\0' (pri file == NULL)
+  size_t length;    // dĺžka výpisu v pamäti
+  size_t capacity;  // veľkosť alokovanej pamäte
+  bool failed;      // nastala chyba zápisu alebo alokácie
+  size_t used;      // obsadená časť vyrovnávacej pamäte
+  char buffer[BST_DUMP_BUFFER_SIZE];
+} bst_dump_t;
+
+void bst_dump_init_file(bst_dump_t *dump, FILE *file);
+void bst_dump_init_memory(bst_dump_t *dump);
+bool bst_dump_tree(bst_dump_t *dump, bst_node_t *tree,
+                   bst_dump_format_t format);
+bool bst_dump_flush(bst_dump_t *dump);
+void bst_dump_free(bst_dump_t *dump);
+
+#endif
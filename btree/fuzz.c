@@ -0,0 +1,233 @@
+/*
+ * Diferenciálny test binárneho vyhľadávacieho stromu s náhodnými operáciami.
+ *
+ * Spustenie: ./fuzz [semienko] [počet operácií]
+ *
+ * Program vykonáva náhodnú postupnosť operácií bst_insert, bst_search,
+ * bst_delete a bst_dispose nad stromom a rovnaké operácie nad referenčným
+ * modelom (poľom všetkých 256 kľúčov). Každý výsledok porovná s modelom a po
+ * každej operácii overí štatistiky: hľadanie nenavštívi viac uzlov, než je
+ * výška stromu, vloženie existujúceho kľúča nealokuje a zmazanie chýbajúceho
+ * kľúča neuvoľňuje. Pravidelne a na konci kola prejde celý strom a overí
+ * usporiadanie kľúčov, zhodu s modelom, počet živých uzlov (únik pamäte)
+ * a spotrebu pamäte podľa memory.h.
+ *
+ * Kľúče sa vyberajú striedavo rovnomerne, vzostupne a zostupne, takže strom
+ * sa dostáva aj do degenerovaného tvaru. Pri prvej chybe program vypíše
+ * semienko a číslo operácie a skončí s kódom 1. Na konci vypíše kontrolný
+ * súčet všetkých výsledkov, ktorý je pre rec aj iter rovnaký.
+ *
+ * Počet živých uzlov sa kontroluje podľa štatistík. Skutočné úniky a chyby
+ * prístupu do pamäte odhalí preklad s make fuzz SANITIZE=1.
+ */
+
+#ifndef IAL_STATS
+#error "fuzz sa prekladá s -DIAL_STATS (make fuzz)"
+#endif
+
+#include "btree.h"
+#include "memory.h"
+#include "stats.h"
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define FUZZ_KEYS (UCHAR_MAX + 1)
+#define FUZZ_ROUND 4096       // počet operácií medzi úplnými kontrolami
+#define FUZZ_DISPOSE_ROUNDS 8 // strom sa zruší priemerne raz za toľko kôl
+
+typedef struct fuzz_model {
+    bool present[FUZZ_KEYS];
+    int values[FUZZ_KEYS];
+    int size;
+} fuzz_model_t;
+
+static unsigned long fuzz_seed;
+static unsigned long fuzz_operation;
+static unsigned long fuzz_checksum = 14695981039346656037ul;
+
+static unsigned long fuzz_random(void) {
+    fuzz_seed = fuzz_seed * 6364136223846793005ul + 1442695040888963407ul;
+    return fuzz_seed >> 33;
+}
+
+static void fuzz_mix(unsigned long value) {
+    fuzz_checksum = (fuzz_checksum ^ value) * 1099511628211ul;
+}
+
+static void fuzz_fail(unsigned long seed, const char *message) {
+    fprintf(stderr, "FAIL seed=%lu operation=%lu: %s\n", seed, fuzz_operation,
+            message);
+    exit(1);
+}
+
+/*
+ * Výška stromu (počet uzlov na najdlhšej ceste), bez rekurzie.
+ */
+static int fuzz_height(bst_node_t *tree) {
+    bst_node_t *nodes[FUZZ_KEYS];
+    int depths[FUZZ_KEYS];
+    int top = 0;
+    int height = 0;
+    if (tree != NULL) {
+        nodes[top] = tree;
+        depths[top++] = 1;
+    }
+    while (top > 0) {
+        bst_node_t *node = nodes[--top];
+        int depth = depths[top];
+        if (depth > height) height = depth;
+        if (node->left != NULL) {
+            nodes[top] = node->left;
+            depths[top++] = depth + 1;
+        }
+        if (node->right != NULL) {
+            nodes[top] = node->right;
+            depths[top++] = depth + 1;
+        }
+    }
+    return height;
+}
+
+/*
+ * Úplná kontrola stromu: vzostupné poradie kľúčov v inorder prechode,
+ * zhoda s modelom a počet živých uzlov podľa štatistík.
+ */
+static void fuzz_verify(unsigned long seed, bst_node_t *tree,
+                        fuzz_model_t *model) {
+    bst_node_t *stack[FUZZ_KEYS];
+    int top = 0;
+    int previous = INT_MIN;
+    int count = 0;
+
+    bst_node_t *node = tree;
+    while (node != NULL || top > 0) {
+        while (node != NULL) {
+            if (top == FUZZ_KEYS) fuzz_fail(seed, "tree has a cycle");
+            stack[top++] = node;
+            node = node->left;
+        }
+        node = stack[--top];
+        if (node->key <= previous) fuzz_fail(seed, "keys out of order");
+        int index = node->key - CHAR_MIN;
+        if (!model->present[index] || model->values[index] != node->value) {
+            fuzz_fail(seed, "node does not match the model");
+        }
+        previous = node->key;
+        count++;
+        node = node->right;
+    }
+
+    if (count != model->size) fuzz_fail(seed, "node count differs");
+    if (bst_stats.allocations - bst_stats.frees != (unsigned long)count) {
+        fuzz_fail(seed, "live node count differs (leak or double free)");
+    }
+
+    bst_memory_t usage;
+    bst_memory_usage(NULL, &usage);
+    if (usage.nodes != (size_t)count * sizeof(bst_node_t)) {
+        fuzz_fail(seed, "memory usage does not match the node count");
+    }
+}
+
+/*
+ * Index ďalšieho kľúča podľa režimu kola: rovnomerne, vzostupne
+ * alebo zostupne.
+ */
+static int fuzz_key(int mode, int *cursor) {
+    switch (mode) {
+    case 1:
+        return (*cursor)++ & UCHAR_MAX;
+    case 2:
+        return (*cursor)-- & UCHAR_MAX;
+    default:
+        return (int)(fuzz_random() % FUZZ_KEYS);
+    }
+}
+
+static void fuzz_run(unsigned long seed, unsigned long operations) {
+    bst_node_t *tree;
+    fuzz_model_t model = {{false}, {0}, 0};
+    int mode = 0;
+    int cursor = 0;
+    int height = 0;
+
+    fuzz_seed = seed;
+    bst_stats_reset();
+    bst_init(&tree);
+
+    for (fuzz_operation = 0; fuzz_operation < operations; fuzz_operation++) {
+        if (fuzz_operation % FUZZ_ROUND == 0) {
+            fuzz_verify(seed, tree, &model);
+            if (fuzz_random() % FUZZ_DISPOSE_ROUNDS == 0) {
+                bst_dispose(&tree);
+                if (tree != NULL) fuzz_fail(seed, "dispose left a root");
+                model = (fuzz_model_t){{false}, {0}, 0};
+                fuzz_verify(seed, tree, &model);
+            }
+            mode = (int)(fuzz_random() % 3);
+            cursor = (int)(fuzz_random() % FUZZ_KEYS);
+            height = fuzz_height(tree);
+        }
+
+        int index = fuzz_key(mode, &cursor);
+        char key = (char)(index + CHAR_MIN);
+        unsigned long allocations = bst_stats.allocations;
+        unsigned long frees = bst_stats.frees;
+        unsigned long depth = bst_stats.depth;
+        unsigned long choice = fuzz_random() % 8;
+
+        if (choice < 3) {
+            int value = (int)fuzz_random();
+            bst_insert(&tree, key, value);
+            if (model.present[index] != (bst_stats.allocations == allocations)) {
+                fuzz_fail(seed, "insert allocated a wrong number of nodes");
+            }
+            if (!model.present[index]) {
+                model.present[index] = true;
+                model.size++;
+                height = fuzz_height(tree);
+            }
+            model.values[index] = value;
+        } else if (choice < 5) {
+            bst_delete(&tree, key);
+            if (model.present[index] != (bst_stats.frees == frees + 1) ||
+                bst_stats.frees > frees + 1) {
+                fuzz_fail(seed, "delete freed a wrong number of nodes");
+            }
+            if (model.present[index]) {
+                model.present[index] = false;
+                model.size--;
+                height = fuzz_height(tree);
+            }
+        } else {
+            int value = 0;
+            bool found = bst_search(tree, key, &value);
+            if (found != model.present[index] ||
+                (found && value != model.values[index])) {
+                fuzz_fail(seed, "search differs from the model");
+            }
+            if (bst_stats.depth - depth > (unsigned long)height) {
+                fuzz_fail(seed, "search visited more nodes than the height");
+            }
+            fuzz_mix(found ? (unsigned long)value : 1ul);
+        }
+    }
+
+    fuzz_verify(seed, tree, &model);
+    bst_dispose(&tree);
+    if (bst_stats.allocations != bst_stats.frees) {
+        fuzz_fail(seed, "nodes leaked after dispose");
+    }
+}
+
+int main(int argc, char *argv[]) {
+    unsigned long seed = argc > 1 ? strtoul(argv[1], NULL, 10) : 1;
+    unsigned long operations = argc > 2 ? strtoul(argv[2], NULL, 10) : 1000000;
+
+    fuzz_run(seed, operations);
+    printf("Seed: %lu\n", seed);
+    printf("Operations: %lu\n", operations);
+    printf("Checksum: %016lx\n", fuzz_checksum);
+    return 0;
+}
@@ -4,13 +4,99 @@
  * S využitím dátových typov zo súboru btree.h, zásobníkov zo súborov stack.h a
  * stack.c a pripravených kostier funkcií implementujte binárny vyhľadávací
  * strom bez použitia rekurzie.
+ *
+ * Zásobníky zo stack.h pojmú najviac MAXSTACK uzlov. Strom hlbší ako
+ * MAXSTACK (napríklad degenerovaný strom zo zoradených kľúčov) prechody
+ * spracujú iteratívne s rámcami v lokálnom poli; kľúče sú typu char, strom
+ * má preto najviac UCHAR_MAX + 1 úrovní.
  */
 
 #include "../btree.h"
+#include "../memory.h"
+#include "../stats.h"
 #include "stack.h"
+#include <limits.h>
 #include <stdio.h>
 #include <stdlib.h>
 
+// Najväčšia možná hĺbka stromu s kľúčmi typu char
+#define ITER_MAX_DEPTH (UCHAR_MAX + 1)
+
+// Spracovanie uzlu pri prechode hlbokého stromu
+typedef enum iter_order {
+    ITER_PREORDER,
+    ITER_INORDER,
+    ITER_POSTORDER
+} iter_order_t;
+
+// Rámec prechodu hlbokého stromu: uzol a počet už spracovaných potomkov
+typedef struct iter_frame {
+    bst_node_t *node;
+    int visited;
+} iter_frame_t;
+
+/*
+ * Zistenie, či má strom viac ako MAXSTACK úrovní. Prehľadávanie skončí pri
+ * prvom uzle v hĺbke MAXSTACK + 1; na každej úrovni čaká najviac jeden
+ * pravý potomok, pole preto stačí s MAXSTACK + 1 prvkami.
+ */
+static bool iter_deeper_than_stack(bst_node_t *tree) {
+    bst_node_t *nodes[MAXSTACK + 1];
+    int depths[MAXSTACK + 1];
+    int top = 0;
+
+    if (tree == NULL) return false;
+    nodes[top] = tree;
+    depths[top++] = 1;
+    while (top > 0) {
+        top--;
+        bst_node_t *node = nodes[top];
+        int depth = depths[top];
+        if (depth > MAXSTACK) return true;
+
+        if (node->right != NULL) {
+            nodes[top] = node->right;
+            depths[top++] = depth + 1;
+        }
+        if (node->left != NULL) {
+            nodes[top] = node->left;
+            depths[top++] = depth + 1;
+        }
+    }
+    return false;
+}
+
+/*
+ * Prechod stromom hlbším ako MAXSTACK s rámcami v lokálnom poli.
+ */
+static void iter_walk(bst_node_t *tree, iter_order_t order) {
+    iter_frame_t stack[ITER_MAX_DEPTH];
+    int top = 0;
+
+    stack[top++] = (iter_frame_t){tree, 0};
+    BST_STAT(bst_stats_stack(top);)
+    while (top > 0) {
+        iter_frame_t *frame = &stack[top - 1];
+        bst_node_t *node = frame->node;
+        if ((order == ITER_PREORDER && frame->visited == 0) ||
+            (order == ITER_INORDER && frame->visited == 1) ||
+            (order == ITER_POSTORDER && frame->visited == 2)) {
+            bst_print_node(node);
+        }
+        if (frame->visited == 2) {
+            top--;
+            continue;
+        }
+
+        bst_node_t *child = frame->visited == 0 ? node->left : node->right;
+        frame->visited++;
+        if (child != NULL) {
+            stack[top++] = (iter_frame_t){child, 0};
+            BST_STAT(bst_stats_stack(top);)
+        }
+    }
+}
+
 /*
  * Inicializácia stromu.
  *
@@ -18,13 +104,12 @@
  * inicializovaným stromom. V opačnom prípade môže dôjsť k úniku pamäte (memory
  * leak). Keďže neinicializovaný ukazovateľ má nedefinovanú hodnotu, nie je
  * možné toto detegovať vo funkcii.
+ *
+ * Prázdny strom je reprezentovaný hodnotou NULL, inicializácia nič
+ * nealokuje.
  */
 void bst_init(bst_node_t **tree) {
-//    if(tree == NULL) return;
-
-    *tree = malloc(sizeof(bst_node_t));
-    (*tree)->left = NULL;
-    (*tree)->right = NULL;
+    *tree = NULL;
 }
 
 /*
@@ -37,9 +122,12 @@ void bst_init(bst_node_t **tree) {
  * Funkciu implementujte iteratívne bez použitia vlastných pomocných funkcií.
  */
 bool bst_search(bst_node_t *tree, char key, int *value) {
+    BST_STAT(unsigned depth = 0;)
     while (tree != NULL) {
+        BST_STAT(depth++;)
         if (tree->key == key) {
             *value = tree->value;
+            BST_STAT(bst_stats_search(depth);)
             return true;
         }
 
@@ -50,6 +138,7 @@ bool bst_search(bst_node_t *tree, char key, int *value) {
         }
     }
 
+    BST_STAT(bst_stats_search(depth);)
     return false;
 }
 
@@ -65,41 +154,27 @@ bool bst_search(bst_node_t *tree, char key, int *value) {
  * Funkciu implementujte iteratívne bez použitia vlastných pomocných funkcií.
  */
 void bst_insert(bst_node_t **tree, char key, int value) {
-    bst_node_t *new_node = malloc(sizeof(bst_node_t));
-    new_node->key = key;
-    new_node->value = value;
-    new_node->left = NULL;
-    new_node->right = NULL;
-
-    if (*tree == NULL) {
-        *tree = new_node;
-        return;
-    }
-
-    bst_node_t *current = *tree;
-    bst_node_t *parent = NULL;
-
-    while (current != NULL) {
-        parent = current;
-
-        if (current->key == key) {
-            current->value = value;
-            free(new_node);
+    while (*tree != NULL) {
+        if ((*tree)->key == key) {
+            (*tree)->value = value;
             return;
         }
 
-        if (current->key > key) {
-            current = current->left;
+        if ((*tree)->key > key) {
+            tree = &(*tree)->left;
         } else {
-            current = current->right;
+            tree = &(*tree)->right;
         }
     }
 
-    if (parent->key > key) {
-        parent->left = new_node;
-    } else {
-        parent->right = new_node;
-    }
+    bst_node_t *new_node = bst_node_allocate();
+    if (new_node == NULL) return;
+    BST_STAT(bst_stats.allocations++;)
+    new_node->key = key;
+    new_node->value = value;
+    new_node->left = NULL;
+    new_node->right = NULL;
+    *tree = new_node;
 }
 
 /*
@@ -133,7 +208,8 @@ void bst_replace_by_rightmost(bst_node_t *target, bst_node_t **tree) {
         parent->right = current->left;
     }
 
-    free(current);
+    bst_node_release(current);
+    BST_STAT(bst_stats.frees++;)
 }
 
 /*
@@ -165,7 +241,8 @@ void bst_delete(bst_node_t **tree, char key) {
                     }
                 }
 
-                free(current);
+                bst_node_release(current);
+                BST_STAT(bst_stats.frees++;)
             } else if (current->left == NULL) {
                 if (parent == NULL) {
                     *tree = current->right;
@@ -177,7 +254,8 @@ void bst_delete(bst_node_t **tree, char key) {
                     }
                 }
 
-                free(current);
+                bst_node_release(current);
+                BST_STAT(bst_stats.frees++;)
             } else if (current->right == NULL) {
                 if (parent == NULL) {
                     *tree = current->left;
@@ -189,7 +267,8 @@ void bst_delete(bst_node_t **tree, char key) {
                     }
                 }
 
-                free(current);
+                bst_node_release(current);
+                BST_STAT(bst_stats.frees++;)
             } else {
                 bst_replace_by_rightmost(current, &current->left);
             }
@@ -244,7 +323,8 @@ void bst_dispose(bst_node_t **tree) {
             }
         }
 
-        free(current);
+        bst_node_release(current);
+        BST_STAT(bst_stats.frees++;)
     }
 }
 
@@ -263,6 +343,7 @@ void bst_leftmost_preorder(bst_node_t *tree, stack_bst_t *to_visit) {
     while (current != NULL) {
         bst_print_node(current);
         stack_bst_push(to_visit, current);
+        BST_STAT(bst_stats_stack(to_visit->top + 1);)
         current = current->left;
     }
 }
@@ -274,8 +355,15 @@ void bst_leftmost_preorder(bst_node_t *tree, stack_bst_t *to_visit) {
  *
  * Funkciu implementujte iteratívne pomocou funkcie bst_leftmost_preorder a
  * zásobníku uzlov bez použitia vlastných pomocných funkcií.
+ *
+ * Strom hlbší ako MAXSTACK, ktorý by zásobníky nepojali, prejde iter_walk.
  */
 void bst_preorder(bst_node_t *tree) {
+    if (iter_deeper_than_stack(tree)) {
+        iter_walk(tree, ITER_PREORDER);
+        return;
+    }
+
     stack_bst_t to_visit;
     stack_bst_init(&to_visit);
 
@@ -303,6 +391,7 @@ void bst_leftmost_inorder(bst_node_t *tree, stack_bst_t *to_visit) {
 
     while (current != NULL) {
         stack_bst_push(to_visit, current);
+        BST_STAT(bst_stats_stack(to_visit->top + 1);)
         current = current->left;
     }
 }
@@ -314,8 +403,15 @@ void bst_leftmost_inorder(bst_node_t *tree, stack_bst_t *to_visit) {
  *
  * Funkciu implementujte iteratívne pomocou funkcie bst_leftmost_inorder a
  * zásobníku uzlov bez použitia vlastných pomocných funkcií.
+ *
+ * Strom hlbší ako MAXSTACK, ktorý by zásobníky nepojali, prejde iter_walk.
  */
 void bst_inorder(bst_node_t *tree) {
+    if (iter_deeper_than_stack(tree)) {
+        iter_walk(tree, ITER_INORDER);
+        return;
+    }
+
     stack_bst_t to_visit;
     stack_bst_init(&to_visit);
 
@@ -347,6 +443,7 @@ void bst_leftmost_postorder(bst_node_t *tree, stack_bst_t *to_visit,
     while (current != NULL) {
         stack_bst_push(to_visit, current);
         stack_bool_push(first_visit, true);
+        BST_STAT(bst_stats_stack(to_visit->top + 1);)
         current = current->left;
     }
 }
@@ -358,8 +455,15 @@ void bst_leftmost_postorder(bst_node_t *tree, stack_bst_t *to_visit,
  *
  * Funkciu implementujte iteratívne pomocou funkcie bst_leftmost_postorder a
  * zásobníkov uzlov a bool hodnôt bez použitia vlastných pomocných funkcií.
+ *
+ * Strom hlbší ako MAXSTACK, ktorý by zásobníky nepojali, prejde iter_walk.
  */
 void bst_postorder(bst_node_t *tree) {
+    if (iter_deeper_than_stack(tree)) {
+        iter_walk(tree, ITER_POSTORDER);
+        return;
+    }
+
     stack_bst_t to_visit;
     stack_bst_init(&to_visit);
 
@@ -378,6 +482,7 @@ void bst_postorder(bst_node_t *tree) {
         if (first) {
             stack_bst_push(&to_visit, current);
             stack_bool_push(&first_visit, false);
+            BST_STAT(bst_stats_stack(to_visit.top + 1);)
             bst_leftmost_postorder(current->right, &to_visit, &first_visit);
         } else {
             bst_print_node(current);
@@ -0,0 +1,130 @@
+/*
+ * Alokátor a spotreba pamäte binárneho vyhľadávacieho stromu
+ *
+ * Réžiu predvoleného alokátora odhaduje rovnaký model ako v tabuľke
+ * s rozptýlenými položkami: hlavička veľkosti size_t, zarovnanie na
+ * dvojnásobok size_t a najmenší blok so štyrmi size_t.
+ */
+
+#include "memory.h"
+#include <limits.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+
+#define MEMORY_HEADER sizeof(size_t)
+#define MEMORY_ALIGN (2 * sizeof(size_t))
+#define MEMORY_MIN_BLOCK (4 * sizeof(size_t))
+
+static void *memory_malloc(size_t size, void *context) {
+    return malloc(size);
+}
+
+static void memory_free(void *pointer, size_t size, void *context) {
+    free(pointer);
+}
+
+static size_t memory_malloc_reserved(size_t size, void *context) {
+    size_t block = (size + MEMORY_HEADER + MEMORY_ALIGN - 1) &
+                   ~(MEMORY_ALIGN - 1);
+    return (block < MEMORY_MIN_BLOCK ? MEMORY_MIN_BLOCK : block) - MEMORY_HEADER;
+}
+
+static const bst_allocator_t memory_default = {
+    memory_malloc, memory_free, memory_malloc_reserved, NULL};
+
+static bst_allocator_t memory_allocator = {
+    memory_malloc, memory_free, memory_malloc_reserved, NULL};
+
+// Priebežne udržiavaná spotreba všetkých stromov
+static atomic_size_t memory_nodes;
+static atomic_size_t memory_slack_total;
+static atomic_ulong memory_rejections;
+
+/*
+ * Nastavenie alokátora uzlov, NULL obnoví predvolený alokátor.
+ *
+ * Alokátor sa smie zmeniť iba vtedy, keď žiadny strom nemá uzly, inak by sa
+ * uzly uvoľňovali iným alokátorom, než ktorým vznikli.
+ */
+void bst_set_allocator(const bst_allocator_t *allocator) {
+    memory_allocator = allocator != NULL ? *allocator : memory_default;
+}
+
+// Réžia alokátora na jeden uzol
+static size_t memory_slack(void) {
+    if (memory_allocator.reserved == NULL) return 0;
+    return memory_allocator.reserved(sizeof(bst_node_t),
+                                     memory_allocator.context) -
+           sizeof(bst_node_t);
+}
+
+/*
+ * Alokácia uzlu nastaveným alokátorom.
+ *
+ * V prípade úspechu vráti funkcia ukazovateľ na neinicializovaný uzol
+ * a započíta ho do spotreby, v opačnom prípade vráti hodnotu NULL.
+ */
+bst_node_t *bst_node_allocate(void) {
+    bst_node_t *node =
+        memory_allocator.allocate(sizeof(bst_node_t), memory_allocator.context);
+    if (node == NULL) {
+        atomic_fetch_add_explicit(&memory_rejections, 1, memory_order_relaxed);
+        return NULL;
+    }
+    atomic_fetch_add_explicit(&memory_nodes, sizeof(bst_node_t),
+                              memory_order_relaxed);
+    atomic_fetch_add_explicit(&memory_slack_total, memory_slack(),
+                              memory_order_relaxed);
+    return node;
+}
+
+/*
+ * Uvoľnenie uzlu alokovaného funkciou bst_node_allocate.
+ */
+void bst_node_release(bst_node_t *node) {
+    atomic_fetch_sub_explicit(&memory_nodes, sizeof(bst_node_t),
+                              memory_order_relaxed);
+    atomic_fetch_sub_explicit(&memory_slack_total, memory_slack(),
+                              memory_order_relaxed);
+    memory_allocator.release(node, sizeof(bst_node_t), memory_allocator.context);
+}
+
+// Počet uzlov stromu; kľúče typu char obmedzujú hĺbku na UCHAR_MAX + 1
+static size_t memory_count(bst_node_t *tree) {
+    bst_node_t *stack[UCHAR_MAX + 1];
+    size_t top = 0, count = 0;
+
+    while (tree != NULL || top > 0) {
+        while (tree != NULL) {
+            stack[top++] = tree;
+            tree = tree->left;
+        }
+        tree = stack[--top];
+        count++;
+        tree = tree->right;
+    }
+    return count;
+}
+
+/*
+ * Spotreba pamäte uzlov stromu tree.
+ *
+ * Pre tree == NULL vráti funkcia priebežne udržiavaný súčet za všetky
+ * stromy vrátane odmietnutých alokácií. Inak spočíta uzly stromu prechodom
+ * (najviac UCHAR_MAX + 1 uzlov); odmietnutia sa stromom nepriraďujú.
+ */
+void bst_memory_usage(bst_node_t **tree, bst_memory_t *usage) {
+    *usage = (bst_memory_t){0};
+    if (tree == NULL) {
+        usage->nodes = atomic_load_explicit(&memory_nodes, memory_order_relaxed);
+        usage->slack =
+            atomic_load_explicit(&memory_slack_total, memory_order_relaxed);
+        usage->rejections =
+            atomic_load_explicit(&memory_rejections, memory_order_relaxed);
+    } else {
+        size_t count = memory_count(*tree);
+        usage->nodes = count * sizeof(bst_node_t);
+        usage->slack = count * memory_slack();
+    }
+    usage->total = usage->nodes + usage->slack;
+}
@@ -0,0 +1,55 @@
+/*
+ * Hlavičkový súbor pre alokátor a spotrebu pamäte binárneho vyhľadávacieho
+ * stromu.
+ *
+ * Uzly stromov (bst_insert, bst_delete, bst_dispose a množinové operácie
+ * zo set.h) sa alokujú cez nastaviteľný alokátor. Predvolený alokátor
+ * používa malloc a free. Vlastný alokátor môže alokáciu odmietnuť vrátením
+ * NULL; bst_insert potom strom nezmení a odmietnutie sa započíta.
+ *
+ * Súbežný strom z concurrent.h a perzistentný strom z persistent.h si uzly
+ * alokujú priamo funkciou malloc a do spotreby sa nezapočítavajú. Ich uzly
+ * sa uvoľňujú v ľubovoľnom vlákne (po skončení epochy, resp. pri uvoľnení
+ * posledného odkazu), na čo vlastný alokátor nie je pripravený, a
+ * kopírovanie cesty sa po odmietnutej alokácii nedá vrátiť.
+ *
+ * Súčet za všetky stromy sa udržiava priebežne v atomických počítadlách pri
+ * každej alokácii a uvoľnení, rôzne stromy je preto možné meniť z rôznych
+ * vlákien. Strom nemá miesto pre vlastné počítadlá a uzly medzi stromami
+ * presúvajú množinové operácie (set.h) aj bst_replace_by_rightmost, ktorá
+ * koreň stromu nepozná. Spotreba jedného stromu sa preto zistí prechodom
+ * jeho uzlov; kľúče sú typu char, takže strom má najviac UCHAR_MAX + 1
+ * uzlov a prechod je krátky. Kľúče sú súčasťou uzlov.
+ */
+
+#ifndef IAL_BTREE_MEMORY_H
+#define IAL_BTREE_MEMORY_H
+
+#include "btree.h"
+#include <stddef.h>
+
+// Alokátor uzlov
+typedef struct bst_allocator {
+  void *(*allocate)(size_t size, void *context); // NULL alokáciu odmietne
+  void (*release)(void *pointer, size_t size, void *context);
+  // Počet bajtov, ktoré alokácia size skutočne obsadí (môže byť NULL)
+  size_t (*reserved)(size_t size, void *context);
+  void *context;
+} bst_allocator_t;
+
+// Spotreba pamäte v bajtoch
+typedef struct bst_memory {
+  size_t nodes;             // uzly bst_node_t vrátane kľúčov a hodnôt
+  size_t slack;             // réžia alokátora nad veľkosťou uzlov
+  size_t total;             // súčet všetkých častí
+  unsigned long rejections; // počet odmietnutých alokácií (iba súčet)
+} bst_memory_t;
+
+void bst_set_allocator(const bst_allocator_t *allocator);
+
+bst_node_t *bst_node_allocate(void);
+void bst_node_release(bst_node_t *node);
+
+void bst_memory_usage(bst_node_t **tree, bst_memory_t *usage);
+
+#endif
@@ -0,0 +1,344 @@
+/*
+ * Paralelný prechod binárnym vyhľadávacím stromom
+ *
+ * Horná časť stromu (do hĺbky cutoff) sa rozloží na postupnosť úsekov
+ * v poradí inorder: uzly nad hranicou tvoria samostatné úseky, podstromy na
+ * hranici sa spracujú celé. Každé vlákno dostane súvislý rozsah úsekov; keď
+ * ho vyčerpá, ukradne polovicu zvyšného rozsahu inému vláknu. Čiastkové
+ * výsledky sa nakoniec spoja v poradí úsekov, preto stačí, aby bola funkcia
+ * reduce asociatívna.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "parallel.h"
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdlib.h>
+
+// Počet úsekov na jedno vlákno, ktorý ešte umožní vyvažovanie záťaže
+#define BST_PARALLEL_GRAIN 8
+
+typedef struct segment {
+    bst_node_t *node;
+    bool whole; // celý podstrom alebo iba samotný uzol
+} segment_t;
+
+typedef struct worker {
+    pthread_mutex_t lock;
+    int next; // ďalší úsek na spracovanie
+    int end;  // koniec rozsahu (nevrátane)
+} worker_t;
+
+typedef struct worker_arg {
+    bst_pool_t *pool;
+    int id;
+} worker_arg_t;
+
+// Stav prechodu zdieľaný vláknami skupiny
+typedef struct parallel_job {
+    bst_map_t map;
+    bst_reduce_t reduce;
+    long identity;
+    void *context;
+    int cutoff;
+    int threads;
+    segment_t *segments;
+    int segment_count;
+    long *results;
+    worker_t *workers;
+    worker_arg_t *args;
+} job_t;
+
+static void parallel_split(job_t *job, bst_node_t *node, int depth) {
+    if (node == NULL) return;
+
+    if (depth == job->cutoff) {
+        job->segments[job->segment_count++] = (segment_t){node, true};
+        return;
+    }
+
+    parallel_split(job, node->left, depth + 1);
+    job->segments[job->segment_count++] = (segment_t){node, false};
+    parallel_split(job, node->right, depth + 1);
+}
+
+/*
+ * Sekvenčné spracovanie podstromu v poradí inorder.
+ */
+static long parallel_subtree(job_t *job, bst_node_t *tree) {
+    size_t capacity = 64;
+    size_t top = 0;
+    bst_node_t **stack = malloc(capacity * sizeof(bst_node_t *));
+    if (stack == NULL) abort();
+    long result = job->identity;
+    bst_node_t *current = tree;
+
+    while (current != NULL || top > 0) {
+        while (current != NULL) {
+            if (top == capacity) {
+                capacity *= 2;
+                bst_node_t **grown =
+                    realloc(stack, capacity * sizeof(bst_node_t *));
+                if (grown == NULL) abort();
+                stack = grown;
+            }
+            stack[top++] = current;
+            current = current->left;
+        }
+
+        current = stack[--top];
+        result = job->reduce(result, job->map(current, job->context),
+                              job->context);
+        current = current->right;
+    }
+
+    free(stack);
+    return result;
+}
+
+static bool parallel_take(worker_t *worker, int *segment) {
+    bool taken = false;
+
+    pthread_mutex_lock(&worker->lock);
+    if (worker->next < worker->end) {
+        *segment = worker->next++;
+        taken = true;
+    }
+    pthread_mutex_unlock(&worker->lock);
+    return taken;
+}
+
+/*
+ * Ukradnutie horšej polovice rozsahu niektorého iného vlákna.
+ */
+static bool parallel_steal(job_t *job, int thief) {
+    for (int i = 1; i < job->threads; i++) {
+        worker_t *victim = &job->workers[(thief + i) % job->threads];
+        int start = 0, end = 0;
+
+        pthread_mutex_lock(&victim->lock);
+        if (victim->next < victim->end) {
+            start = victim->next + (victim->end - victim->next) / 2;
+            end = victim->end;
+            victim->end = start;
+        }
+        pthread_mutex_unlock(&victim->lock);
+
+        if (start < end) {
+            worker_t *own = &job->workers[thief];
+            pthread_mutex_lock(&own->lock);
+            own->next = start;
+            own->end = end;
+            pthread_mutex_unlock(&own->lock);
+            return true;
+        }
+    }
+    return false;
+}
+
+static void parallel_work(job_t *job, int id) {
+    int segment;
+
+    for (;;) {
+        if (!parallel_take(&job->workers[id], &segment)) {
+            if (!parallel_steal(job, id)) break;
+            continue;
+        }
+
+        segment_t *current = &job->segments[segment];
+        job->results[segment] =
+            current->whole ? parallel_subtree(job, current->node)
+                           : job->map(current->node, job->context);
+    }
+}
+
+/*
+ * Pomocné vlákno skupiny: čaká na ďalší prechod, spracuje ho a ohlási
+ * dokončenie.
+ */
+static void *parallel_thread(void *arg) {
+    worker_arg_t *worker = arg;
+    bst_pool_t *pool = worker->pool;
+    unsigned long seen = 0;
+
+    pthread_mutex_lock(&pool->lock);
+    for (;;) {
+        while (pool->generation == seen && !pool->stopping) {
+            pthread_cond_wait(&pool->work, &pool->lock);
+        }
+        if (pool->stopping) break;
+        seen = pool->generation;
+        pthread_mutex_unlock(&pool->lock);
+
+        parallel_work(pool->job, worker->id);
+
+        pthread_mutex_lock(&pool->lock);
+        if (--pool->pending == 0) pthread_cond_signal(&pool->done);
+    }
+    pthread_mutex_unlock(&pool->lock);
+    return NULL;
+}
+
+static void parallel_job_free(job_t *job) {
+    if (job == NULL) return;
+    free(job->args);
+    free(job->workers);
+    free(job->results);
+    free(job->segments);
+    free(job);
+}
+
+/*
+ * Vytvorenie skupiny threads vlákien (vrátane volajúceho).
+ *
+ * Pomocné polia prechodu sa alokujú raz, ich veľkosť závisí iba od počtu
+ * vlákien. Ak sa niektoré vlákno nepodarí spustiť, skupina pracuje s menším
+ * počtom vlákien. Vlákna si pamätajú adresu pool, skupinu preto po
+ * inicializácii nemožno presúvať. Pri nedostatku pamäte vráti funkcia
+ * hodnotu false.
+ */
+bool bst_pool_init(bst_pool_t *pool, int threads) {
+    *pool = (bst_pool_t){.threads = threads > 0 ? threads : 1, .started = 1};
+
+    job_t *job = calloc(1, sizeof(job_t));
+    if (job == NULL) return false;
+    job->threads = pool->threads;
+    while ((1 << job->cutoff) < job->threads * BST_PARALLEL_GRAIN) {
+        job->cutoff++;
+    }
+
+    int capacity = (1 << (job->cutoff + 1)) - 1;
+    job->segments = malloc(capacity * sizeof(segment_t));
+    job->results = malloc(capacity * sizeof(long));
+    job->workers = malloc(job->threads * sizeof(worker_t));
+    job->args = malloc(job->threads * sizeof(worker_arg_t));
+    pool->handles = malloc(job->threads * sizeof(pthread_t));
+
+    if (job->segments == NULL || job->results == NULL ||
+        job->workers == NULL || job->args == NULL || pool->handles == NULL) {
+        free(pool->handles);
+        parallel_job_free(job);
+        return false;
+    }
+    pool->job = job;
+
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->work, NULL);
+    pthread_cond_init(&pool->done, NULL);
+    for (int id = 0; id < job->threads; id++) {
+        pthread_mutex_init(&job->workers[id].lock, NULL);
+        job->args[id] = (worker_arg_t){pool, id};
+    }
+
+    for (; pool->started < pool->threads; pool->started++) {
+        if (pthread_create(&pool->handles[pool->started], NULL,
+                           parallel_thread,
+                           &job->args[pool->started]) != 0) {
+            break;
+        }
+    }
+    return true;
+}
+
+/*
+ * Ukončenie vlákien skupiny a uvoľnenie jej pamäte.
+ */
+void bst_pool_dispose(bst_pool_t *pool) {
+    pthread_mutex_lock(&pool->lock);
+    pool->stopping = true;
+    pthread_cond_broadcast(&pool->work);
+    pthread_mutex_unlock(&pool->lock);
+
+    for (int id = 1; id < pool->started; id++) {
+        pthread_join(pool->handles[id], NULL);
+    }
+
+    for (int id = 0; id < pool->threads; id++) {
+        pthread_mutex_destroy(&pool->job->workers[id].lock);
+    }
+    pthread_cond_destroy(&pool->done);
+    pthread_cond_destroy(&pool->work);
+    pthread_mutex_destroy(&pool->lock);
+    free(pool->handles);
+    parallel_job_free(pool->job);
+    *pool = (bst_pool_t){0};
+}
+
+/*
+ * Paralelné spracovanie všetkých uzlov stromu vláknami skupiny.
+ *
+ * Funkcia map sa zavolá nad každým uzlom a výsledky sa spoja funkciou reduce
+ * v poradí inorder, začínajúc hodnotou identity (neutrálny prvok operácie
+ * reduce). Obe funkcie môžu byť volané súbežne z viacerých vlákien; strom sa
+ * počas prechodu nesmie meniť. Skupinu môže naraz používať iba jedno
+ * volajúce vlákno.
+ *
+ * Filter je možné vyjadriť funkciou map, ktorá pre nevyhovujúce uzly vráti
+ * neutrálny prvok.
+ */
+long bst_pool_reduce(bst_pool_t *pool, bst_node_t *tree, bst_map_t map,
+                     bst_reduce_t reduce, long identity, void *context) {
+    job_t *job = pool->job;
+    job->map = map;
+    job->reduce = reduce;
+    job->identity = identity;
+    job->context = context;
+
+    if (pool->threads == 1) {
+        return parallel_subtree(job, tree);
+    }
+
+    job->segment_count = 0;
+    parallel_split(job, tree, 0);
+    for (int id = 0; id < job->threads; id++) {
+        job->workers[id].next =
+            (int)((long)job->segment_count * id / job->threads);
+        job->workers[id].end =
+            (int)((long)job->segment_count * (id + 1) / job->threads);
+    }
+
+    pthread_mutex_lock(&pool->lock);
+    pool->pending = pool->started - 1;
+    pool->generation++;
+    pthread_cond_broadcast(&pool->work);
+    pthread_mutex_unlock(&pool->lock);
+
+    // Rozsahy nespustených vlákien sa rozkradnú
+    parallel_work(job, 0);
+
+    pthread_mutex_lock(&pool->lock);
+    while (pool->pending > 0) {
+        pthread_cond_wait(&pool->done, &pool->lock);
+    }
+    pthread_mutex_unlock(&pool->lock);
+
+    long result = identity;
+    for (int i = 0; i < job->segment_count; i++) {
+        result = reduce(result, job->results[i], context);
+    }
+    return result;
+}
+
+/*
+ * Jednorazový paralelný prechod (pozri bst_pool_reduce).
+ *
+ * Vlákna sa vytvárajú pri každom volaní a po jeho skončení zaniknú, čo pri
+ * stromoch s desiatkami až stovkami uzlov prevýši samotný prechod, ak funkcia
+ * map nie je veľmi drahá. Pre opakované prechody takých stromov je určená
+ * skupina bst_pool_t, inak je vhodnejšie zvoliť threads = 1.
+ */
+long bst_parallel_reduce(bst_node_t *tree, bst_map_t map, bst_reduce_t reduce,
+                         long identity, void *context, int threads) {
+    bst_pool_t pool;
+    if (threads > 1 && bst_pool_init(&pool, threads)) {
+        long result =
+            bst_pool_reduce(&pool, tree, map, reduce, identity, context);
+        bst_pool_dispose(&pool);
+        return result;
+    }
+
+    job_t job = {.map = map, .reduce = reduce, .identity = identity,
+                 .context = context, .threads = 1};
+    return parallel_subtree(&job, tree);
+}
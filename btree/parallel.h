@@ -0,0 +1,46 @@
+/*
+ * Hlavičkový súbor pre paralelný prechod binárnym vyhľadávacím stromom.
+ *
+ * Jednorazový prechod (bst_parallel_reduce) vytvorí vlákna pri každom
+ * volaní. Pri opakovaných prechodoch menších stromov je vhodnejšia trvalá
+ * skupina vlákien bst_pool_t, ktorej vlákna aj pomocné polia sa vytvoria raz
+ * v bst_pool_init a medzi prechodmi čakajú. Aj tak stojí prebudenie vlákien
+ * jednotky mikrosekúnd, takže pri lacnej funkcii map nad stromom so stovkami
+ * uzlov (bench parallel_reduce) je rýchlejší sekvenčný prechod (threads = 1).
+ */
+
+#ifndef IAL_BTREE_PARALLEL_H
+#define IAL_BTREE_PARALLEL_H
+
+#include "btree.h"
+#include <pthread.h>
+#include <stdbool.h>
+
+// Zobrazenie uzlu na čiastkový výsledok
+typedef long (*bst_map_t)(bst_node_t *node, void *context);
+// Asociatívne spojenie dvoch čiastkových výsledkov (ľavý, pravý)
+typedef long (*bst_reduce_t)(long left, long right, void *context);
+
+// Trvalá skupina vlákien
+typedef struct bst_pool {
+  int threads;               // počet vlákien vrátane volajúceho
+  int started;               // skutočne spustené vlákna vrátane volajúceho
+  pthread_t *handles;
+  struct parallel_job *job;  // stav prechodu a jeho pomocné polia
+  pthread_mutex_t lock;
+  pthread_cond_t work;       // nový prechod alebo ukončenie skupiny
+  pthread_cond_t done;       // pomocné vlákna dokončili prechod
+  unsigned long generation;  // poradové číslo posledného prechodu
+  int pending;               // pomocné vlákna, ktoré ešte prechod spracúvajú
+  bool stopping;
+} bst_pool_t;
+
+bool bst_pool_init(bst_pool_t *pool, int threads);
+void bst_pool_dispose(bst_pool_t *pool);
+long bst_pool_reduce(bst_pool_t *pool, bst_node_t *tree, bst_map_t map,
+                     bst_reduce_t reduce, long identity, void *context);
+
+long bst_parallel_reduce(bst_node_t *tree, bst_map_t map, bst_reduce_t reduce,
+                         long identity, void *context, int threads);
+
+#endif
@@ -0,0 +1,234 @@
+/*
+ * Perzistentný binárny vyhľadávací strom s kopírovaním ciest
+ *
+ * Popis verzií a vlastníctva odkazov je v súbore persistent.h.
+ *
+ * Keďže kľúče sú typu char, strom nemôže mať viac ako 256 úrovní a všetky
+ * prechody vystačia so zásobníkom pevnej veľkosti.
+ */
+
+#include "persistent.h"
+#include "stats.h"
+#include <limits.h>
+#include <stdlib.h>
+
+#define PERSISTENT_MAX_DEPTH (UCHAR_MAX + 1)
+
+/*
+ * Nový uzol s jedným odkazom. Odkazy na potomkov prechádzajú na uzol.
+ *
+ * Uzly sa nealokujú cez alokátor z memory.h (pozri tam).
+ */
+static bst_pnode_t *persistent_node(char key, int value, bst_pnode_t *left,
+                                    bst_pnode_t *right) {
+    bst_pnode_t *node = malloc(sizeof(bst_pnode_t));
+    if (node == NULL) abort();
+    BST_STAT(bst_stats.allocations++;)
+    node->key = key;
+    node->value = value;
+    node->left = left;
+    node->right = right;
+    atomic_init(&node->refs, 1);
+    return node;
+}
+
+/*
+ * Získanie ďalšieho odkazu na verziu root (snímka verzie). Funkcia vráti
+ * root; pre NULL nerobí nič.
+ */
+bst_pnode_t *bst_persistent_retain(bst_pnode_t *root) {
+    if (root != NULL) {
+        atomic_fetch_add_explicit(&root->refs, 1, memory_order_relaxed);
+    }
+    return root;
+}
+
+/*
+ * Uvoľnenie odkazu na verziu root.
+ *
+ * Uzly, na ktoré po uvoľnení neodkazuje žiadna iná verzia, sa uvoľnia;
+ * zdieľané podstromy zostávajú nedotknuté.
+ */
+void bst_persistent_release(bst_pnode_t *root) {
+    // Každý uvoľnený uzol nahradí na zásobníku seba dvoma potomkami,
+    // zásobník preto nepresiahne výšku stromu zväčšenú o jeden
+    bst_pnode_t *stack[PERSISTENT_MAX_DEPTH + 1];
+    int top = 0;
+
+    stack[top++] = root;
+    while (top > 0) {
+        bst_pnode_t *node = stack[--top];
+        if (node == NULL ||
+            atomic_fetch_sub_explicit(&node->refs, 1, memory_order_acq_rel) !=
+                1) {
+            continue;
+        }
+        stack[top++] = node->left;
+        stack[top++] = node->right;
+        free(node);
+        BST_STAT(bst_stats.frees++;)
+    }
+}
+
+/*
+ * Nájdenie uzlu vo verzii root.
+ *
+ * V prípade úspechu vráti funkcia hodnotu true a do premennej value zapíše
+ * hodnotu daného uzlu. V opačnom prípade vráti hodnotu false a premenná
+ * value ostáva nezmenená.
+ */
+bool bst_persistent_search(bst_pnode_t *root, char key, int *value) {
+    BST_STAT(unsigned depth = 0;)
+    while (root != NULL) {
+        BST_STAT(depth++;)
+        if (root->key == key) {
+            *value = root->value;
+            BST_STAT(bst_stats_search(depth);)
+            return true;
+        }
+        root = root->key > key ? root->left : root->right;
+    }
+    BST_STAT(bst_stats_search(depth);)
+    return false;
+}
+
+/*
+ * Vloženie uzlu do verzie root.
+ *
+ * Funkcia vráti koreň novej verzie, v ktorej má kľúč key hodnotu value.
+ * Skopírujú sa iba uzly na ceste ku kľúču, verzia root sa nemení.
+ */
+bst_pnode_t *bst_persistent_insert(bst_pnode_t *root, char key, int value) {
+    bst_pnode_t *result = NULL;
+    bst_pnode_t **link = &result;
+
+    while (root != NULL) {
+        if (root->key == key) {
+            *link = persistent_node(key, value,
+                                    bst_persistent_retain(root->left),
+                                    bst_persistent_retain(root->right));
+            return result;
+        }
+
+        // Vedľajší podstrom sa zdieľa, na ceste pokračuje kópia
+        if (root->key > key) {
+            *link = persistent_node(root->key, root->value, NULL,
+                                    bst_persistent_retain(root->right));
+            link = &(*link)->left;
+            root = root->left;
+        } else {
+            *link = persistent_node(root->key, root->value,
+                                    bst_persistent_retain(root->left), NULL);
+            link = &(*link)->right;
+            root = root->right;
+        }
+    }
+
+    *link = persistent_node(key, value, NULL, NULL);
+    return result;
+}
+
+/*
+ * Odstránenie uzlu z verzie root.
+ *
+ * Funkcia vráti koreň novej verzie bez kľúča key. Pokiaľ kľúč neexistuje,
+ * nič sa nekopíruje a funkcia vráti ďalší odkaz na root. Uzol s oboma
+ * podstromami sa rovnako ako v bst_delete nahradí najpravejším uzlom
+ * ľavého podstromu; skopíruje sa aj cesta k nemu.
+ */
+bst_pnode_t *bst_persistent_delete(bst_pnode_t *root, char key) {
+    int value;
+    if (!bst_persistent_search(root, key, &value)) {
+        return bst_persistent_retain(root);
+    }
+
+    bst_pnode_t *result = NULL;
+    bst_pnode_t **link = &result;
+
+    while (root->key != key) {
+        if (root->key > key) {
+            *link = persistent_node(root->key, root->value, NULL,
+                                    bst_persistent_retain(root->right));
+            link = &(*link)->left;
+            root = root->left;
+        } else {
+            *link = persistent_node(root->key, root->value,
+                                    bst_persistent_retain(root->left), NULL);
+            link = &(*link)->right;
+            root = root->right;
+        }
+    }
+
+    if (root->left == NULL || root->right == NULL) {
+        *link = bst_persistent_retain(root->left != NULL ? root->left
+                                                         : root->right);
+        return result;
+    }
+
+    // Kópia odstraňovaného uzlu dostane kľúč a hodnotu najpravejšieho uzlu
+    bst_pnode_t *target = persistent_node(root->key, root->value, NULL,
+                                          bst_persistent_retain(root->right));
+    *link = target;
+    link = &target->left;
+    bst_pnode_t *node = root->left;
+    while (node->right != NULL) {
+        *link = persistent_node(node->key, node->value,
+                                bst_persistent_retain(node->left), NULL);
+        link = &(*link)->right;
+        node = node->right;
+    }
+    target->key = node->key;
+    target->value = node->value;
+    *link = bst_persistent_retain(node->left);
+    return result;
+}
+
+/*
+ * Perzistentná kópia bežného stromu tree s rovnakým tvarom. Strom tree sa
+ * nemení.
+ */
+bst_pnode_t *bst_persistent_from_tree(bst_node_t *tree) {
+    bst_node_t *sources[PERSISTENT_MAX_DEPTH + 1];
+    bst_pnode_t **links[PERSISTENT_MAX_DEPTH + 1];
+    bst_pnode_t *result = NULL;
+    int top = 0;
+
+    if (tree != NULL) {
+        sources[top] = tree;
+        links[top++] = &result;
+    }
+    while (top > 0) {
+        bst_node_t *source = sources[--top];
+        bst_pnode_t *node = persistent_node(source->key, source->value, NULL,
+                                            NULL);
+        *links[top] = node;
+        if (source->right != NULL) {
+            sources[top] = source->right;
+            links[top++] = &node->right;
+        }
+        if (source->left != NULL) {
+            sources[top] = source->left;
+            links[top++] = &node->left;
+        }
+    }
+    return result;
+}
+
+/*
+ * Inorder prechod verziou root. Uzly sa vypíšu funkciou bst_print_node.
+ */
+void bst_persistent_inorder(bst_pnode_t *root) {
+    bst_pnode_t *stack[PERSISTENT_MAX_DEPTH];
+    int top = 0;
+
+    while (root != NULL || top > 0) {
+        while (root != NULL) {
+            stack[top++] = root;
+            root = root->left;
+        }
+        root = stack[--top];
+        bst_node_t node = {root->key, root->value, NULL, NULL};
+        bst_print_node(&node);
+        root = root->right;
+    }
+}
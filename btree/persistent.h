@@ -0,0 +1,45 @@
+/*
+ * Hlavičkový súbor pre perzistentný (nemenný) binárny vyhľadávací strom.
+ *
+ * Verzia stromu je ukazovateľ na koreň a nikdy sa nemení. Vloženie aj
+ * zmazanie skopírujú iba uzly na ceste od koreňa k menenému uzlu (O(h))
+ * a vrátia koreň novej verzie; ostatné podstromy nová verzia zdieľa so
+ * starou. Stará verzia zostáva platná, kým ju jej vlastník neuvoľní.
+ *
+ * Uzly počítajú odkazy (z rodičov a od vlastníkov verzií). Snímka verzie
+ * je preto O(1): bst_persistent_retain iba zvýši počítadlo koreňa.
+ * bst_persistent_release uvoľní uzly, na ktoré už neodkazuje žiadna verzia.
+ * Počítadlá sú atomické, takže verzie možno uchovávať a uvoľňovať v rôznych
+ * vláknach; čítanie verzie synchronizáciu nepotrebuje.
+ *
+ * Prázdny strom je NULL. Každá funkcia vracajúca koreň odovzdáva volajúcemu
+ * jeden odkaz, ktorý treba uvoľniť funkciou bst_persistent_release.
+ */
+
+#ifndef IAL_BTREE_PERSISTENT_H
+#define IAL_BTREE_PERSISTENT_H
+
+#include "btree.h"
+#include <stdatomic.h>
+#include <stdbool.h>
+
+// Uzol perzistentného stromu
+typedef struct bst_pnode {
+  char key;                // kľúč
+  int value;               // hodnota
+  struct bst_pnode *left;  // ľavý potomok
+  struct bst_pnode *right; // pravý potomok
+  atomic_uint refs;        // počet odkazov na uzol
+} bst_pnode_t;
+
+bst_pnode_t *bst_persistent_retain(bst_pnode_t *root);
+void bst_persistent_release(bst_pnode_t *root);
+
+bool bst_persistent_search(bst_pnode_t *root, char key, int *value);
+bst_pnode_t *bst_persistent_insert(bst_pnode_t *root, char key, int value);
+bst_pnode_t *bst_persistent_delete(bst_pnode_t *root, char key);
+
+bst_pnode_t *bst_persistent_from_tree(bst_node_t *tree);
+void bst_persistent_inorder(bst_pnode_t *root);
+
+#endif
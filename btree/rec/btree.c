@@ -3,12 +3,115 @@
  *
  * S využitím dátových typov zo súboru btree.h a pripravených kostier funkcií
  * implementujte binárny vyhľadávací strom pomocou rekurzie.
+ *
+ * Rekurzia sa zanorí najviac do hĺbky REC_MAX_DEPTH. Funkcie prechádzajúce
+ * jednu cestu stromom (hľadanie, vkladanie, mazanie) hlbšie pokračujú
+ * cyklom, prechody a rušenie stromu spracujú hlbšie podstromy iteratívne so
+ * zásobníkom na halde. Spotreba zásobníku volaní je tak obmedzená aj pre
+ * degenerovaný strom zo zoradených kľúčov.
  */
 
 #include "../btree.h"
+#include "../memory.h"
+#include "../stats.h"
 #include <stdio.h>
 #include <stdlib.h>
 
+// Najväčšia hĺbka rekurzie, hlbšie sa pokračuje iteratívne
+#define REC_MAX_DEPTH 64
+
+// Spracovanie uzlu pri prechode
+typedef enum rec_order {
+    REC_PREORDER,
+    REC_INORDER,
+    REC_POSTORDER,
+    REC_DISPOSE // postorder s uvoľnením uzlu
+} rec_order_t;
+
+// Rámec iteratívneho prechodu: uzol a počet už spracovaných potomkov
+typedef struct rec_frame {
+    bst_node_t *node;
+    int visited;
+} rec_frame_t;
+
+static void rec_visit(bst_node_t *node, rec_order_t order, int visited) {
+    if (order == REC_DISPOSE) {
+        if (visited == 2) {
+            bst_node_release(node);
+            BST_STAT(bst_stats.frees++;)
+        }
+        return;
+    }
+    if ((order == REC_PREORDER && visited == 0) ||
+        (order == REC_INORDER && visited == 1) ||
+        (order == REC_POSTORDER && visited == 2)) {
+        bst_print_node(node);
+    }
+}
+
+/*
+ * Iteratívne dohľadanie odkazu na uzol s kľúčom key, prípadne na prázdne
+ * miesto preň. Hĺbka depth sa zvýši o počet prejdených uzlov.
+ */
+static bst_node_t **rec_find_iterative(bst_node_t **tree, char key,
+                                       unsigned *depth) {
+    while (*tree != NULL && (*tree)->key != key) {
+        (*depth)++;
+        tree = (*tree)->key > key ? &(*tree)->left : &(*tree)->right;
+    }
+    return tree;
+}
+
+/*
+ * Iteratívny prechod podstromom so zásobníkom rámcov na halde.
+ */
+static void rec_walk_iterative(bst_node_t *tree, rec_order_t order) {
+    size_t capacity = 2 * REC_MAX_DEPTH, top = 0;
+    rec_frame_t *stack = malloc(capacity * sizeof(rec_frame_t));
+    if (stack == NULL) abort();
+
+    stack[top++] = (rec_frame_t){tree, 0};
+    while (top > 0) {
+        rec_frame_t *frame = &stack[top - 1];
+        bst_node_t *node = frame->node;
+        rec_visit(node, order, frame->visited);
+        if (frame->visited == 2) {
+            top--;
+            continue;
+        }
+
+        bst_node_t *child = frame->visited == 0 ? node->left : node->right;
+        frame->visited++;
+        if (child == NULL) continue;
+
+        if (top == capacity) {
+            capacity *= 2;
+            rec_frame_t *grown = realloc(stack, capacity * sizeof(rec_frame_t));
+            if (grown == NULL) abort();
+            stack = grown;
+        }
+        stack[top++] = (rec_frame_t){child, 0};
+    }
+    free(stack);
+}
+
+/*
+ * Rekurzívny prechod podstromom, od hĺbky REC_MAX_DEPTH iteratívny.
+ */
+static void rec_walk(bst_node_t *tree, rec_order_t order, int depth) {
+    if (tree == NULL) return;
+    if (depth >= REC_MAX_DEPTH) {
+        rec_walk_iterative(tree, order);
+        return;
+    }
+
+    rec_visit(tree, order, 0);
+    rec_walk(tree->left, order, depth + 1);
+    rec_visit(tree, order, 1);
+    rec_walk(tree->right, order, depth + 1);
+    rec_visit(tree, order, 2);
+}
+
 /*
  * Inicializácia stromu.
  *
@@ -16,13 +119,31 @@
  * inicializovaným stromom. V opačnom prípade môže dôjsť k úniku pamäte (memory
  * leak). Keďže neinicializovaný ukazovateľ má nedefinovanú hodnotu, nie je
  * možné toto detegovať vo funkcii.
+ *
+ * Prázdny strom je reprezentovaný hodnotou NULL, inicializácia nič
+ * nealokuje.
  */
 void bst_init(bst_node_t **tree) {
-//    if (tree != NULL) return;
+    *tree = NULL;
+}
+
+static bool rec_search(bst_node_t *tree, char key, int *value,
+                       unsigned depth) {
+    if (depth >= REC_MAX_DEPTH) {
+        tree = *rec_find_iterative(&tree, key, &depth);
+    }
 
-    *tree = malloc(sizeof(bst_node_t));
-    (*tree)->left = NULL;
-    (*tree)->right = NULL;
+    if (tree == NULL) {
+        BST_STAT(bst_stats_search(depth);)
+        return false;
+    }
+    if (tree->key == key) {
+        *value = tree->value;
+        BST_STAT(bst_stats_search(depth + 1);)
+        return true;
+    }
+    return rec_search(tree->key > key ? tree->left : tree->right, key, value,
+                      depth + 1);
 }
 
 /*
@@ -32,22 +153,36 @@ void bst_init(bst_node_t **tree) {
  * hodnotu daného uzlu. V opačnom prípade funckia vráti hodnotu false a premenná
  * value ostáva nezmenená.
  *
- * Funkciu implementujte rekurzívne bez použitia vlastných pomocných funkcií.
+ * Od hĺbky REC_MAX_DEPTH pokračuje hľadanie cyklom.
  */
 bool bst_search(bst_node_t *tree, char key, int *value) {
-    if (tree == NULL) return false;
-
-    if (tree->key != key) {
-        if (tree->key > key)
-            return bst_search(tree->left, key, value);
-        else
-            return bst_search(tree->right, key, value);
-    } else if (tree->key == key) {
-        *value = tree->value;
-        return true;
+    return rec_search(tree, key, value, 0);
+}
+
+static void rec_insert(bst_node_t **tree, char key, int value,
+                       unsigned depth) {
+    if (depth >= REC_MAX_DEPTH) {
+        tree = rec_find_iterative(tree, key, &depth);
+    }
+
+    if (*tree == NULL) {
+        *tree = bst_node_allocate();
+        if (*tree == NULL) return;
+        BST_STAT(bst_stats.allocations++;)
+        (*tree)->key = key;
+        (*tree)->value = value;
+        (*tree)->left = NULL;
+        (*tree)->right = NULL;
+        return;
     }
 
-    return false;
+    if ((*tree)->key == key) {
+        (*tree)->value = value;
+        return;
+    }
+
+    rec_insert((*tree)->key > key ? &(*tree)->left : &(*tree)->right, key,
+               value, depth + 1);
 }
 
 /*
@@ -59,28 +194,32 @@ bool bst_search(bst_node_t *tree, char key, int *value) {
  * Výsledný strom musí spĺňať podmienku vyhľadávacieho stromu — ľavý podstrom
  * uzlu obsahuje iba menšie kľúče, pravý väčšie.
  *
- * Funkciu implementujte rekurzívne bez použitia vlastných pomocných funkcií.
+ * Od hĺbky REC_MAX_DEPTH pokračuje vkladanie cyklom.
  */
 void bst_insert(bst_node_t **tree, char key, int value) {
-    if (*tree == NULL) {
-        *tree = malloc(sizeof(bst_node_t));
-        (*tree)->key = key;
-        (*tree)->value = value;
-        (*tree)->left = NULL;
-        (*tree)->right = NULL;
-        return;
+    rec_insert(tree, key, value, 0);
+}
+
+static void rec_replace_by_rightmost(bst_node_t *target, bst_node_t **tree,
+                                     unsigned depth) {
+    if (depth >= REC_MAX_DEPTH) {
+        while ((*tree)->right != NULL) {
+            tree = &(*tree)->right;
+        }
     }
 
-    if ((*tree)->key == key) {
-        (*tree)->value = value;
+    if ((*tree)->right != NULL) {
+        rec_replace_by_rightmost(target, &(*tree)->right, depth + 1);
         return;
     }
 
-    if ((*tree)->key > key) {
-        bst_insert(&(*tree)->left, key, value);
-    } else {
-        bst_insert(&(*tree)->right, key, value);
-    }
+    target->key = (*tree)->key;
+    target->value = (*tree)->value;
+
+    bst_node_t *tmp = *tree;
+    *tree = (*tree)->left;
+    bst_node_release(tmp);
+    BST_STAT(bst_stats.frees++;)
 }
 
 /*
@@ -94,20 +233,41 @@ void bst_insert(bst_node_t **tree, char key, int value) {
  *
  * Táto pomocná funkcia bude využitá pri implementácii funkcie bst_delete.
  *
- * Funkciu implementujte rekurzívne bez použitia vlastných pomocných funkcií.
+ * Od hĺbky REC_MAX_DEPTH pokračuje zostup doprava cyklom.
  */
 void bst_replace_by_rightmost(bst_node_t *target, bst_node_t **tree) {
-    if ((*tree)->right == NULL) {
-        target->key = (*tree)->key;
-        target->value = (*tree)->value;
+    rec_replace_by_rightmost(target, tree, 0);
+}
 
-        bst_node_t *tmp = *tree;
-        *tree = (*tree)->left;
-        free(tmp);
+static void rec_delete(bst_node_t **tree, char key, unsigned depth) {
+    if (depth >= REC_MAX_DEPTH) {
+        tree = rec_find_iterative(tree, key, &depth);
+    }
+
+    if (*tree == NULL) return;
+
+    if ((*tree)->key != key) {
+        rec_delete((*tree)->key > key ? &(*tree)->left : &(*tree)->right, key,
+                   depth + 1);
         return;
     }
 
-    bst_replace_by_rightmost(target, &(*tree)->right);
+    bool has_left_child = (*tree)->left != NULL;
+    bool has_right_child = (*tree)->right != NULL;
+    bool has_only_one_child = has_left_child ^ has_right_child;
+
+    if (has_only_one_child) {
+        bst_node_t *tmp = *tree;
+        *tree = has_left_child ? (*tree)->left : (*tree)->right;
+        bst_node_release(tmp);
+        BST_STAT(bst_stats.frees++;)
+    } else if (has_left_child && has_right_child) {
+        rec_replace_by_rightmost(*tree, &(*tree)->left, depth + 1);
+    } else {
+        bst_node_release(*tree);
+        BST_STAT(bst_stats.frees++;)
+        *tree = NULL;
+    }
 }
 
 /*
@@ -119,33 +279,10 @@ void bst_replace_by_rightmost(bst_node_t *target, bst_node_t **tree) {
  * ľavého podstromu. Najpravejší uzol nemusí byť listom!
  * Funkcia korektne uvoľní všetky alokované zdroje odstráneného uzlu.
  *
- * Funkciu implementujte rekurzívne pomocou bst_replace_by_rightmost a bez
- * použitia vlastných pomocných funkcií.
+ * Od hĺbky REC_MAX_DEPTH pokračuje mazanie cyklom.
  */
 void bst_delete(bst_node_t **tree, char key) {
-    int result;
-    bool exists = bst_search(*tree, key, &result);
-
-    if (!exists) return;
-
-    if ((*tree)->key != key) {
-        bst_delete((*tree)->key > key ? &(*tree)->left : &(*tree)->right, key);
-    } else {
-        bool has_left_child = (*tree)->left != NULL;
-        bool has_right_child = (*tree)->right != NULL;
-        bool has_only_one_child = has_left_child ^ has_right_child;
-
-        if (has_only_one_child) {
-            bst_node_t *tmp = *tree;
-            *tree = has_left_child ? (*tree)->left : (*tree)->right;
-            free(tmp);
-        } else if (has_left_child && has_right_child) {
-            bst_replace_by_rightmost(*tree, &(*tree)->left);
-        } else {
-            free(*tree);
-            *tree = NULL;
-        }
-    }
+    rec_delete(tree, key, 0);
 }
 
 /*
@@ -155,14 +292,11 @@ void bst_delete(bst_node_t **tree, char key) {
  * inicializácii. Funkcia korektne uvoľní všetky alokované zdroje rušených
  * uzlov.
  *
- * Funkciu implementujte rekurzívne bez použitia vlastných pomocných funkcií.
+ * Prechod zabezpečuje rec_walk: rekurzia do hĺbky REC_MAX_DEPTH, hlbšie
+ * iteratívne so zásobníkom na halde.
  */
 void bst_dispose(bst_node_t **tree) {
-    if (*tree == NULL) return;
-
-    bst_dispose(&(*tree)->left);
-    bst_dispose(&(*tree)->right);
-    free(*tree);
+    rec_walk(*tree, REC_DISPOSE, 0);
     *tree = NULL;
 }
 
@@ -171,14 +305,11 @@ void bst_dispose(bst_node_t **tree) {
  *
  * Pre aktuálne spracovávaný uzol nad ním zavolajte funkciu bst_print_node.
  *
- * Funkciu implementujte rekurzívne bez použitia vlastných pomocných funkcií.
+ * Prechod zabezpečuje rec_walk: rekurzia do hĺbky REC_MAX_DEPTH, hlbšie
+ * iteratívne so zásobníkom na halde.
  */
 void bst_preorder(bst_node_t *tree) {
-    if (tree == NULL) return;
-
-    bst_print_node(tree);
-    bst_preorder(tree->left);
-    bst_preorder(tree->right);
+    rec_walk(tree, REC_PREORDER, 0);
 }
 
 /*
@@ -186,14 +317,11 @@ void bst_preorder(bst_node_t *tree) {
  *
  * Pre aktuálne spracovávaný uzol nad ním zavolajte funkciu bst_print_node.
  *
- * Funkciu implementujte rekurzívne bez použitia vlastných pomocných funkcií.
+ * Prechod zabezpečuje rec_walk: rekurzia do hĺbky REC_MAX_DEPTH, hlbšie
+ * iteratívne so zásobníkom na halde.
  */
 void bst_inorder(bst_node_t *tree) {
-    if (tree == NULL) return;
-
-    bst_inorder(tree->left);
-    bst_print_node(tree);
-    bst_inorder(tree->right);
+    rec_walk(tree, REC_INORDER, 0);
 }
 
 /*
@@ -201,12 +329,9 @@ void bst_inorder(bst_node_t *tree) {
  *
  * Pre aktuálne spracovávaný uzol nad ním zavolajte funkciu bst_print_node.
  *
- * Funkciu implementujte rekurzívne bez použitia vlastných pomocných funkcií.
+ * Prechod zabezpečuje rec_walk: rekurzia do hĺbky REC_MAX_DEPTH, hlbšie
+ * iteratívne so zásobníkom na halde.
  */
 void bst_postorder(bst_node_t *tree) {
-    if (tree == NULL) return;
-
-    bst_postorder(tree->left);
-    bst_postorder(tree->right);
-    bst_print_node(tree);
+    rec_walk(tree, REC_POSTORDER, 0);
 }
@@ -0,0 +1,142 @@
+/*
+ * Množinové operácie nad binárnymi vyhľadávacími stromami
+ *
+ * Všetky operácie menia prvý strom a spotrebujú druhý: uzly, ktoré do
+ * výsledku nepatria, sa uvoľnia a druhý strom je po operácii prázdny. Pri
+ * zhodnom kľúči zostáva uzol (a hodnota) prvého stromu.
+ */
+
+#include "set.h"
+#include "memory.h"
+#include "stats.h"
+#include <stdlib.h>
+
+typedef enum set_op { SET_UNION, SET_INTERSECTION, SET_DIFFERENCE } set_op_t;
+
+static void set_free(bst_node_t *node) {
+    bst_node_release(node);
+    BST_STAT(bst_stats.frees++;)
+}
+
+/*
+ * Zoradenie uzlov stromu do poľa nodes v poradí inorder.
+ *
+ * Funkcia vráti počet uzlov. Strom sa nemení.
+ */
+size_t bst_flatten(bst_node_t *tree, bst_node_t *nodes[BST_SET_MAX]) {
+    bst_node_t *stack[BST_SET_MAX];
+    size_t top = 0, count = 0;
+
+    while (tree != NULL || top > 0) {
+        while (tree != NULL) {
+            stack[top++] = tree;
+            tree = tree->left;
+        }
+        tree = stack[--top];
+        nodes[count++] = tree;
+        tree = tree->right;
+    }
+    return count;
+}
+
+/*
+ * Prepojenie zoradených uzlov nodes[0..count-1] do vyváženého stromu.
+ *
+ * Funkcia vráti koreň nového stromu. Hĺbka výsledného stromu je
+ * floor(log2(count)) + 1.
+ */
+bst_node_t *bst_build_balanced(bst_node_t *nodes[], size_t count) {
+    if (count == 0) return NULL;
+
+    size_t middle = count / 2;
+    bst_node_t *root = nodes[middle];
+    root->left = bst_build_balanced(nodes, middle);
+    root->right = bst_build_balanced(nodes + middle + 1, count - middle - 1);
+    return root;
+}
+
+/*
+ * Vyváženie stromu v čase O(n) bez alokácie.
+ */
+void bst_balance(bst_node_t **tree) {
+    bst_node_t *nodes[BST_SET_MAX];
+    size_t count = bst_flatten(*tree, nodes);
+
+    *tree = bst_build_balanced(nodes, count);
+}
+
+static void set_merge(bst_node_t **tree, bst_node_t **other, set_op_t op) {
+    bst_node_t *first[BST_SET_MAX], *second[BST_SET_MAX];
+    bst_node_t *result[BST_SET_MAX];
+    size_t first_count = bst_flatten(*tree, first);
+    size_t second_count = bst_flatten(*other, second);
+    size_t i = 0, j = 0, count = 0;
+
+    while (i < first_count && j < second_count) {
+        if (first[i]->key < second[j]->key) {
+            if (op != SET_INTERSECTION) {
+                result[count++] = first[i];
+            } else {
+                set_free(first[i]);
+            }
+            i++;
+        } else if (first[i]->key > second[j]->key) {
+            if (op == SET_UNION) {
+                result[count++] = second[j];
+            } else {
+                set_free(second[j]);
+            }
+            j++;
+        } else {
+            if (op != SET_DIFFERENCE) {
+                result[count++] = first[i];
+            } else {
+                set_free(first[i]);
+            }
+            set_free(second[j]);
+            i++;
+            j++;
+        }
+    }
+    for (; i < first_count; i++) {
+        if (op != SET_INTERSECTION) {
+            result[count++] = first[i];
+        } else {
+            set_free(first[i]);
+        }
+    }
+    for (; j < second_count; j++) {
+        if (op == SET_UNION) {
+            result[count++] = second[j];
+        } else {
+            set_free(second[j]);
+        }
+    }
+
+    *tree = bst_build_balanced(result, count);
+    *other = NULL;
+}
+
+/*
+ * Zjednotenie: do stromu tree sa presunú všetky uzly stromu other s kľúčmi,
+ * ktoré v ňom ešte nie sú.
+ */
+void bst_union(bst_node_t **tree, bst_node_t **other) {
+    set_merge(tree, other, SET_UNION);
+}
+
+/*
+ * Prienik: v strome tree zostanú iba uzly s kľúčmi, ktoré sú aj v strome
+ * other.
+ */
+void bst_intersection(bst_node_t **tree, bst_node_t **other) {
+    set_merge(tree, other, SET_INTERSECTION);
+}
+
+/*
+ * Rozdiel: zo stromu tree sa odstránia uzly s kľúčmi, ktoré sú v strome
+ * other.
+ */
+void bst_difference(bst_node_t **tree, bst_node_t **other) {
+    set_merge(tree, other, SET_DIFFERENCE);
+}
@@ -0,0 +1,31 @@
+/*
+ * Hlavičkový súbor pre množinové operácie nad binárnymi vyhľadávacími
+ * stromami.
+ *
+ * Operácie oba stromy zoradia prechodom inorder do polí uzlov, zlúčia ich
+ * jedným prechodom a z výsledku postavia vyvážený strom. Uzly sa pritom iba
+ * prepájajú, nič sa nealokuje a celá operácia trvá O(m + n).
+ *
+ * Keďže kľúče sú typu char, strom má najviac BST_SET_MAX uzlov a polia
+ * uzlov majú pevnú veľkosť.
+ */
+
+#ifndef IAL_BTREE_SET_H
+#define IAL_BTREE_SET_H
+
+#include "btree.h"
+#include <limits.h>
+#include <stddef.h>
+
+// Maximálny počet uzlov stromu s rôznymi kľúčmi
+#define BST_SET_MAX (UCHAR_MAX + 1)
+
+size_t bst_flatten(bst_node_t *tree, bst_node_t *nodes[BST_SET_MAX]);
+bst_node_t *bst_build_balanced(bst_node_t *nodes[], size_t count);
+void bst_balance(bst_node_t **tree);
+
+void bst_union(bst_node_t **tree, bst_node_t **other);
+void bst_intersection(bst_node_t **tree, bst_node_t **other);
+void bst_difference(bst_node_t **tree, bst_node_t **other);
+
+#endif
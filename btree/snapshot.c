@@ -0,0 +1,290 @@
+/*
+ * Perzistentný snapshot binárneho vyhľadávacieho stromu
+ *
+ * Popis formátu je v súbore snapshot.h.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "snapshot.h"
+#include "../common/snapshot_file.h"
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Kľúče sú typu char, vyhľadávací strom preto nemá viac ako 256 úrovní
+#define SNAPSHOT_MAX_DEPTH (UCHAR_MAX + 1)
+
+static uint32_t snapshot_count(bst_node_t *tree) {
+    uint32_t count = 0;
+    size_t capacity = 16;
+    size_t top = 0;
+    bst_node_t **stack = malloc(capacity * sizeof(bst_node_t *));
+    if (stack == NULL) return UINT32_MAX;
+
+    if (tree != NULL) stack[top++] = tree;
+    while (top > 0) {
+        bst_node_t *node = stack[--top];
+        count++;
+
+        if (top + 2 > capacity) {
+            capacity *= 2;
+            bst_node_t **grown = realloc(stack, capacity * sizeof(bst_node_t *));
+            if (grown == NULL) {
+                free(stack);
+                return UINT32_MAX;
+            }
+            stack = grown;
+        }
+        if (node->right != NULL) stack[top++] = node->right;
+        if (node->left != NULL) stack[top++] = node->left;
+    }
+
+    free(stack);
+    return count;
+}
+
+/*
+ * Prevod stromu na pole uzlov v poradí preorder.
+ *
+ * Zásobník uchováva index rodiča, aby bolo možné dodatočne doplniť index
+ * pravého potomka.
+ */
+static bool snapshot_flatten(bst_node_t *tree, bst_snapshot_node_t *nodes) {
+    typedef struct {
+        bst_node_t *node;
+        uint32_t parent;
+    } pending_t;
+
+    size_t capacity = 16;
+    size_t top = 0;
+    pending_t *stack = malloc(capacity * sizeof(pending_t));
+    if (stack == NULL) return false;
+
+    uint32_t next = 0;
+    if (tree != NULL) stack[top++] = (pending_t){tree, BST_SNAPSHOT_NONE};
+
+    while (top > 0) {
+        pending_t pending = stack[--top];
+
+        // Ľavá vetva sa ukladá bez zásobníka, pravé podstromy čakajú
+        for (bst_node_t *node = pending.node; node != NULL; node = node->left) {
+            uint32_t index = next++;
+            if (pending.parent != BST_SNAPSHOT_NONE) {
+                nodes[pending.parent].right = index;
+                pending.parent = BST_SNAPSHOT_NONE;
+            }
+
+            nodes[index] = (bst_snapshot_node_t){
+                .value = node->value,
+                .left = node->left != NULL ? index + 1 : BST_SNAPSHOT_NONE,
+                .right = BST_SNAPSHOT_NONE,
+                .key = node->key,
+            };
+
+            if (node->right != NULL) {
+                if (top == capacity) {
+                    capacity *= 2;
+                    pending_t *grown = realloc(stack, capacity * sizeof(pending_t));
+                    if (grown == NULL) {
+                        free(stack);
+                        return false;
+                    }
+                    stack = grown;
+                }
+                stack[top++] = (pending_t){node->right, index};
+            }
+        }
+    }
+
+    free(stack);
+    return true;
+}
+
+/*
+ * Uloženie stromu do súboru postupom zo súboru common/snapshot_file.h.
+ *
+ * V prípade úspechu vráti funkcia hodnotu true.
+ */
+bool bst_snapshot_save(bst_node_t *tree, const char *path) {
+    uint32_t count = snapshot_count(tree);
+    if (count == UINT32_MAX) return false;
+
+    bst_snapshot_node_t *nodes = calloc(count > 0 ? count : 1, sizeof(*nodes));
+    if (nodes == NULL) return false;
+    if (!snapshot_flatten(tree, nodes)) {
+        free(nodes);
+        return false;
+    }
+
+    bst_snapshot_header_t header = {
+        .magic = BST_SNAPSHOT_MAGIC,
+        .version = BST_SNAPSHOT_VERSION,
+        .endian = BST_SNAPSHOT_ENDIAN,
+        .node_count = count,
+        .checksum = snapshot_file_checksum(SNAPSHOT_FILE_CHECKSUM, nodes,
+                                           count * sizeof(*nodes)),
+        .file_size = sizeof(header) + (uint64_t)count * sizeof(*nodes),
+    };
+
+    snapshot_file_t output;
+    bool ok = snapshot_file_create(&output, path);
+    if (ok) {
+        ok = fwrite(&header, sizeof(header), 1, output.file) == 1 &&
+             fwrite(nodes, sizeof(*nodes), count, output.file) == count;
+        ok = snapshot_file_finish(&output, ok);
+    }
+
+    free(nodes);
+    return ok;
+}
+
+/*
+ * Načítanie snapshotu namapovaním súboru do pamäte.
+ *
+ * Funkcia neprepočítava kontrolný súčet (na to slúži bst_snapshot_validate),
+ * overí iba hlavičku a veľkosť súboru. Indexy potomkov sa kontrolujú až pri
+ * ich použití.
+ *
+ * V prípade úspechu vráti funkcia hodnotu true.
+ */
+bool bst_snapshot_open(bst_snapshot_t *snapshot, const char *path) {
+    memset(snapshot, 0, sizeof(*snapshot));
+
+    snapshot->data = snapshot_file_map(path, &snapshot->size);
+    if (snapshot->data == NULL) return false;
+
+    const bst_snapshot_header_t *header = snapshot->data;
+    if (snapshot->size < sizeof(*header) || header->magic != BST_SNAPSHOT_MAGIC ||
+        header->version != BST_SNAPSHOT_VERSION ||
+        header->endian != BST_SNAPSHOT_ENDIAN ||
+        header->file_size != snapshot->size ||
+        header->file_size != sizeof(*header) + (uint64_t)header->node_count *
+                                                   sizeof(bst_snapshot_node_t)) {
+        bst_snapshot_close(snapshot);
+        return false;
+    }
+
+    snapshot->header = header;
+    snapshot->nodes = (const bst_snapshot_node_t *)(header + 1);
+    return true;
+}
+
+/*
+ * Uvoľnenie mapovania snapshotu.
+ */
+void bst_snapshot_close(bst_snapshot_t *snapshot) {
+    snapshot_file_unmap(snapshot->data, snapshot->size);
+    memset(snapshot, 0, sizeof(*snapshot));
+}
+
+/*
+ * Kontrola tvaru stromu v snapshote.
+ *
+ * Uzly musia ležať v poli presne v poradí preorder od koreňa s indexom 0 a
+ * kľúč každého uzlu musí ležať v intervale, ktorý mu určujú jeho predkovia.
+ * Poškodený súbor tak nemôže opísať cyklus, zdieľaný podstrom, nedosiahnuteľný
+ * uzol ani strom, ktorý nie je vyhľadávací.
+ */
+static bool snapshot_check_tree(const bst_snapshot_t *snapshot) {
+    // Kľúče podstromu ležia v otvorenom intervale (low, high)
+    typedef struct {
+        uint32_t index;
+        int low, high;
+    } pending_t;
+
+    pending_t stack[SNAPSHOT_MAX_DEPTH + 1];
+    uint32_t count = snapshot->header->node_count;
+    uint32_t next = 0;
+    int top = 0;
+
+    if (count > 0) stack[top++] = (pending_t){0, CHAR_MIN - 1, CHAR_MAX + 1};
+    while (top > 0) {
+        pending_t pending = stack[--top];
+        if (pending.index != next || next == count) return false;
+        next++;
+
+        const bst_snapshot_node_t *node = &snapshot->nodes[pending.index];
+        if (node->key <= pending.low || node->key >= pending.high) {
+            return false;
+        }
+
+        // Platný strom nemá na zásobníku viac uzlov, než je jeho hĺbka
+        if (top + 2 > SNAPSHOT_MAX_DEPTH + 1) return false;
+        if (node->right != BST_SNAPSHOT_NONE) {
+            stack[top++] = (pending_t){node->right, node->key, pending.high};
+        }
+        if (node->left != BST_SNAPSHOT_NONE) {
+            stack[top++] = (pending_t){node->left, pending.low, node->key};
+        }
+    }
+    return next == count;
+}
+
+/*
+ * Úplná kontrola súboru so snapshotom.
+ *
+ * Okrem hlavičky overí kontrolný súčet a tvar stromu: poradie uzlov v poli
+ * a usporiadanie kľúčov.
+ */
+bool bst_snapshot_validate(const char *path) {
+    bst_snapshot_t snapshot;
+    if (!bst_snapshot_open(&snapshot, path)) return false;
+
+    uint32_t count = snapshot.header->node_count;
+    bool ok = snapshot_file_checksum(SNAPSHOT_FILE_CHECKSUM, snapshot.nodes,
+                                     count * sizeof(bst_snapshot_node_t)) ==
+                  snapshot.header->checksum &&
+              snapshot_check_tree(&snapshot);
+
+    bst_snapshot_close(&snapshot);
+    return ok;
+}
+
+/*
+ * Nájdenie uzlu priamo v namapovanom snapshote.
+ *
+ * V prípade úspechu vráti funkcia hodnotu true a do premennej value zapíše
+ * hodnotu daného uzlu. V opačnom prípade funkcia vráti hodnotu false a
+ * premenná value ostáva nezmenená.
+ */
+bool bst_snapshot_search(bst_snapshot_t *snapshot, char key, int *value) {
+    uint32_t count = snapshot->header->node_count;
+    uint32_t index = count > 0 ? 0 : BST_SNAPSHOT_NONE;
+
+    while (index != BST_SNAPSHOT_NONE) {
+        const bst_snapshot_node_t *node = &snapshot->nodes[index];
+
+        if (node->key == key) {
+            *value = node->value;
+            return true;
+        }
+
+        uint32_t next = node->key > key ? node->left : node->right;
+        if (next != BST_SNAPSHOT_NONE && (next <= index || next >= count)) {
+            return false;
+        }
+        index = next;
+    }
+
+    return false;
+}
+
+/*
+ * Obnovenie stromu zo snapshotu.
+ *
+ * Uzly sa vkladajú v poradí preorder, takže obnovený strom má rovnaký tvar
+ * ako uložený. Strom tree musí byť prázdny.
+ *
+ * Pokiaľ snapshot neopisuje platný vyhľadávací strom, funkcia strom nezmení
+ * a vráti hodnotu false.
+ */
+bool bst_snapshot_restore(bst_snapshot_t *snapshot, bst_node_t **tree) {
+    if (!snapshot_check_tree(snapshot)) return false;
+
+    for (uint32_t i = 0; i < snapshot->header->node_count; i++) {
+        bst_insert(tree, snapshot->nodes[i].key, snapshot->nodes[i].value);
+    }
+    return true;
+}
@@ -0,0 +1,66 @@
+/*
+ * Hlavičkový súbor pre perzistentný snapshot binárneho vyhľadávacieho stromu.
+ *
+ * Snapshot je kompaktný binárny obraz stromu, ktorý sa pri načítaní iba
+ * namapuje do pamäte (mmap) a prehľadáva sa priamo — bez alokácie uzlov.
+ * Potomkovia sú namiesto ukazovateľov uložení ako indexy do poľa uzlov.
+ *
+ * Formát súboru (verzia 1, natívne poradie bajtov):
+ *   bst_snapshot_header_t               hlavička
+ *   bst_snapshot_node_t nodes[count]    uzly v poradí preorder
+ *
+ * Kvôli poradiu preorder má každý potomok väčší index ako jeho rodič, vďaka
+ * čomu nemôže ani poškodený súbor vytvoriť cyklus. Kontrolný súčet (FNV-1a)
+ * pokrýva všetky uzly. Funkcie bst_snapshot_validate a bst_snapshot_restore
+ * navyše overia, že uzly tvoria vyhľadávací strom.
+ */
+
+#ifndef IAL_BTREE_SNAPSHOT_H
+#define IAL_BTREE_SNAPSHOT_H
+
+#include "btree.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define BST_SNAPSHOT_MAGIC 0x53544249u // "IBTS"
+#define BST_SNAPSHOT_VERSION 1
+#define BST_SNAPSHOT_ENDIAN 0x0102
+#define BST_SNAPSHOT_NONE UINT32_MAX
+
+// Hlavička súboru
+typedef struct bst_snapshot_header {
+  uint32_t magic;      // BST_SNAPSHOT_MAGIC
+  uint16_t version;    // BST_SNAPSHOT_VERSION
+  uint16_t endian;     // BST_SNAPSHOT_ENDIAN v poradí bajtov zapisovateľa
+  uint32_t node_count; // počet uzlov
+  uint32_t checksum;   // FNV-1a všetkých uzlov
+  uint64_t file_size;  // celková veľkosť súboru
+} bst_snapshot_header_t;
+
+// Uzol snapshotu
+typedef struct bst_snapshot_node {
+  int32_t value;  // hodnota
+  uint32_t left;  // index ľavého potomka alebo BST_SNAPSHOT_NONE
+  uint32_t right; // index pravého potomka alebo BST_SNAPSHOT_NONE
+  char key;       // kľúč
+  char padding[3];
+} bst_snapshot_node_t;
+
+// Namapovaný snapshot
+typedef struct bst_snapshot {
+  void *data;  // začiatok mapovania
+  size_t size; // veľkosť mapovania
+  const bst_snapshot_header_t *header;
+  const bst_snapshot_node_t *nodes;
+} bst_snapshot_t;
+
+bool bst_snapshot_save(bst_node_t *tree, const char *path);
+bool bst_snapshot_open(bst_snapshot_t *snapshot, const char *path);
+void bst_snapshot_close(bst_snapshot_t *snapshot);
+bool bst_snapshot_validate(const char *path);
+
+bool bst_snapshot_search(bst_snapshot_t *snapshot, char key, int *value);
+bool bst_snapshot_restore(bst_snapshot_t *snapshot, bst_node_t **tree);
+
+#endif
@@ -0,0 +1,82 @@
+/*
+ * Splay vyhľadávanie v binárnom vyhľadávacom strome
+ *
+ * Podľa D. D. Sleator, R. E. Tarjan: Self-Adjusting Binary Search Trees
+ * (1985), variant zhora nadol. Zostup od koreňa rozoberá strom na ľavý
+ * strom s menšími a pravý strom s väčšími kľúčmi; pri dvoch krokoch
+ * rovnakým smerom sa najprv rotuje (zig-zig). Na konci sa oba stromy
+ * zavesia pod posledný navštívený uzol. Nepotrebuje zásobník ani rodičovské
+ * ukazovatele.
+ */
+
+#include "splay.h"
+#include "stats.h"
+#include <stddef.h>
+
+/*
+ * Presun uzlu s kľúčom key do koreňa stromu.
+ *
+ * Pokiaľ kľúč v strome nie je, stane sa koreňom posledný uzol na ceste
+ * k nemu (jeho predchodca alebo následník).
+ */
+void bst_splay(bst_node_t **tree, char key) {
+    bst_node_t *node = *tree;
+    if (node == NULL) return;
+
+    // Pomocný uzol: left drží koreň pravého stromu, right koreň ľavého
+    bst_node_t header = {0, 0, NULL, NULL};
+    bst_node_t *lower = &header, *upper = &header;
+    BST_STAT(unsigned depth = 1;)
+
+    while (node->key != key) {
+        if (key < node->key) {
+            if (node->left == NULL) break;
+            if (key < node->left->key) {
+                bst_node_t *child = node->left;
+                node->left = child->right;
+                child->right = node;
+                node = child;
+                if (node->left == NULL) break;
+            }
+            upper->left = node;
+            upper = node;
+            node = node->left;
+        } else {
+            if (node->right == NULL) break;
+            if (key > node->right->key) {
+                bst_node_t *child = node->right;
+                node->right = child->left;
+                child->left = node;
+                node = child;
+                if (node->right == NULL) break;
+            }
+            lower->right = node;
+            lower = node;
+            node = node->right;
+        }
+        BST_STAT(depth++;)
+    }
+
+    lower->right = node->left;
+    upper->left = node->right;
+    node->left = header.right;
+    node->right = header.left;
+    *tree = node;
+    BST_STAT(bst_stats_search(depth);)
+}
+
+/*
+ * Vyhľadanie uzlu v strome s presunom do koreňa.
+ *
+ * V prípade úspechu vráti funkcia hodnotu true a do premennej value zapíše
+ * hodnotu daného uzlu. V opačnom prípade funkcia vráti hodnotu false a
+ * premenná value ostáva nezmenená. V oboch prípadoch sa koreňom stromu
+ * stane posledný navštívený uzol.
+ */
+bool bst_splay_search(bst_node_t **tree, char key, int *value) {
+    bst_splay(tree, key);
+    if (*tree == NULL || (*tree)->key != key) return false;
+
+    *value = (*tree)->value;
+    return true;
+}
@@ -0,0 +1,20 @@
+/*
+ * Hlavičkový súbor pre samoorganizujúce sa (splay) vyhľadávanie v binárnom
+ * vyhľadávacom strome.
+ *
+ * Hľadanie presunie nájdený uzol rotáciami do koreňa, takže opakovane
+ * hľadané kľúče zostávajú blízko koreňa. Amortizovaná cena operácie je
+ * O(log n) a pri nerovnomernom prístupe sa blíži entropii rozdelenia
+ * kľúčov. Hľadanie preto mení tvar stromu a je voliteľnou alternatívou
+ * k bst_search.
+ */
+
+#ifndef IAL_BTREE_SPLAY_H
+#define IAL_BTREE_SPLAY_H
+
+#include "btree.h"
+
+void bst_splay(bst_node_t **tree, char key);
+bool bst_splay_search(bst_node_t **tree, char key, int *value);
+
+#endif
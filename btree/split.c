@@ -0,0 +1,95 @@
+/*
+ * Rozdelenie a spojenie binárnych vyhľadávacích stromov
+ *
+ * Rozdelenie zostupuje od koreňa k miestu kľúča a každý navštívený uzol
+ * zavesí na koniec jedného z dvoch rozpracovaných stromov: uzol s menším
+ * kľúčom pokračuje svojím pravým podstromom, preto sa ďalší menší uzol
+ * zavesí na jeho pravú stranu (a symetricky pre väčšie kľúče). Poradie
+ * uzlov zostáva zachované, stromy nie sú hlbšie ako pôvodný strom.
+ */
+
+#include "split.h"
+#include <stdbool.h>
+#include <stddef.h>
+
+static void split_path(bst_node_t **tree, char key, bool inclusive,
+                       bst_node_t **lower, bst_node_t **upper) {
+    bst_node_t *node = *tree;
+    bst_node_t **lower_hook = lower;
+    bst_node_t **upper_hook = upper;
+
+    // Strom môže byť zároveň jedným z výstupov
+    *tree = NULL;
+    while (node != NULL) {
+        if (node->key < key || (inclusive && node->key == key)) {
+            *lower_hook = node;
+            lower_hook = &node->right;
+            node = node->right;
+        } else {
+            *upper_hook = node;
+            upper_hook = &node->left;
+            node = node->left;
+        }
+    }
+    *lower_hook = NULL;
+    *upper_hook = NULL;
+}
+
+/*
+ * Rozdelenie stromu podľa kľúča.
+ *
+ * Uzly s kľúčom menším ako key sa presunú do stromu lower, ostatné do stromu
+ * upper. Pôvodný strom je po rozdelení prázdny, môže však byť zároveň
+ * stromom lower alebo upper. Predchádzajúci obsah stromov lower a upper sa
+ * nezachová.
+ */
+void bst_split(bst_node_t **tree, char key, bst_node_t **lower,
+               bst_node_t **upper) {
+    split_path(tree, key, false, lower, upper);
+}
+
+/*
+ * Spojenie dvoch stromov, v ktorých sú všetky kľúče stromu lower menšie ako
+ * všetky kľúče stromu upper.
+ *
+ * Koreňom výsledku, uloženého do stromu lower, sa stane najpravejší uzol
+ * stromu lower. Strom upper je po spojení prázdny.
+ */
+void bst_join(bst_node_t **lower, bst_node_t **upper) {
+    if (*lower == NULL) {
+        *lower = *upper;
+        *upper = NULL;
+        return;
+    }
+    if (*upper == NULL) return;
+
+    bst_node_t **link = lower;
+    while ((*link)->right != NULL) {
+        link = &(*link)->right;
+    }
+
+    bst_node_t *root = *link;
+    *link = root->left;
+    root->left = *lower;
+    root->right = *upper;
+
+    *lower = root;
+    *upper = NULL;
+}
+
+/*
+ * Zmazanie všetkých uzlov s kľúčmi z intervalu <low,high>.
+ *
+ * Interval sa oddelí dvoma rozdeleniami, zruší sa celý naraz a zvyšné časti
+ * sa spoja. Pre k mazaných uzlov trvá O(h + k) namiesto k volaní
+ * bst_delete. Pre low > high funkcia nerobí nič.
+ */
+void bst_delete_range(bst_node_t **tree, char low, char high) {
+    if (low > high) return;
+
+    bst_node_t *range, *upper;
+    split_path(tree, low, false, tree, &range);
+    split_path(&range, high, true, &range, &upper);
+    bst_dispose(&range);
+    bst_join(tree, &upper);
+}
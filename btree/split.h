@@ -0,0 +1,19 @@
+/*
+ * Hlavičkový súbor pre rozdelenie a spojenie binárnych vyhľadávacích
+ * stromov.
+ *
+ * Rozdelenie aj spojenie prechádzajú iba jednu cestu od koreňa, trvajú teda
+ * O(h) pre strom výšky h a nič nealokujú.
+ */
+
+#ifndef IAL_BTREE_SPLIT_H
+#define IAL_BTREE_SPLIT_H
+
+#include "btree.h"
+
+void bst_split(bst_node_t **tree, char key, bst_node_t **lower,
+               bst_node_t **upper);
+void bst_join(bst_node_t **lower, bst_node_t **upper);
+void bst_delete_range(bst_node_t **tree, char low, char high);
+
+#endif
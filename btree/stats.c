@@ -0,0 +1,59 @@
+/*
+ * Štatistiky binárneho vyhľadávacieho stromu
+ */
+
+#include "stats.h"
+#include <string.h>
+
+bst_stats_t bst_stats;
+
+/*
+ * Zaznamenanie jedného hľadania, ktoré navštívilo depth uzlov.
+ */
+void bst_stats_search(unsigned depth) {
+    bst_stats.searches++;
+    bst_stats.depth += depth;
+    bst_stats.depth_histogram[depth < BST_STATS_MAX_DEPTH ? depth
+                                                          : BST_STATS_MAX_DEPTH]++;
+}
+
+/*
+ * Zaznamenanie obsadenosti zásobníka po vložení prvku.
+ */
+void bst_stats_stack(int size) {
+    if (size > bst_stats.stack_high_water) {
+        bst_stats.stack_high_water = size;
+    }
+}
+
+/*
+ * Vynulovanie všetkých počítadiel.
+ */
+void bst_stats_reset(void) {
+    memset(&bst_stats, 0, sizeof(bst_stats));
+}
+
+/*
+ * Výpis štatistík do súboru file.
+ */
+void bst_stats_dump(FILE *file) {
+#ifndef IAL_STATS
+    fprintf(file, "Statistics disabled (build with -DIAL_STATS)\n");
+#else
+    fprintf(file, "Searches: %lu\n", bst_stats.searches);
+    fprintf(file, "Average search depth: %.2f\n",
+            bst_stats.searches > 0
+                ? (double)bst_stats.depth / bst_stats.searches
+                : 0.0);
+    fprintf(file, "Search depth histogram:\n");
+    for (int i = 0; i <= BST_STATS_MAX_DEPTH; i++) {
+        if (bst_stats.depth_histogram[i] == 0) continue;
+        fprintf(file, "  %s%2d: %lu\n", i == BST_STATS_MAX_DEPTH ? ">=" : "  ",
+                i, bst_stats.depth_histogram[i]);
+    }
+    fprintf(file, "Allocations: %lu\n", bst_stats.allocations);
+    fprintf(file, "Frees: %lu\n", bst_stats.frees);
+    fprintf(file, "Live nodes: %lu\n", bst_stats.allocations - bst_stats.frees);
+    fprintf(file, "Stack high-water mark: %d\n", bst_stats.stack_high_water);
+#endif
+}
@@ -0,0 +1,41 @@
+/*
+ * Hlavičkový súbor pre štatistiky binárneho vyhľadávacieho stromu.
+ *
+ * Počítadlá sa zbierajú iba pri preklade s makrom IAL_STATS
+ * (make test STATS=1). Bez neho sa makro BST_STAT rozvinie na nič a
+ * štatistiky nemajú žiadnu réžiu. Počítadlá nie sú atomické, pri súbežnom
+ * používaní stromov sú preto iba orientačné.
+ */
+
+#ifndef IAL_BTREE_STATS_H
+#define IAL_BTREE_STATS_H
+
+#include <stdio.h>
+
+// Počet košov histogramu hĺbok hľadania, posledný kôš zahŕňa hlbšie
+#define BST_STATS_MAX_DEPTH 32
+
+#ifdef IAL_STATS
+#define BST_STAT(STATEMENT) STATEMENT
+#else
+#define BST_STAT(STATEMENT)
+#endif
+
+// Štatistiky stromu
+typedef struct bst_stats {
+  unsigned long searches;    // počet dokončených hľadaní
+  unsigned long depth;       // počet navštívených uzlov vo všetkých hľadaniach
+  unsigned long depth_histogram[BST_STATS_MAX_DEPTH + 1]; // hľadania podľa hĺbky
+  unsigned long allocations; // počet alokovaných uzlov
+  unsigned long frees;       // počet uvoľnených uzlov
+  int stack_high_water;      // najväčšia obsadenosť zásobníkov (iter)
+} bst_stats_t;
+
+extern bst_stats_t bst_stats;
+
+void bst_stats_search(unsigned depth);
+void bst_stats_stack(int size);
+void bst_stats_reset(void);
+void bst_stats_dump(FILE *file);
+
+#endif
@@ -0,0 +1,184 @@
+/*
+ * Záťažový test súbežného binárneho vyhľadávacieho stromu.
+ *
+ * Spustenie: ./stress [vlákna] [sekundy] [percento čítaní]
+ * Bez argumentov sa test spustí postupne pre 1, 2, 4, ... vlákien.
+ *
+ * Každé vlákno zapisuje iba kľúče, pre ktoré key % vlákna == id vlákna, a
+ * pamätá si ich očakávaný stav. Čítať môže ľubovoľné kľúče. Hodnota uzlu
+ * obsahuje kľúč, takže každé čítanie overí, že nevidí cudzí ani poškodený
+ * uzol, a vlastník kľúča overí, že po zápise číta práve zapísanú hodnotu.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "concurrent.h"
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+#define STRESS_KEYS (UCHAR_MAX + 1)
+#define STRESS_VALUE(KEY, SEQUENCE) ((((KEY) - CHAR_MIN) << 20) | (SEQUENCE))
+#define STRESS_KEY(VALUE) ((char)(((VALUE) >> 20) + CHAR_MIN))
+
+typedef struct stress_thread {
+    bst_concurrent_t *map;
+    int id;
+    int threads;
+    int read_percent;
+    double deadline;
+    long operations;
+    long errors;
+    bool present[STRESS_KEYS]; // očakávaný stav vlastných kľúčov
+    int values[STRESS_KEYS];
+} stress_thread_t;
+
+static double stress_now(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+static void *stress_worker(void *arg) {
+    stress_thread_t *thread = arg;
+    int slot = bst_concurrent_register(thread->map);
+    unsigned long state = 0x9E3779B97F4A7C15ul * (thread->id + 1);
+    int sequence = 0;
+
+    while (stress_now() < thread->deadline) {
+        for (int batch = 0; batch < 1024; batch++) {
+            state = state * 6364136223846793005ul + 1442695040888963407ul;
+            int index = (int)((state >> 33) % STRESS_KEYS);
+            char key = (char)(index + CHAR_MIN);
+            int value;
+
+            bool owned = index % thread->threads == thread->id;
+            if (!owned || (int)((state >> 17) % 100) < thread->read_percent) {
+                if (bst_concurrent_search(thread->map, slot, key, &value) &&
+                    STRESS_KEY(value) != key) {
+                    thread->errors++;
+                }
+            } else if ((state >> 13) & 1) {
+                value = STRESS_VALUE(index + CHAR_MIN, sequence++ & 0xFFFFF);
+                bst_concurrent_insert(thread->map, key, value);
+                thread->present[index] = true;
+                thread->values[index] = value;
+            } else {
+                bst_concurrent_delete(thread->map, key);
+                thread->present[index] = false;
+            }
+
+            if (owned) {
+                bool found =
+                    bst_concurrent_search(thread->map, slot, key, &value);
+                if (found != thread->present[index] ||
+                    (found && value != thread->values[index])) {
+                    thread->errors++;
+                }
+            }
+            thread->operations++;
+        }
+    }
+
+    bst_concurrent_unregister(thread->map, slot);
+    return NULL;
+}
+
+/*
+ * Kontrola výsledného stromu: usporiadanie kľúčov a zhoda s očakávaným
+ * stavom všetkých vlákien.
+ */
+static long stress_verify(bst_concurrent_t *map, stress_thread_t *threads,
+                          int count) {
+    int slot = bst_concurrent_register(map);
+    bst_node_t *stack[STRESS_KEYS + 1];
+    bool seen[STRESS_KEYS] = {false};
+    int top = 0;
+    int previous = INT_MIN;
+    long errors = 0;
+
+    bst_node_t *node = bst_concurrent_pin(map, slot);
+    while (node != NULL || top > 0) {
+        while (node != NULL) {
+            stack[top++] = node;
+            node = node->left;
+        }
+        node = stack[--top];
+
+        int index = node->key - CHAR_MIN;
+        stress_thread_t *owner = &threads[index % count];
+        if (node->key <= previous || !owner->present[index] ||
+            owner->values[index] != node->value) {
+            errors++;
+        }
+        seen[index] = true;
+        previous = node->key;
+        node = node->right;
+    }
+    bst_concurrent_unpin(map, slot);
+    bst_concurrent_unregister(map, slot);
+
+    for (int index = 0; index < STRESS_KEYS; index++) {
+        if (threads[index % count].present[index] && !seen[index]) errors++;
+    }
+    return errors;
+}
+
+static bool stress_run(int count, double seconds, int read_percent) {
+    bst_concurrent_t map;
+    bst_concurrent_init(&map);
+
+    stress_thread_t *threads = calloc(count, sizeof(stress_thread_t));
+    pthread_t *handles = malloc(count * sizeof(pthread_t));
+    double deadline = stress_now() + seconds;
+
+    for (int i = 0; i < count; i++) {
+        threads[i].map = &map;
+        threads[i].id = i;
+        threads[i].threads = count;
+        threads[i].read_percent = read_percent;
+        threads[i].deadline = deadline;
+        pthread_create(&handles[i], NULL, stress_worker, &threads[i]);
+    }
+
+    long operations = 0, errors = 0;
+    for (int i = 0; i < count; i++) {
+        pthread_join(handles[i], NULL);
+        operations += threads[i].operations;
+        errors += threads[i].errors;
+    }
+    errors += stress_verify(&map, threads, count);
+
+    printf("%-8d %-8d %14.0f %8ld\n", count, read_percent,
+           operations / seconds, errors);
+
+    bst_concurrent_dispose(&map);
+    free(handles);
+    free(threads);
+    return errors == 0;
+}
+
+int main(int argc, char *argv[]) {
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    int threads = argc > 1 ? atoi(argv[1]) : 0;
+    double seconds = argc > 2 ? atof(argv[2]) : 1.0;
+    int read_percent = argc > 3 ? atoi(argv[3]) : 90;
+    bool ok = true;
+
+    if (threads > BST_CONCURRENT_MAX_THREADS - 1) {
+        threads = BST_CONCURRENT_MAX_THREADS - 1;
+    }
+
+    printf("%-8s %-8s %14s %8s\n", "threads", "reads%", "ops/s", "errors");
+    if (threads > 0) {
+        ok = stress_run(threads, seconds, read_percent);
+    } else {
+        long limit = cores > 2 ? cores : 4;
+        for (long count = 1; count <= limit; count *= 2) {
+            ok &= stress_run((int)count, seconds, read_percent);
+        }
+    }
+    return ok ? 0 : 1;
+}
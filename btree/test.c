@@ -1,6 +1,19 @@
 #include "btree.h"
+#include "batch.h"
+#include "concurrent.h"
+#include "dump.h"
+#include "memory.h"
+#include "parallel.h"
+#include "persistent.h"
+#include "set.h"
+#include "snapshot.h"
+#include "splay.h"
+#include "split.h"
+#include "stats.h"
 #include "test_util.h"
+#include "../common/snapshot_file.h"
 #include <stdio.h>
+#include <stdlib.h>
 
 const int base_data_count = 15;
 const char base_keys[] = {'H', 'D', 'L', 'B', 'F', 'J', 'N', 'A',
@@ -15,6 +28,33 @@ const int traversal_data_count = 5;
 const char traversal_keys[] = {'D', 'B', 'A', 'C', 'E'};
 const int traversal_values[] = {1, 2, 3, 4, 5};
 
+long test_map_value(bst_node_t *node, void *context) {
+  return node->key >= 'A' && node->key <= 'Z' ? node->value : 0;
+}
+
+long test_reduce_sum(long left, long right, void *context) {
+  return left + right;
+}
+
+// Alokátor s obmedzením na limit bajtov
+typedef struct test_cap {
+  size_t used;
+  size_t limit;
+} test_cap_t;
+
+void *test_cap_allocate(size_t size, void *context) {
+  test_cap_t *cap = context;
+  if (cap->used + size > cap->limit) return NULL;
+  cap->used += size;
+  return malloc(size);
+}
+
+void test_cap_release(void *pointer, size_t size, void *context) {
+  test_cap_t *cap = context;
+  cap->used -= size;
+  free(pointer);
+}
+
 void init_test() {
   printf("Binary Search Tree - testing script\n");
   printf("-----------------------------------\n");
@@ -169,6 +209,312 @@ printf("\n");
 bst_print_tree(test_tree);
 ENDTEST
 
+TEST(test_tree_snapshot, "Save, validate and search a snapshot")
+bst_init(&test_tree);
+bst_insert_many(&test_tree, base_keys, base_values, base_data_count);
+bst_snapshot_save(test_tree, "test_snapshot.bin");
+printf("Valid: %s\n", bst_snapshot_validate("test_snapshot.bin") ? "yes" : "no");
+bst_snapshot_t snapshot;
+if (bst_snapshot_open(&snapshot, "test_snapshot.bin")) {
+  int result;
+  if (bst_snapshot_search(&snapshot, 'K', &result)) {
+    printf("Found K: %d\n", result);
+  }
+  printf("Found X: %s\n",
+         bst_snapshot_search(&snapshot, 'X', &result) ? "yes" : "no");
+  bst_snapshot_close(&snapshot);
+}
+remove("test_snapshot.bin");
+bst_print_tree(test_tree);
+ENDTEST
+
+TEST(test_tree_snapshot_restore, "Restore a snapshot and reject a corrupt one")
+bst_init(&test_tree);
+bst_insert_many(&test_tree, base_keys, base_values, base_data_count);
+bst_snapshot_save(test_tree, "test_snapshot.bin");
+bst_dispose(&test_tree);
+bst_snapshot_t snapshot;
+if (bst_snapshot_open(&snapshot, "test_snapshot.bin")) {
+  printf("Restored: %s\n",
+         bst_snapshot_restore(&snapshot, &test_tree) ? "yes" : "no");
+  bst_snapshot_close(&snapshot);
+}
+bst_print_tree(test_tree);
+bst_dispose(&test_tree);
+// Ľavý potomok koreňa dostane väčší kľúč ako koreň, kontrolný súčet sedí
+FILE *file = fopen("test_snapshot.bin", "r+b");
+bst_snapshot_header_t header;
+bst_snapshot_node_t nodes[15];
+if (file != NULL && fread(&header, sizeof(header), 1, file) == 1 &&
+    fread(nodes, sizeof(nodes[0]), 15, file) == 15) {
+  nodes[1].key = nodes[0].key + 1;
+  header.checksum = snapshot_file_checksum(SNAPSHOT_FILE_CHECKSUM, nodes,
+                                           sizeof(nodes));
+  fseek(file, 0, SEEK_SET);
+  fwrite(&header, sizeof(header), 1, file);
+  fwrite(nodes, sizeof(nodes[0]), 15, file);
+}
+if (file != NULL) fclose(file);
+printf("Valid: %s\n", bst_snapshot_validate("test_snapshot.bin") ? "yes" : "no");
+if (bst_snapshot_open(&snapshot, "test_snapshot.bin")) {
+  printf("Restored: %s\n",
+         bst_snapshot_restore(&snapshot, &test_tree) ? "yes" : "no");
+  bst_snapshot_close(&snapshot);
+}
+remove("test_snapshot.bin");
+bst_print_tree(test_tree);
+ENDTEST
+
+TEST(test_tree_parallel_reduce, "Sum the values using a parallel traversal")
+bst_init(&test_tree);
+bst_insert_many(&test_tree, base_keys, base_values, base_data_count);
+printf("Sum: %ld\n", bst_parallel_reduce(test_tree, test_map_value,
+                                          test_reduce_sum, 0, NULL, 4));
+bst_print_tree(test_tree);
+ENDTEST
+
+TEST(test_tree_pool_reduce, "Reuse a thread pool for repeated traversals")
+bst_init(&test_tree);
+bst_insert_many(&test_tree, base_keys, base_values, base_data_count);
+bst_pool_t pool;
+if (bst_pool_init(&pool, 3)) {
+  for (int round = 0; round < 3; round++) {
+    printf("Sum: %ld\n", bst_pool_reduce(&pool, test_tree, test_map_value,
+                                         test_reduce_sum, 0, NULL));
+    bst_insert(&test_tree, (char)('P' + round), round + 1);
+  }
+  bst_pool_dispose(&pool);
+}
+ENDTEST
+
+TEST(test_tree_concurrent, "Insert, delete and search in a concurrent tree")
+bst_init(&test_tree);
+bst_concurrent_t map;
+bst_concurrent_init(&map);
+int slot = bst_concurrent_register(&map);
+for (int i = 0; i < base_data_count; i++) {
+  bst_concurrent_insert(&map, base_keys[i], base_values[i]);
+}
+bst_concurrent_delete(&map, 'L');
+bst_concurrent_insert(&map, 'K', 42);
+int result;
+if (bst_concurrent_search(&map, slot, 'K', &result)) {
+  printf("Found K: %d\n", result);
+}
+printf("Found L: %s\n",
+       bst_concurrent_search(&map, slot, 'L', &result) ? "yes" : "no");
+bst_print_tree(bst_concurrent_pin(&map, slot));
+bst_concurrent_unpin(&map, slot);
+bst_concurrent_unregister(&map, slot);
+bst_concurrent_dispose(&map);
+ENDTEST
+
+TEST(test_tree_stats, "Collect search depth and allocation statistics")
+bst_stats_reset();
+bst_init(&test_tree);
+bst_insert_many(&test_tree, base_keys, base_values, base_data_count);
+int result;
+for (int i = 0; i < base_data_count; i++) {
+  bst_search(test_tree, base_keys[i], &result);
+}
+bst_search(test_tree, 'X', &result);
+bst_inorder(test_tree);
+printf("\n");
+bst_stats_dump(stdout);
+ENDTEST
+
+TEST(test_tree_dump, "Dump the tree as JSON and DOT")
+bst_init(&test_tree);
+bst_insert_many(&test_tree, traversal_keys, traversal_values,
+                traversal_data_count);
+bst_dump_t dump;
+bst_dump_init_memory(&dump);
+bst_dump_tree(&dump, test_tree, BST_DUMP_JSON);
+bst_dump_tree(&dump, test_tree, BST_DUMP_DOT);
+printf("%s", dump.memory);
+bst_dump_free(&dump);
+ENDTEST
+
+TEST(test_tree_set_operations, "Union, difference and intersection of trees")
+bst_init(&test_tree);
+bst_node_t *other = NULL;
+bst_insert_many(&test_tree, traversal_keys, traversal_values,
+                traversal_data_count);
+bst_insert_many(&other, additional_keys, additional_values,
+                additional_data_count);
+bst_insert(&other, 'C', 40);
+bst_union(&test_tree, &other);
+bst_inorder(test_tree);
+printf("\n");
+const char removed_keys[] = {'C', 'E', 'X', 'Z'};
+bst_insert_many(&other, removed_keys, base_values, 4);
+bst_difference(&test_tree, &other);
+bst_inorder(test_tree);
+printf("\n");
+const char common_keys[] = {'A', 'B', 'P', 'Q', 'R', 'S', 'Z'};
+bst_insert_many(&other, common_keys, base_values, 7);
+bst_intersection(&test_tree, &other);
+bst_print_tree(test_tree);
+ENDTEST
+
+TEST(test_tree_split_join, "Split, join and delete a range of keys")
+bst_init(&test_tree);
+bst_insert_many(&test_tree, base_keys, base_values, base_data_count);
+bst_node_t *lower, *upper;
+bst_split(&test_tree, 'F', &lower, &upper);
+bst_inorder(lower);
+printf("\n");
+bst_inorder(upper);
+printf("\n");
+bst_join(&lower, &upper);
+test_tree = lower;
+bst_delete_range(&test_tree, 'C', 'K');
+bst_print_tree(test_tree);
+ENDTEST
+
+TEST(test_tree_splay, "Move searched keys to the root")
+bst_init(&test_tree);
+bst_insert_many(&test_tree, base_keys, base_values, base_data_count);
+int result;
+bool found = bst_splay_search(&test_tree, 'A', &result);
+printf("Found A: %s, value %d, root %c\n", found ? "true" : "false", result,
+       test_tree->key);
+found = bst_splay_search(&test_tree, 'X', &result);
+printf("Found X: %s, root %c\n", found ? "true" : "false", test_tree->key);
+bst_print_tree(test_tree);
+ENDTEST
+
+TEST(test_tree_sorted_feed, "Insert 10^6 sorted keys into degenerate trees")
+bst_init(&test_tree);
+const int feed_count = 1000000;
+const int key_range = '~' - '!' + 1;
+for (int descending = 0; descending <= 1; descending++) {
+  for (int i = 0; i < feed_count; i++) {
+    int offset = i % key_range;
+    char key = descending ? '~' - offset : '!' + offset;
+    bst_insert(&test_tree, key, i);
+  }
+  int found = 0, sum = 0, result;
+  for (int i = 0; i < feed_count; i++) {
+    if (bst_search(test_tree, '!' + i % key_range, &result)) {
+      found++;
+      sum += result % 1000;
+    }
+  }
+  printf("%s: found %d, checksum %d\n",
+         descending ? "Descending" : "Ascending", found, sum);
+  bst_preorder(test_tree);
+  printf("\n");
+  bst_inorder(test_tree);
+  printf("\n");
+  bst_postorder(test_tree);
+  printf("\n");
+  bst_dispose(&test_tree);
+}
+ENDTEST
+
+TEST(test_tree_empty, "Use an empty tree without any allocated node")
+bst_init(&test_tree);
+int result = -1;
+bool found = bst_search(test_tree, '\0', &result);
+printf("Root: %s, found: %s, value: %d\n",
+       test_tree == NULL ? "NULL" : "node", found ? "true" : "false", result);
+bst_delete(&test_tree, 'A');
+bst_preorder(test_tree);
+bst_inorder(test_tree);
+bst_postorder(test_tree);
+bst_insert(&test_tree, 'A', 1);
+bst_delete(&test_tree, 'A');
+printf("Root after insert and delete: %s\n",
+       test_tree == NULL ? "NULL" : "node");
+ENDTEST
+
+TEST(test_tree_batch, "Apply a batch of operations grouped by key")
+bst_init(&test_tree);
+bst_insert_many(&test_tree, base_keys, base_values, base_data_count);
+bst_batch_op_t ops[] = {
+    {BST_BATCH_SEARCH, 'F'},     {BST_BATCH_DELETE, 'D'},
+    {BST_BATCH_SEARCH, 'D'},     {BST_BATCH_INSERT, 'D', 40},
+    {BST_BATCH_SEARCH, 'D'},     {BST_BATCH_INSERT, 'X', 24},
+    {BST_BATCH_INSERT, 'X', 25}, {BST_BATCH_SEARCH, 'X'},
+    {BST_BATCH_DELETE, 'A'},     {BST_BATCH_DELETE, 'Z'}};
+int op_count = sizeof(ops) / sizeof(ops[0]);
+bst_batch(&test_tree, ops, op_count);
+for (int i = 0; i < op_count; i++) {
+  static const char *types[] = {"search", "insert", "delete"};
+  printf("%s %c: found %s", types[ops[i].type], ops[i].key,
+         ops[i].found ? "true" : "false");
+  if (ops[i].type == BST_BATCH_SEARCH && ops[i].found) {
+    printf(", value %d", ops[i].value);
+  }
+  printf("\n");
+}
+bst_print_tree(test_tree);
+ENDTEST
+
+TEST(test_tree_memory, "Report memory usage and reject growth over a cap")
+bst_init(&test_tree);
+bst_node_t *other_tree;
+bst_init(&other_tree);
+bst_memory_t before, usage;
+bst_memory_usage(NULL, &before);
+bst_insert_many(&test_tree, base_keys, base_values, base_data_count);
+bst_insert(&other_tree, 'Q', 1);
+bst_memory_usage(&test_tree, &usage);
+printf("Nodes: %zu\n", usage.nodes);
+printf("Slack: %zu\n", usage.slack);
+bst_memory_usage(&other_tree, &usage);
+printf("Other tree nodes: %zu\n", usage.nodes / sizeof(bst_node_t));
+bst_memory_usage(NULL, &usage);
+printf("All trees nodes: %zu\n",
+       (usage.nodes - before.nodes) / sizeof(bst_node_t));
+bst_dispose(&other_tree);
+bst_delete(&test_tree, 'H');
+bst_memory_usage(&test_tree, &usage);
+printf("Nodes after delete: %zu\n", usage.nodes);
+bst_dispose(&test_tree);
+test_cap_t cap = {0, 5 * sizeof(bst_node_t)};
+bst_allocator_t allocator = {test_cap_allocate, test_cap_release, NULL, &cap};
+bst_set_allocator(&allocator);
+bst_insert_many(&test_tree, base_keys, base_values, base_data_count);
+bst_print_tree(test_tree);
+bst_memory_usage(&test_tree, &usage);
+printf("Nodes under cap: %zu\n", usage.nodes / sizeof(bst_node_t));
+bst_memory_usage(NULL, &usage);
+printf("Rejections: %lu\n", usage.rejections - before.rejections);
+bst_dispose(&test_tree);
+bst_set_allocator(NULL);
+printf("Cap used: %zu\n", cap.used);
+ENDTEST
+
+TEST(test_tree_persistent, "Share unchanged subtrees between tree versions")
+bst_init(&test_tree);
+bst_insert_many(&test_tree, base_keys, base_values, base_data_count);
+bst_pnode_t *first = bst_persistent_from_tree(test_tree);
+bst_pnode_t *snapshot = bst_persistent_retain(first);
+bst_pnode_t *second = bst_persistent_insert(first, 'P', 20);
+bst_pnode_t *third = bst_persistent_delete(second, 'H');
+bst_persistent_release(first);
+printf("Snapshot: ");
+bst_persistent_inorder(snapshot);
+printf("\nSecond:   ");
+bst_persistent_inorder(second);
+printf("\nThird:    ");
+bst_persistent_inorder(third);
+printf("\nRoot keys: %c %c %c\n", snapshot->key, second->key, third->key);
+printf("Shared left subtree: %s\n",
+       snapshot->left == second->left ? "true" : "false");
+printf("Shared right subtree: %s\n",
+       second->right == third->right ? "true" : "false");
+int value = 0;
+bool found = bst_persistent_search(third, 'H', &value);
+printf("H in third: %s, P in third: %s\n", found ? "true" : "false",
+       bst_persistent_search(third, 'P', &value) ? "true" : "false");
+bst_persistent_release(snapshot);
+bst_persistent_release(second);
+bst_persistent_release(third);
+ENDTEST
+
 int main(int argc, char *argv[]) {
   init_test();
 
@@ -191,4 +537,19 @@ int main(int argc, char *argv[]) {
   test_tree_preorder();
   test_tree_inorder();
   test_tree_postorder();
+  test_tree_snapshot();
+  test_tree_snapshot_restore();
+  test_tree_parallel_reduce();
+  test_tree_pool_reduce();
+  test_tree_concurrent();
+  test_tree_stats();
+  test_tree_dump();
+  test_tree_set_operations();
+  test_tree_split_join();
+  test_tree_splay();
+  test_tree_sorted_feed();
+  test_tree_empty();
+  test_tree_batch();
+  test_tree_memory();
+  test_tree_persistent();
 }
@@ -0,0 +1,132 @@
+/*
+ * Spoločné vstupno-výstupné operácie snapshotov
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "snapshot_file.h"
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define FNV_PRIME 16777619u
+
+/*
+ * Pokračovanie kontrolného súčtu FNV-1a hash o size bajtov z data. Prvý
+ * blok začína hodnotou SNAPSHOT_FILE_CHECKSUM.
+ */
+uint32_t snapshot_file_checksum(uint32_t hash, const void *data, size_t size) {
+    const unsigned char *bytes = data;
+    for (size_t i = 0; i < size; i++) {
+        hash ^= bytes[i];
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+/*
+ * Synchronizácia adresára, v ktorom leží path, aby bolo trvalé premenovanie
+ * súboru.
+ */
+static bool snapshot_file_sync_directory(const char *path) {
+    const char *slash = strrchr(path, '/');
+    char *directory;
+    if (slash == NULL) {
+        directory = strdup(".");
+    } else {
+        size_t length = slash == path ? 1 : (size_t)(slash - path);
+        directory = strndup(path, length);
+    }
+    if (directory == NULL) return false;
+
+    int fd = open(directory, O_RDONLY);
+    free(directory);
+    if (fd < 0) return false;
+    bool ok = fsync(fd) == 0;
+    if (close(fd) != 0) ok = false;
+    return ok;
+}
+
+/*
+ * Otvorenie dočasného súboru pre snapshot, ktorý sa uloží do path.
+ *
+ * Do súboru file->file sa zapisuje priamo, zápis ukončí
+ * snapshot_file_finish. V prípade úspechu vráti funkcia hodnotu true.
+ */
+bool snapshot_file_create(snapshot_file_t *file, const char *path) {
+    file->path = path;
+    file->file = NULL;
+    file->tmp_path = malloc(strlen(path) + sizeof(".tmp"));
+    if (file->tmp_path == NULL) return false;
+    strcpy(file->tmp_path, path);
+    strcat(file->tmp_path, ".tmp");
+
+    file->file = fopen(file->tmp_path, "wb");
+    if (file->file == NULL) {
+        free(file->tmp_path);
+        file->tmp_path = NULL;
+        return false;
+    }
+    return true;
+}
+
+/*
+ * Ukončenie zápisu snapshotu.
+ *
+ * Ak je ok true, dočasný súbor sa synchronizuje na disk, premenuje sa na
+ * cieľové meno a synchronizuje sa adresár. Inak (alebo pri chybe niektorého
+ * kroku pred premenovaním) sa dočasný súbor zmaže a pôvodný snapshot zostane
+ * nedotknutý. Funkcia vráti hodnotu true, ak je nový snapshot trvalo uložený.
+ */
+bool snapshot_file_finish(snapshot_file_t *file, bool ok) {
+    if (ok) ok = fflush(file->file) == 0 && fsync(fileno(file->file)) == 0;
+    if (fclose(file->file) != 0) ok = false;
+    if (ok) {
+        ok = rename(file->tmp_path, file->path) == 0;
+        if (!ok) remove(file->tmp_path);
+        if (ok) ok = snapshot_file_sync_directory(file->path);
+    } else {
+        remove(file->tmp_path);
+    }
+
+    free(file->tmp_path);
+    file->tmp_path = NULL;
+    file->file = NULL;
+    return ok;
+}
+
+/*
+ * Namapovanie celého súboru path do pamäte iba na čítanie.
+ *
+ * V prípade úspechu vráti funkcia začiatok mapovania a do size zapíše jeho
+ * veľkosť. Prázdny súbor sa nemapuje, funkcia vtedy (rovnako ako pri chybe)
+ * vráti hodnotu NULL.
+ */
+void *snapshot_file_map(const char *path, size_t *size) {
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return NULL;
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size <= 0) {
+        close(fd);
+        return NULL;
+    }
+
+    void *data = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) return NULL;
+
+    *size = (size_t)info.st_size;
+    return data;
+}
+
+/*
+ * Zrušenie mapovania vytvoreného funkciou snapshot_file_map. Pre NULL
+ * nerobí nič.
+ */
+void snapshot_file_unmap(void *data, size_t size) {
+    if (data != NULL) munmap(data, size);
+}
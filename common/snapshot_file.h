@@ -0,0 +1,38 @@
+/*
+ * Hlavičkový súbor pre spoločné vstupno-výstupné operácie snapshotov.
+ *
+ * Snapshoty tabuľky (hashtable/snapshot.h) aj stromu (btree/snapshot.h) sa
+ * ukladajú rovnako: súbor sa zapíše pod dočasným menom, synchronizuje sa na
+ * disk a až potom sa premenuje na cieľové meno. Po premenovaní sa
+ * synchronizuje aj adresár, aby bolo trvalé aj samotné premenovanie. Pri páde
+ * počas ukladania tak zostane na disku buď pôvodný, alebo úplný nový
+ * snapshot. Načítanie súbor iba namapuje do pamäte.
+ */
+
+#ifndef IAL_COMMON_SNAPSHOT_FILE_H
+#define IAL_COMMON_SNAPSHOT_FILE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+// Počiatočná hodnota kontrolného súčtu FNV-1a
+#define SNAPSHOT_FILE_CHECKSUM 2166136261u
+
+// Rozpísaný snapshot
+typedef struct snapshot_file {
+  FILE *file;       // dočasný súbor otvorený na zápis
+  const char *path; // cieľová cesta
+  char *tmp_path;   // cesta dočasného súboru
+} snapshot_file_t;
+
+uint32_t snapshot_file_checksum(uint32_t hash, const void *data, size_t size);
+
+bool snapshot_file_create(snapshot_file_t *file, const char *path);
+bool snapshot_file_finish(snapshot_file_t *file, bool ok);
+
+void *snapshot_file_map(const char *path, size_t *size);
+void snapshot_file_unmap(void *data, size_t size);
+
+#endif
@@ -0,0 +1,126 @@
+/*
+ * Dávkové vykonávanie operácií nad tabuľkou s rozptýlenými položkami
+ *
+ * Dávka sa spracuje v troch prechodoch:
+ *   1. pre každú operáciu sa spočíta index v tabuľke a dĺžka kľúča,
+ *   2. operácie sa stabilne zoradia podľa indexu triedením počítaním,
+ *   3. zoznamy synonym sa spracujú postupne podľa indexu; kým sa
+ *      spracúva jeden zoznam, prednačíta sa začiatok ďalšieho.
+ *
+ * Stabilné triedenie zachová poradie operácií nad rovnakým kľúčom, výsledok
+ * je preto rovnaký ako pri postupnom volaní ht_get, ht_insert a ht_delete.
+ * Každý kľúč sa prečíta pri výpočte indexu iba raz.
+ */
+
+#include "batch.h"
+#include "filter.h"
+#include "key.h"
+#include "memory.h"
+#include "stats.h"
+#include <stdlib.h>
+#include <string.h>
+
+static bool batch_apply(ht_table_t *table, ht_filter_t *filter,
+                        ht_batch_op_t *op, int index, unsigned length) {
+    ht_item_t **link = &(*table)[index];
+    while (*link != NULL && strcmp((*link)->key, op->key) != 0) {
+        link = &(*link)->next;
+    }
+    ht_item_t *item = *link;
+    op->found = item != NULL;
+
+    switch (op->type) {
+    case HT_BATCH_GET:
+        if (item != NULL) op->value = item->value;
+        break;
+    case HT_BATCH_INSERT:
+        if (item != NULL) {
+            item->value = op->value;
+            break;
+        }
+        item = ht_item_allocate(table, sizeof(ht_item_t), length);
+        if (item == NULL) return false;
+        HT_STAT(ht_stats.allocations++;)
+        item->key = op->key;
+        item->value = op->value;
+        item->next = (*table)[index];
+        (*table)[index] = item;
+        if (filter != NULL) ht_filter_add(filter, op->key);
+        break;
+    case HT_BATCH_DELETE:
+        if (item == NULL) break;
+        *link = item->next;
+        if (filter != NULL) ht_filter_remove(filter, op->key);
+        ht_item_release(table, item, sizeof(ht_item_t), length);
+        HT_STAT(ht_stats.frees++;)
+        break;
+    }
+    return true;
+}
+
+/*
+ * Vykonanie count operácií dávky ops nad tabuľkou.
+ *
+ * Výsledok je rovnaký ako pri postupnom vykonaní operácií v poradí poľa.
+ * Pre každú operáciu sa do found zapíše, či kľúč pred operáciou v tabuľke
+ * bol, a pri nájdenom kľúči operácie get sa do value zapíše jeho hodnota.
+ * Dávka neposúva prvky na začiatok zoznamu (HT_MOVE_TO_FRONT) a nezapočíta
+ * sa do štatistík hľadania.
+ *
+ * Pri nedostatku pamäte vráti funkcia hodnotu false; operácie vykonané do
+ * toho okamihu v tabuľke zostanú.
+ */
+bool ht_batch(ht_table_t *table, ht_batch_op_t ops[], size_t count) {
+    if (count == 0) return true;
+
+    int *index = malloc(count * sizeof(int));
+    unsigned *length = malloc(count * sizeof(unsigned));
+    size_t *order = malloc(count * sizeof(size_t));
+    if (index == NULL || length == NULL || order == NULL) {
+        free(index);
+        free(length);
+        free(order);
+        return false;
+    }
+
+    size_t start[MAX_HT_SIZE + 1] = {0};
+    for (size_t i = 0; i < count; i++) {
+        size_t key_length;
+        index[i] = ht_key_sum(ops[i].key, &key_length) % HT_SIZE;
+        length[i] = (unsigned)key_length;
+        start[index[i] + 1]++;
+    }
+    for (int bucket = 0; bucket < HT_SIZE; bucket++) {
+        start[bucket + 1] += start[bucket];
+    }
+
+    size_t position[MAX_HT_SIZE];
+    for (int bucket = 0; bucket < HT_SIZE; bucket++) {
+        position[bucket] = start[bucket];
+    }
+    for (size_t i = 0; i < count; i++) {
+        order[position[index[i]]++] = i;
+    }
+
+    ht_filter_t *filter = ht_filter_find(table);
+    bool ok = true;
+    for (size_t o = 0; ok && o < count;) {
+        int bucket = index[order[o]];
+        size_t end = start[bucket + 1];
+
+        if (end < count) {
+            ht_item_t *next = (*table)[index[order[end]]];
+            if (next != NULL) __builtin_prefetch(next);
+            __builtin_prefetch(ops[order[end]].key);
+        }
+        for (; ok && o < end; o++) {
+            ok = batch_apply(table, filter, &ops[order[o]], bucket,
+                             length[order[o]]);
+        }
+    }
+
+    free(index);
+    free(length);
+    free(order);
+    return ok;
+}
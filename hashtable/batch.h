@@ -0,0 +1,35 @@
+/*
+ * Hlavičkový súbor pre dávkové vykonávanie operácií nad tabuľkou
+ * s rozptýlenými položkami.
+ *
+ * Dávka je pole operácií get/insert/delete. Operácie sa zoskupia podľa
+ * indexu v tabuľke a vykonajú sa po jednotlivých zoznamoch synonym, takže
+ * náhodný prístup k tabuľke sa zmení na postupný. Výsledky sa zapíšu do
+ * operácií v pôvodnom poradí.
+ */
+
+#ifndef IAL_HASHTABLE_BATCH_H
+#define IAL_HASHTABLE_BATCH_H
+
+#include "hashtable.h"
+#include <stdbool.h>
+#include <stddef.h>
+
+// Druh operácie dávky
+typedef enum ht_batch_type {
+  HT_BATCH_GET,    // ako ht_get
+  HT_BATCH_INSERT, // ako ht_insert
+  HT_BATCH_DELETE  // ako ht_delete
+} ht_batch_type_t;
+
+// Operácia dávky
+typedef struct ht_batch_op {
+  ht_batch_type_t type; // druh operácie
+  char *key;            // kľúč
+  float value;          // vkladaná hodnota, pri get nájdená hodnota
+  bool found;           // výsledok: kľúč v tabuľke pred operáciou bol
+} ht_batch_op_t;
+
+bool ht_batch(ht_table_t *table, ht_batch_op_t ops[], size_t count);
+
+#endif
@@ -0,0 +1,550 @@
+/*
+ * Výkonnostné testy tabuľky s rozptýlenými položkami.
+ *
+ * Spustenie: ./bench [názov testu]
+ * Bez argumentu sa spustia všetky testy.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "hashtable.h"
+#include "batch.h"
+#include "bulk.h"
+#include "column.h"
+#include "filter.h"
+#include "key.h"
+#include "search.h"
+#include "test_util.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define BENCH_KEYS 4096
+
+static double bench_now(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+static unsigned long bench_seed = 42;
+
+static unsigned long bench_random(void) {
+    bench_seed = bench_seed * 6364136223846793005ul + 1442695040888963407ul;
+    return bench_seed >> 33;
+}
+
+/*
+ * Náhodný kľúč z tlačiteľných znakov s dĺžkou z intervalu <min,max>.
+ */
+static char *bench_key(size_t min, size_t max) {
+    size_t length = min + bench_random() % (max - min + 1);
+    char *key = malloc(length + 1);
+    for (size_t i = 0; i < length; i++) {
+        key[i] = (char)(' ' + 1 + bench_random() % 94);
+    }
+    key[length] = '\0';
+    return key;
+}
+
+static void bench_free_keys(char **keys, int count) {
+    for (int i = 0; i < count; i++) {
+        free(keys[i]);
+    }
+    free(keys);
+}
+
+static int bench_key_sum(const char *key, size_t *length) {
+    return ht_key_sum(key, length);
+}
+
+// ht_key_sum s priamym súčtom krátkych kľúčov a vybranou implementáciou
+static const ht_key_ops_t bench_dispatch = {"ht_key", bench_key_sum};
+
+/*
+ * Súčet kľúčov pre jednotlivé implementácie a dĺžky kľúčov.
+ */
+static void bench_key_ops(void) {
+    static const size_t buckets[][2] = {
+        {1, 7}, {8, 15}, {16, 31}, {32, 63}, {64, 127}, {128, 511}};
+    const ht_key_ops_t *ops[] = {
+        &HT_KEY_SCALAR, &bench_dispatch,
+#if defined(__x86_64__) || defined(__i386__)
+        &HT_KEY_SSE2,  &HT_KEY_AVX2,
+#endif
+    };
+    const int rounds = 200;
+
+    printf("%-10s %-8s %12s\n", "length", "kernel", "sum ns/key");
+
+    for (size_t b = 0; b < sizeof(buckets) / sizeof(buckets[0]); b++) {
+        char **keys = malloc(BENCH_KEYS * sizeof(char *));
+        for (int i = 0; i < BENCH_KEYS; i++) {
+            keys[i] = bench_key(buckets[b][0], buckets[b][1]);
+        }
+
+        for (size_t k = 0; k < sizeof(ops) / sizeof(ops[0]); k++) {
+            if (ops[k] != &bench_dispatch && !ht_key_supported(ops[k]))
+                continue;
+
+            volatile long sink = 0;
+            double start = bench_now();
+            for (int r = 0; r < rounds; r++) {
+                for (int i = 0; i < BENCH_KEYS; i++) {
+                    size_t length;
+                    sink += ops[k]->sum(keys[i], &length) + (long)length;
+                }
+            }
+            double sum_time = bench_now() - start;
+
+            char label[32];
+            snprintf(label, sizeof(label), "%zu-%zu", buckets[b][0],
+                     buckets[b][1]);
+            printf("%-10s %-8s %12.2f\n", label, ops[k]->name,
+                   sum_time * 1e9 / (rounds * BENCH_KEYS));
+            (void)sink;
+        }
+
+        bench_free_keys(keys, BENCH_KEYS);
+    }
+    printf("\n");
+}
+
+/*
+ * Pôvodné vyhľadanie a vloženie s get_hash (strlen a súčet v dvoch
+ * prechodoch) ako základ pre porovnanie s ht_get a ht_insert.
+ */
+static int legacy_hash(const char *key) {
+    int result = 1;
+    int length = strlen(key);
+    for (int i = 0; i < length; i++) {
+        result += key[i];
+    }
+    return result % HT_SIZE;
+}
+
+__attribute__((noinline)) static float *
+legacy_get(ht_table_t *table, char *key) {
+    for (ht_item_t *item = (*table)[legacy_hash(key)]; item != NULL;
+         item = item->next) {
+        if (strcmp(item->key, key) == 0) return &item->value;
+    }
+    return NULL;
+}
+
+__attribute__((noinline)) static void
+legacy_insert(ht_table_t *table, char *key, float value) {
+    float *found = legacy_get(table, key);
+    if (found != NULL) {
+        *found = value;
+        return;
+    }
+    int index = legacy_hash(key);
+    ht_item_t *item = malloc(sizeof(ht_item_t));
+    *item = (ht_item_t){key, value, (*table)[index]};
+    (*table)[index] = item;
+}
+
+static void legacy_delete_all(ht_table_t *table) {
+    for (int i = 0; i < HT_SIZE; i++) {
+        while ((*table)[i] != NULL) {
+            ht_item_t *next = (*table)[i]->next;
+            free((*table)[i]);
+            (*table)[i] = next;
+        }
+    }
+}
+
+/*
+ * Vkladanie a vyhľadávanie cez ht_insert a ht_get oproti pôvodnému get_hash
+ * pri rôznych dĺžkach kľúčov. Počet kľúčov zodpovedá počtu riadkov tabuľky,
+ * aby čas neurčovala dĺžka zoznamov synonym.
+ */
+static void bench_get_insert(void) {
+    static const size_t buckets[][2] = {
+        {1, 7}, {8, 15}, {16, 31}, {32, 63}, {64, 127}};
+    const int count = MAX_HT_SIZE;
+    const int rounds = 2000;
+    ht_table_t *table = malloc(sizeof(ht_table_t));
+    HT_SIZE = MAX_HT_SIZE;
+
+    printf("%-10s %14s %14s %14s %14s\n", "length", "legacy ins ns",
+           "insert ns", "legacy get ns", "get ns");
+
+    for (size_t b = 0; b < sizeof(buckets) / sizeof(buckets[0]); b++) {
+        char **keys = malloc(count * sizeof(char *));
+        for (int i = 0; i < count; i++) {
+            keys[i] = bench_key(buckets[b][0], buckets[b][1]);
+        }
+
+        volatile long sink = 0;
+        double legacy_ins = 0, legacy_get_time = 0, ins = 0, get = 0;
+        for (int r = 0; r < rounds; r++) {
+            ht_init(table);
+            double start = bench_now();
+            for (int i = 0; i < count; i++) {
+                legacy_insert(table, keys[i], (float)i);
+            }
+            legacy_ins += bench_now() - start;
+            start = bench_now();
+            for (int i = 0; i < count; i++) {
+                sink += legacy_get(table, keys[i]) != NULL;
+            }
+            legacy_get_time += bench_now() - start;
+            legacy_delete_all(table);
+
+            ht_init(table);
+            start = bench_now();
+            for (int i = 0; i < count; i++) {
+                ht_insert(table, keys[i], (float)i);
+            }
+            ins += bench_now() - start;
+            start = bench_now();
+            for (int i = 0; i < count; i++) {
+                sink += ht_get(table, keys[i]) != NULL;
+            }
+            get += bench_now() - start;
+            ht_delete_all(table);
+        }
+        (void)sink;
+
+        char label[32];
+        double scale = 1e9 / ((double)rounds * count);
+        snprintf(label, sizeof(label), "%zu-%zu", buckets[b][0],
+                 buckets[b][1]);
+        printf("%-10s %14.2f %14.2f %14.2f %14.2f\n", label,
+               legacy_ins * scale, ins * scale, legacy_get_time * scale,
+               get * scale);
+        bench_free_keys(keys, count);
+    }
+    printf("\n");
+    free(table);
+}
+
+/*
+ * Hromadné vkladanie: ht_insert_many oproti ht_insert_bulk pri rôznom počte
+ * vlákien.
+ */
+static void bench_insert_bulk(void) {
+    const int count = 50000;
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    ht_item_t *items = malloc(count * sizeof(ht_item_t));
+    for (int i = 0; i < count; i++) {
+        items[i] = (ht_item_t){bench_key(8, 24), (float)i};
+    }
+
+    ht_table_t *table = malloc(sizeof(ht_table_t));
+    HT_SIZE = MAX_HT_SIZE;
+
+    ht_init(table);
+    double start = bench_now();
+    ht_insert_many(table, items, count);
+    double serial = bench_now() - start;
+    ht_delete_all(table);
+
+    printf("%-8s %12s %10s\n", "threads", "items/s", "speedup");
+    printf("%-8s %12.0f %10.2f\n", "serial", count / serial, 1.0);
+
+    for (long threads = 1; threads <= (cores > 1 ? cores : 1); threads *= 2) {
+        ht_init(table);
+        start = bench_now();
+        ht_insert_bulk(table, items, count, (int)threads);
+        double parallel = bench_now() - start;
+        ht_delete_all(table);
+        printf("%-8ld %12.0f %10.2f\n", threads, count / parallel,
+               serial / parallel);
+    }
+    printf("\n");
+
+    for (int i = 0; i < count; i++) {
+        free(items[i].key);
+    }
+    free(items);
+    free(table);
+}
+
+/*
+ * Súčet všetkých hodnôt: ht_reduce nad reťazcami synonym oproti
+ * ht_column_reduce nad súvislým poľom hodnôt.
+ */
+static void bench_reduce(void) {
+    const int count = 200000;
+    const int rounds = 50;
+    ht_table_t *table = malloc(sizeof(ht_table_t));
+    ht_column_t *column = malloc(sizeof(ht_column_t));
+    char **keys = malloc(count * sizeof(char *));
+    HT_SIZE = MAX_HT_SIZE;
+
+    ht_init(table);
+    ht_column_init(column);
+    for (int i = 0; i < count; i++) {
+        keys[i] = bench_key(8, 24);
+        float value = (float)(bench_random() % 1000) / 10;
+        ht_insert(table, keys[i], value);
+        ht_column_insert(column, keys[i], value);
+    }
+
+    volatile double sink = 0;
+    double start = bench_now();
+    for (int r = 0; r < rounds; r++) {
+        sink += ht_reduce(table, HT_REDUCE_SUM);
+    }
+    double chained = bench_now() - start;
+
+    start = bench_now();
+    for (int r = 0; r < rounds; r++) {
+        sink += ht_column_reduce(column, HT_REDUCE_SUM);
+    }
+    double columnar = bench_now() - start;
+    (void)sink;
+
+    printf("%-10s %14s %10s\n", "layout", "values/s", "speedup");
+    printf("%-10s %14.0f %10.2f\n", "chained",
+           rounds * (double)column->count / chained, 1.0);
+    printf("%-10s %14.0f %10.2f\n", "columnar",
+           rounds * (double)column->count / columnar, chained / columnar);
+    printf("\n");
+
+    ht_delete_all(table);
+    ht_column_dispose(column);
+    bench_free_keys(keys, count);
+    free(column);
+    free(table);
+}
+
+/*
+ * Vyhľadávanie pri rôznom podiele chýbajúcich kľúčov bez filtra a s
+ * pripojeným filtrom.
+ */
+static void bench_filter(void) {
+    const int count = 20000;
+    const int lookups = 200000;
+    const int miss_percents[] = {0, 50, 90, 99};
+    ht_table_t *table = malloc(sizeof(ht_table_t));
+    char **present = malloc(count * sizeof(char *));
+    char **missing = malloc(count * sizeof(char *));
+    HT_SIZE = MAX_HT_SIZE;
+
+    ht_init(table);
+    for (int i = 0; i < count; i++) {
+        present[i] = bench_key(8, 24);
+        missing[i] = bench_key(8, 24);
+        ht_insert(table, present[i], (float)i);
+    }
+
+    ht_filter_t filter;
+    ht_filter_init(&filter, count, 0.01);
+    printf("filter: %zu bytes, %d hashes\n", ht_filter_memory(&filter),
+           filter.hashes);
+    printf("%-8s %14s %14s %10s\n", "misses%", "plain get/s", "filter get/s",
+           "speedup");
+
+    for (size_t m = 0; m < sizeof(miss_percents) / sizeof(int); m++) {
+        char **keys = malloc(lookups * sizeof(char *));
+        for (int i = 0; i < lookups; i++) {
+            int k = (int)(bench_random() % count);
+            keys[i] = (int)(bench_random() % 100) < miss_percents[m]
+                          ? missing[k]
+                          : present[k];
+        }
+
+        volatile long sink = 0;
+        double start = bench_now();
+        for (int i = 0; i < lookups; i++) {
+            sink += ht_get(table, keys[i]) != NULL;
+        }
+        double plain = bench_now() - start;
+
+        ht_filter_attach(table, &filter);
+        start = bench_now();
+        for (int i = 0; i < lookups; i++) {
+            sink += ht_get(table, keys[i]) != NULL;
+        }
+        double filtered = bench_now() - start;
+        ht_filter_detach(table);
+        (void)sink;
+
+        printf("%-8d %14.0f %14.0f %10.2f\n", miss_percents[m],
+               lookups / plain, lookups / filtered, plain / filtered);
+        free(keys);
+    }
+    printf("\n");
+
+    ht_filter_dispose(&filter);
+    ht_delete_all(table);
+    bench_free_keys(present, count);
+    bench_free_keys(missing, count);
+    free(table);
+}
+
+/*
+ * Vyhľadávanie s presunom nájdeného prvku na začiatok zoznamu synonym a
+ * bez neho pri rovnomernom a Zipfovom (s = 1) rozdelení hľadaných kľúčov.
+ * Poradie kľúčov podľa obľúbenosti je náhodné.
+ */
+static void bench_move_to_front(void) {
+    const int count = 20000;
+    const int lookups = 500000;
+    ht_table_t *table = malloc(sizeof(ht_table_t));
+    char **keys = malloc(count * sizeof(char *));
+    char **order = malloc(lookups * sizeof(char *));
+    double *cdf = malloc(count * sizeof(double));
+    HT_SIZE = MAX_HT_SIZE;
+
+    for (int i = 0; i < count; i++) {
+        keys[i] = bench_key(8, 24);
+    }
+
+    printf("%-8s %14s %14s %10s\n", "access", "plain get/s", "mtf get/s",
+           "speedup");
+    for (int zipf = 0; zipf <= 1; zipf++) {
+        double total = 0;
+        for (int i = 0; i < count; i++) {
+            total += zipf ? 1.0 / (i + 1) : 1.0;
+            cdf[i] = total;
+        }
+        for (int i = 0; i < lookups; i++) {
+            double sample = (double)bench_random() / (1ul << 31) * total;
+            int low = 0, high = count - 1;
+            while (low < high) {
+                int middle = (low + high) / 2;
+                if (cdf[middle] < sample) {
+                    low = middle + 1;
+                } else {
+                    high = middle;
+                }
+            }
+            order[i] = keys[low];
+        }
+
+        double times[2];
+        for (int mtf = 0; mtf <= 1; mtf++) {
+            ht_init(table);
+            for (int i = 0; i < count; i++) {
+                ht_insert(table, keys[i], (float)i);
+            }
+
+            HT_MOVE_TO_FRONT = mtf;
+            volatile long sink = 0;
+            double start = bench_now();
+            for (int i = 0; i < lookups; i++) {
+                sink += ht_get(table, order[i]) != NULL;
+            }
+            times[mtf] = bench_now() - start;
+            HT_MOVE_TO_FRONT = false;
+            (void)sink;
+            ht_delete_all(table);
+        }
+
+        printf("%-8s %14.0f %14.0f %10.2f\n", zipf ? "zipf" : "uniform",
+               lookups / times[0], lookups / times[1], times[0] / times[1]);
+    }
+    printf("\n");
+
+    bench_free_keys(keys, count);
+    free(order);
+    free(cdf);
+    free(table);
+}
+
+/*
+ * Zmiešané operácie (80 % get, 10 % insert, 10 % delete) nad náhodnými
+ * kľúčmi: postupné volania ht_* oproti dávkam rôznej veľkosti.
+ */
+static void bench_batch(void) {
+    const int count = 20000;
+    const int operations = 1000000;
+    const int batch_sizes[] = {64, 1024, 16384};
+    ht_table_t *table = malloc(sizeof(ht_table_t));
+    char **keys = malloc(count * sizeof(char *));
+    ht_batch_op_t *ops = malloc(operations * sizeof(ht_batch_op_t));
+    HT_SIZE = MAX_HT_SIZE;
+
+    for (int i = 0; i < count; i++) {
+        keys[i] = bench_key(8, 24);
+    }
+    for (int i = 0; i < operations; i++) {
+        int kind = (int)(bench_random() % 10);
+        ops[i].type = kind < 8   ? HT_BATCH_GET
+                      : kind < 9 ? HT_BATCH_INSERT
+                                 : HT_BATCH_DELETE;
+        ops[i].key = keys[bench_random() % count];
+        ops[i].value = (float)i;
+    }
+
+    ht_init(table);
+    for (int i = 0; i < count; i += 2) {
+        ht_insert(table, keys[i], (float)i);
+    }
+    volatile long sink = 0;
+    double start = bench_now();
+    for (int i = 0; i < operations; i++) {
+        switch (ops[i].type) {
+        case HT_BATCH_GET:
+            sink += ht_get(table, ops[i].key) != NULL;
+            break;
+        case HT_BATCH_INSERT:
+            ht_insert(table, ops[i].key, ops[i].value);
+            break;
+        case HT_BATCH_DELETE:
+            ht_delete(table, ops[i].key);
+            break;
+        }
+    }
+    double serial = bench_now() - start;
+    (void)sink;
+    ht_delete_all(table);
+
+    printf("%-8s %14s %10s\n", "batch", "ops/s", "speedup");
+    printf("%-8s %14.0f %10.2f\n", "serial", operations / serial, 1.0);
+    for (size_t b = 0; b < sizeof(batch_sizes) / sizeof(int); b++) {
+        ht_init(table);
+        for (int i = 0; i < count; i += 2) {
+            ht_insert(table, keys[i], (float)i);
+        }
+        start = bench_now();
+        for (int i = 0; i < operations; i += batch_sizes[b]) {
+            int size = operations - i < batch_sizes[b] ? operations - i
+                                                       : batch_sizes[b];
+            ht_batch(table, ops + i, size);
+        }
+        double batched = bench_now() - start;
+        printf("%-8d %14.0f %10.2f\n", batch_sizes[b], operations / batched,
+               serial / batched);
+        ht_delete_all(table);
+    }
+    printf("\n");
+
+    bench_free_keys(keys, count);
+    free(ops);
+    free(table);
+}
+
+typedef struct {
+    const char *name;
+    void (*run)(void);
+} bench_t;
+
+static const bench_t BENCHMARKS[] = {
+    {"key_ops", bench_key_ops},
+    {"get_insert", bench_get_insert},
+    {"insert_bulk", bench_insert_bulk},
+    {"reduce", bench_reduce},
+    {"filter", bench_filter},
+    {"move_to_front", bench_move_to_front},
+    {"batch", bench_batch},
+};
+
+int main(int argc, char *argv[]) {
+    init_uninitialized_item();
+
+    for (size_t i = 0; i < sizeof(BENCHMARKS) / sizeof(BENCHMARKS[0]); i++) {
+        if (argc > 1 && strcmp(argv[1], BENCHMARKS[i].name) != 0) continue;
+        printf("[%s]\n", BENCHMARKS[i].name);
+        BENCHMARKS[i].run();
+    }
+
+    free(uninitialized_item);
+}
@@ -0,0 +1,225 @@
+/*
+ * Paralelné hromadné vkladanie do tabuľky s rozptýlenými položkami
+ *
+ * Vkladanie prebieha v troch fázach, každá na všetkých vláknach:
+ *   1. každé vlákno spočíta rozptyľovací súčet pre svoju časť vstupu a
+ *      histogram položiek podľa vlákna, ktorému patrí ich index v tabuľke,
+ *   2. podľa prefixových súčtov histogramov rozdelí vlákno svoje položky
+ *      do súvislých úsekov jednotlivých vlastníkov,
+ *   3. každé vlákno vloží položky svojho úseku do vlastného rozsahu indexov.
+ *
+ * Rozsahy indexov sa neprekrývajú, takže reťazce synonym sa budujú bez
+ * zámkov. Poradie položiek jedného vlastníka zostáva zachované, preto pri
+ * opakovanom kľúči platí posledná hodnota rovnako ako pri ht_insert.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "bulk.h"
+#include "filter.h"
+#include "key.h"
+#include "memory.h"
+#include "stats.h"
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct bulk {
+    ht_table_t *table;
+    const ht_item_t *items;
+    int count;
+    int threads;
+    int *index;        // index v tabuľke pre každú položku
+    unsigned *length;  // dĺžka kľúča pre každú položku
+    int *histogram;    // histogram[vlákno * threads + vlastník]
+    int *order;        // položky zoradené podľa vlastníka
+    int *owner_start;  // začiatok úseku vlastníka v poli order
+    bool *added;       // položka vytvorila nový prvok (iba s filtrom)
+} bulk_t;
+
+typedef struct bulk_worker {
+    bulk_t *bulk;
+    int id;
+    unsigned long allocations;
+    long key_bytes;
+    unsigned long rejections;  // prvky, pre ktoré vlákno nedostalo pamäť
+} bulk_worker_t;
+
+static int bulk_owner(bulk_t *bulk, int index) {
+    return (int)((long)index * bulk->threads / HT_SIZE);
+}
+
+static int bulk_slice(bulk_t *bulk, int id) {
+    return (int)((long)bulk->count * id / bulk->threads);
+}
+
+static void *bulk_hash(void *arg) {
+    bulk_worker_t *worker = arg;
+    bulk_t *bulk = worker->bulk;
+    int *histogram = bulk->histogram + worker->id * bulk->threads;
+
+    for (int i = bulk_slice(bulk, worker->id);
+         i < bulk_slice(bulk, worker->id + 1); i++) {
+        size_t length;
+        bulk->index[i] = ht_key_sum(bulk->items[i].key, &length) % HT_SIZE;
+        bulk->length[i] = (unsigned)length;
+        histogram[bulk_owner(bulk, bulk->index[i])]++;
+    }
+    return NULL;
+}
+
+static void *bulk_scatter(void *arg) {
+    bulk_worker_t *worker = arg;
+    bulk_t *bulk = worker->bulk;
+    int *position = bulk->histogram + worker->id * bulk->threads;
+
+    for (int i = bulk_slice(bulk, worker->id);
+         i < bulk_slice(bulk, worker->id + 1); i++) {
+        bulk->order[position[bulk_owner(bulk, bulk->index[i])]++] = i;
+    }
+    return NULL;
+}
+
+static void *bulk_build(void *arg) {
+    bulk_worker_t *worker = arg;
+    bulk_t *bulk = worker->bulk;
+    ht_table_t *table = bulk->table;
+
+    for (int o = bulk->owner_start[worker->id];
+         o < bulk->owner_start[worker->id + 1]; o++) {
+        int i = bulk->order[o];
+        ht_item_t *item = (*table)[bulk->index[i]];
+
+        while (item != NULL &&
+               strcmp(item->key, bulk->items[i].key) != 0) {
+            item = item->next;
+        }
+        if (item != NULL) {
+            item->value = bulk->items[i].value;
+            continue;
+        }
+
+        item = ht_allocate(sizeof(ht_item_t));
+        if (item == NULL) {
+            worker->rejections++;
+            continue;
+        }
+        worker->allocations++;
+        worker->key_bytes += bulk->length[i] + 1;
+        item->key = bulk->items[i].key;
+        item->value = bulk->items[i].value;
+        item->next = (*table)[bulk->index[i]];
+        (*table)[bulk->index[i]] = item;
+        if (bulk->added != NULL) bulk->added[i] = true;
+    }
+    return NULL;
+}
+
+/*
+ * Spustenie fázy na všetkých vláknach; nulté vlákno je volajúce.
+ */
+static void bulk_run(bulk_t *bulk, bulk_worker_t *workers,
+                     pthread_t *handles, void *(*phase)(void *)) {
+    int started = 1;
+    for (; started < bulk->threads; started++) {
+        if (pthread_create(&handles[started], NULL, phase,
+                           &workers[started]) != 0) {
+            break;
+        }
+    }
+    // Časti nespustených vlákien spracuje volajúce vlákno
+    for (int id = started; id < bulk->threads; id++) {
+        phase(&workers[id]);
+    }
+    phase(&workers[0]);
+
+    for (int id = 1; id < started; id++) {
+        pthread_join(handles[id], NULL);
+    }
+}
+
+/*
+ * Hromadné vloženie count prvkov do tabuľky pomocou threads vlákien.
+ *
+ * Výsledok je rovnaký ako pri postupnom volaní ht_insert pre všetky prvky.
+ * Tabuľka sa počas vkladania nesmie súčasne používať. Pripojený filter
+ * (filter.h) sa doplní po skončení vlákien.
+ *
+ * Pri nedostatku pamäte vráti funkcia hodnotu false; prvky, pre ktoré sa
+ * pamäť nenašla, sa rovnako ako pri ht_insert vynechajú a ostatné sa vložia.
+ */
+bool ht_insert_bulk(ht_table_t *table, const ht_item_t items[], int count,
+                    int threads) {
+    if (count <= 0) return true;
+    if (threads < 1) threads = 1;
+    if (threads > HT_SIZE) threads = HT_SIZE;
+    if (threads > count) threads = count;
+
+    bulk_t bulk = {
+        .table = table,
+        .items = items,
+        .count = count,
+        .threads = threads,
+        .index = malloc(count * sizeof(int)),
+        .length = malloc(count * sizeof(unsigned)),
+        .histogram = calloc((size_t)threads * threads, sizeof(int)),
+        .order = malloc(count * sizeof(int)),
+        .owner_start = malloc((threads + 1) * sizeof(int)),
+    };
+    ht_filter_t *filter = ht_filter_find(table);
+    if (filter != NULL) bulk.added = calloc(count, sizeof(bool));
+    bulk_worker_t *workers = malloc(threads * sizeof(bulk_worker_t));
+    pthread_t *handles = malloc(threads * sizeof(pthread_t));
+
+    bool ok = bulk.index != NULL && bulk.length != NULL &&
+              bulk.histogram != NULL && bulk.order != NULL &&
+              bulk.owner_start != NULL && workers != NULL && handles != NULL &&
+              (filter == NULL || bulk.added != NULL);
+
+    if (ok) {
+        for (int id = 0; id < threads; id++) {
+            workers[id] = (bulk_worker_t){&bulk, id, 0, 0, 0};
+        }
+
+        bulk_run(&bulk, workers, handles, bulk_hash);
+
+        // Histogramy sa nahradia začiatočnými pozíciami pre zápis
+        int position = 0;
+        for (int owner = 0; owner < threads; owner++) {
+            bulk.owner_start[owner] = position;
+            for (int id = 0; id < threads; id++) {
+                int *cell = &bulk.histogram[id * threads + owner];
+                int size = *cell;
+                *cell = position;
+                position += size;
+            }
+        }
+        bulk.owner_start[threads] = position;
+
+        bulk_run(&bulk, workers, handles, bulk_scatter);
+        bulk_run(&bulk, workers, handles, bulk_build);
+
+        for (int i = 0; filter != NULL && i < count; i++) {
+            if (bulk.added[i]) ht_filter_add(filter, items[i].key);
+        }
+
+        // Počítadlá a príznaky vlákien sa sčítajú až po ich skončení
+        for (int id = 0; id < threads; id++) {
+            if (workers[id].rejections > 0) ok = false;
+            HT_STAT(ht_stats.allocations += workers[id].allocations;)
+            ht_memory_account(table, sizeof(ht_item_t),
+                              (long)workers[id].allocations,
+                              workers[id].key_bytes, workers[id].rejections);
+        }
+    }
+
+    free(handles);
+    free(workers);
+    free(bulk.added);
+    free(bulk.owner_start);
+    free(bulk.order);
+    free(bulk.histogram);
+    free(bulk.length);
+    free(bulk.index);
+    return ok;
+}
@@ -0,0 +1,15 @@
+/*
+ * Hlavičkový súbor pre paralelné hromadné vkladanie do tabuľky s rozptýlenými
+ * položkami.
+ */
+
+#ifndef IAL_HASHTABLE_BULK_H
+#define IAL_HASHTABLE_BULK_H
+
+#include "hashtable.h"
+#include <stdbool.h>
+
+bool ht_insert_bulk(ht_table_t *table, const ht_item_t items[], int count,
+                    int threads);
+
+#endif
@@ -0,0 +1,207 @@
+/*
+ * LRU cache nad tabuľkou s rozptýlenými položkami
+ *
+ * Záznamy tvoria obojsmerne zreťazený zoznam od naposledy použitého po
+ * najdlhšie nepoužitý. Zásah presunie záznam na začiatok zoznamu, vloženie
+ * do plnej cache použije pamäť vytlačeného záznamu pre nový prvok.
+ */
+
+#include "cache.h"
+#include "filter.h"
+#include "key.h"
+#include "memory.h"
+#include "stats.h"
+#include <stdlib.h>
+#include <string.h>
+
+static void cache_detach(ht_cache_t *cache, ht_cache_entry_t *entry) {
+    if (entry->newer != NULL) {
+        entry->newer->older = entry->older;
+    } else {
+        cache->newest = entry->older;
+    }
+    if (entry->older != NULL) {
+        entry->older->newer = entry->newer;
+    } else {
+        cache->oldest = entry->newer;
+    }
+}
+
+static void cache_attach(ht_cache_t *cache, ht_cache_entry_t *entry) {
+    entry->newer = NULL;
+    entry->older = cache->newest;
+    if (cache->newest != NULL) {
+        cache->newest->newer = entry;
+    } else {
+        cache->oldest = entry;
+    }
+    cache->newest = entry;
+}
+
+/*
+ * Vyňatie záznamu z reťazca synonym. Záznam zostáva alokovaný, funkcia
+ * vráti dĺžku jeho kľúča.
+ */
+static size_t cache_unlink(ht_cache_t *cache, ht_cache_entry_t *entry) {
+    size_t length;
+    int index = ht_key_sum(entry->item.key, &length) % HT_SIZE;
+    ht_item_t **link = &(*cache->table)[index];
+
+    while (*link != &entry->item) {
+        link = &(*link)->next;
+    }
+    *link = entry->item.next;
+
+    ht_filter_t *filter = ht_filter_find(cache->table);
+    if (filter != NULL) ht_filter_remove(filter, entry->item.key);
+    return length;
+}
+
+/*
+ * Zaradenie záznamu s kľúčom key do tabuľky. Funkcia vráti dĺžku kľúča.
+ */
+static size_t cache_link(ht_cache_t *cache, ht_cache_entry_t *entry, char *key,
+                         float value) {
+    size_t length;
+    int index = ht_key_sum(key, &length) % HT_SIZE;
+
+    entry->item.key = key;
+    entry->item.value = value;
+    entry->item.next = (*cache->table)[index];
+    (*cache->table)[index] = &entry->item;
+
+    ht_filter_t *filter = ht_filter_find(cache->table);
+    if (filter != NULL) ht_filter_add(filter, key);
+    return length;
+}
+
+static void cache_release(ht_cache_t *cache, ht_cache_entry_t *entry,
+                          ht_cache_reason_t reason) {
+    if (cache->on_remove != NULL) {
+        cache->on_remove(&entry->item, reason, cache->context);
+    }
+}
+
+/*
+ * Inicializácia prázdnej cache nad tabuľkou table s kapacitou capacity
+ * prvkov. Tabuľka sa inicializuje funkciou ht_init.
+ *
+ * Funkcia on_remove (môže byť NULL) sa zavolá pre každý prvok, ktorý cache
+ * odstraňuje, keď už prvok nie je v tabuľke; môže teda uvoľniť jeho kľúč.
+ */
+void ht_cache_init(ht_cache_t *cache, ht_table_t *table, size_t capacity,
+                   ht_cache_remove_t on_remove, void *context) {
+    ht_init(table);
+    cache->table = table;
+    cache->capacity = capacity;
+    cache->count = 0;
+    cache->newest = NULL;
+    cache->oldest = NULL;
+    cache->on_remove = on_remove;
+    cache->context = context;
+    cache->hits = 0;
+    cache->misses = 0;
+    cache->evictions = 0;
+}
+
+/*
+ * Získanie hodnoty z cache.
+ *
+ * V prípade úspechu označí prvok ako naposledy použitý a vráti ukazovateľ na
+ * jeho hodnotu, v opačnom prípade vráti hodnotu NULL.
+ */
+float *ht_cache_get(ht_cache_t *cache, char *key) {
+    ht_item_t *item = ht_search(cache->table, key);
+
+    if (item == NULL) {
+        cache->misses++;
+        return NULL;
+    }
+
+    ht_cache_entry_t *entry = (ht_cache_entry_t *)item;
+    if (cache->newest != entry) {
+        cache_detach(cache, entry);
+        cache_attach(cache, entry);
+    }
+    cache->hits++;
+    return &item->value;
+}
+
+/*
+ * Vloženie prvku do cache.
+ *
+ * Pokiaľ prvok s daným kľúčom už existuje, nahradí sa jeho hodnota. Nový
+ * prvok do plnej cache vytlačí najdlhšie nepoužitý prvok. Vložený prvok je
+ * vždy označený ako naposledy použitý. Pri nulovej kapacite funkcia nerobí
+ * nič.
+ */
+void ht_cache_put(ht_cache_t *cache, char *key, float value) {
+    ht_item_t *item = ht_search(cache->table, key);
+    ht_cache_entry_t *entry;
+
+    if (item != NULL) {
+        entry = (ht_cache_entry_t *)item;
+        item->value = value;
+        cache_detach(cache, entry);
+    } else if (cache->capacity == 0) {
+        return;
+    } else if (cache->count == cache->capacity) {
+        entry = cache->oldest;
+        cache_detach(cache, entry);
+        size_t evicted = cache_unlink(cache, entry);
+        cache_release(cache, entry, HT_CACHE_EVICTED);
+        size_t length = cache_link(cache, entry, key, value);
+        ht_memory_account(cache->table, sizeof(ht_cache_entry_t), 0,
+                          (long)length - (long)evicted, 0);
+        cache->evictions++;
+    } else {
+        entry = ht_item_allocate(cache->table, sizeof(ht_cache_entry_t),
+                                 strlen(key));
+        if (entry == NULL) return;
+        HT_STAT(ht_stats.allocations++;)
+        cache_link(cache, entry, key, value);
+        cache->count++;
+    }
+    cache_attach(cache, entry);
+}
+
+/*
+ * Odstránenie prvku z cache.
+ *
+ * V prípade úspechu vráti funkcia hodnotu true, pokiaľ prvok neexistuje,
+ * vráti hodnotu false.
+ */
+bool ht_cache_remove(ht_cache_t *cache, char *key) {
+    ht_item_t *item = ht_search(cache->table, key);
+    if (item == NULL) return false;
+
+    ht_cache_entry_t *entry = (ht_cache_entry_t *)item;
+    cache_detach(cache, entry);
+    size_t length = cache_unlink(cache, entry);
+    cache_release(cache, entry, HT_CACHE_REMOVED);
+    ht_item_release(cache->table, entry, sizeof(*entry), length);
+    HT_STAT(ht_stats.frees++;)
+    cache->count--;
+    return true;
+}
+
+/*
+ * Odstránenie všetkých prvkov cache od najdlhšie nepoužitého. Štatistiky
+ * zásahov zostávajú zachované.
+ *
+ * Každý záznam sa pred zavolaním on_remove vyradí zo zoznamu aj z tabuľky
+ * rovnako ako v ht_cache_remove, funkcia on_remove teda vidí iba platné
+ * záznamy.
+ */
+void ht_cache_clear(ht_cache_t *cache) {
+    while (cache->oldest != NULL) {
+        ht_cache_entry_t *entry = cache->oldest;
+        cache_detach(cache, entry);
+        size_t length = cache_unlink(cache, entry);
+        cache_release(cache, entry, HT_CACHE_CLEARED);
+        ht_item_release(cache->table, entry, sizeof(*entry), length);
+        HT_STAT(ht_stats.frees++;)
+        cache->count--;
+    }
+    ht_init(cache->table);
+}
@@ -0,0 +1,64 @@
+/*
+ * Hlavičkový súbor pre LRU cache nad tabuľkou s rozptýlenými položkami.
+ *
+ * Cache obmedzuje počet prvkov tabuľky a pri jeho prekročení odstráni prvok,
+ * ktorý bol najdlhšie nepoužitý. Prvky cache sú intrusívne: ht_item_t je
+ * prvou položkou záznamu ht_cache_entry_t, takže záznam je zároveň prvkom
+ * reťazca synonym tabuľky a nájdený prvok netreba hľadať v ďalšej štruktúre.
+ * Zásah cache je O(1) a nič nealokuje.
+ *
+ * Kým tabuľku používa cache, smú ju meniť iba funkcie ht_cache_*. Čítať ju
+ * možno aj bežnými funkciami (ht_search, ht_get). Prvky tabuľky možno na
+ * konci uvoľniť aj funkciou ht_delete_all, funkcia on_remove sa však
+ * vtedy nezavolá a uvoľnené záznamy sa v spotrebe pamäte (memory.h)
+ * odpočítajú ako ht_item_t. S vlastným alokátorom preto treba použiť
+ * ht_cache_clear.
+ */
+
+#ifndef IAL_HASHTABLE_CACHE_H
+#define IAL_HASHTABLE_CACHE_H
+
+#include "hashtable.h"
+#include <stdbool.h>
+#include <stddef.h>
+
+// Dôvod odstránenia prvku z cache
+typedef enum ht_cache_reason {
+  HT_CACHE_EVICTED, // vytlačený pri prekročení kapacity
+  HT_CACHE_REMOVED, // odstránený funkciou ht_cache_remove
+  HT_CACHE_CLEARED  // odstránený funkciou ht_cache_clear
+} ht_cache_reason_t;
+
+// Funkcia volaná pri odstránení prvku (napríklad na uvoľnenie kľúča)
+typedef void (*ht_cache_remove_t)(ht_item_t *item, ht_cache_reason_t reason,
+                                  void *context);
+
+// Záznam cache
+typedef struct ht_cache_entry {
+  ht_item_t item;               // prvok tabuľky, musí byť prvý
+  struct ht_cache_entry *newer; // susedia v poradí podľa posledného použitia
+  struct ht_cache_entry *older;
+} ht_cache_entry_t;
+
+// Cache
+typedef struct ht_cache {
+  ht_table_t *table;
+  size_t capacity;            // maximálny počet prvkov
+  size_t count;               // aktuálny počet prvkov
+  ht_cache_entry_t *newest;   // naposledy použitý prvok
+  ht_cache_entry_t *oldest;   // najdlhšie nepoužitý prvok
+  ht_cache_remove_t on_remove;
+  void *context;              // argument funkcie on_remove
+  unsigned long hits;         // úspešné volania ht_cache_get
+  unsigned long misses;       // neúspešné volania ht_cache_get
+  unsigned long evictions;    // prvky vytlačené pri prekročení kapacity
+} ht_cache_t;
+
+void ht_cache_init(ht_cache_t *cache, ht_table_t *table, size_t capacity,
+                   ht_cache_remove_t on_remove, void *context);
+float *ht_cache_get(ht_cache_t *cache, char *key);
+void ht_cache_put(ht_cache_t *cache, char *key, float value);
+bool ht_cache_remove(ht_cache_t *cache, char *key);
+void ht_cache_clear(ht_cache_t *cache);
+
+#endif
@@ -0,0 +1,242 @@
+/*
+ * Stĺpcová tabuľka s rozptýlenými položkami a agregácie hodnôt
+ *
+ * Agregácia súvislého poľa používa HT_REDUCE_LANES nezávislých
+ * akumulátorov. Sčítanie v pohyblivej rádovej čiarke nie je asociatívne,
+ * prekladač by preto jednoduchý cyklus s jedným akumulátorom nevektorizoval;
+ * nezávislé akumulátory zodpovedajú pruhom vektorového registra a cyklus sa
+ * vektorizuje aj bez -ffast-math. Súčet sa počíta v presnosti double.
+ */
+
+#include "column.h"
+#include "key.h"
+#include "stats.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define HT_REDUCE_LANES 8
+
+static uint32_t *column_find(ht_column_t *column, char *key, size_t *length) {
+    uint32_t *link = &column->buckets[ht_key_sum(key, length) % HT_SIZE];
+    HT_STAT(unsigned probes = 0;)
+
+    while (*link != HT_COLUMN_NONE) {
+        ht_column_item_t *item = &column->items[*link];
+        HT_STAT(probes++;)
+        if (item->key_length == *length &&
+            strcmp(item->key, key) == 0) {
+            break;
+        }
+        link = &item->next;
+    }
+    HT_STAT(ht_stats_search(probes);)
+    return link;
+}
+
+/*
+ * Odkaz na prvok s indexom index v jeho reťazci synonym. Prvok musí byť
+ * v tabuľke.
+ */
+static uint32_t *column_link(ht_column_t *column, uint32_t index) {
+    size_t length;
+    uint32_t *link =
+        &column->buckets[ht_key_sum(column->items[index].key, &length) %
+                         HT_SIZE];
+
+    while (*link != index) {
+        link = &column->items[*link].next;
+    }
+    return link;
+}
+
+static double reduce_identity(ht_reduce_op_t op) {
+    switch (op) {
+    case HT_REDUCE_MIN:
+        return INFINITY;
+    case HT_REDUCE_MAX:
+        return -INFINITY;
+    default:
+        return 0.0;
+    }
+}
+
+static double reduce_step(ht_reduce_op_t op, double result, double value) {
+    switch (op) {
+    case HT_REDUCE_MIN:
+        return value < result ? value : result;
+    case HT_REDUCE_MAX:
+        return value > result ? value : result;
+    default:
+        return result + value;
+    }
+}
+
+/*
+ * Agregácia hodnôt všetkých prvkov bežnej tabuľky.
+ */
+double ht_reduce(ht_table_t *table, ht_reduce_op_t op) {
+    double result = reduce_identity(op);
+
+    for (int i = 0; i < HT_SIZE; i++) {
+        for (ht_item_t *item = (*table)[i]; item != NULL; item = item->next) {
+            result = reduce_step(op, result, item->value);
+        }
+    }
+    return result;
+}
+
+/*
+ * Inicializácia prázdnej stĺpcovej tabuľky.
+ */
+void ht_column_init(ht_column_t *column) {
+    for (int i = 0; i < HT_SIZE; i++) {
+        column->buckets[i] = HT_COLUMN_NONE;
+    }
+    column->items = NULL;
+    column->values = NULL;
+    column->count = 0;
+    column->capacity = 0;
+}
+
+/*
+ * Zrušenie stĺpcovej tabuľky a uvedenie do stavu po inicializácii.
+ */
+void ht_column_dispose(ht_column_t *column) {
+    free(column->items);
+    free(column->values);
+    ht_column_init(column);
+}
+
+/*
+ * Veľkosť pamäte tabuľky v bajtoch vrátane nevyužitej kapacity polí.
+ */
+size_t ht_column_memory(const ht_column_t *column) {
+    return sizeof(ht_column_t) +
+           column->capacity * (sizeof(ht_column_item_t) + sizeof(float));
+}
+
+/*
+ * Získanie hodnoty z tabuľky.
+ *
+ * V prípade úspechu vráti funkcia ukazovateľ na hodnotu prvku, v opačnom
+ * prípade hodnotu NULL. Ukazovateľ je platný do najbližšej zmeny tabuľky.
+ */
+float *ht_column_get(ht_column_t *column, char *key) {
+    size_t length;
+    uint32_t index = *column_find(column, key, &length);
+
+    return index == HT_COLUMN_NONE ? NULL : &column->values[index];
+}
+
+/*
+ * Vloženie prvku do tabuľky.
+ *
+ * Pokiaľ prvok s daným kľúčom už v tabuľke existuje, nahradí sa jeho
+ * hodnota. Funkcia vráti hodnotu false, ak sa nepodarilo zväčšiť polia.
+ */
+bool ht_column_insert(ht_column_t *column, char *key, float value) {
+    size_t length;
+    uint32_t *link = column_find(column, key, &length);
+
+    if (*link != HT_COLUMN_NONE) {
+        column->values[*link] = value;
+        return true;
+    }
+
+    if (column->count == column->capacity) {
+        size_t capacity = column->capacity > 0 ? column->capacity * 2 : 16;
+        if (capacity > HT_COLUMN_NONE) return false;
+
+        ht_column_item_t *items =
+            realloc(column->items, capacity * sizeof(ht_column_item_t));
+        if (items == NULL) return false;
+        column->items = items;
+
+        float *values = realloc(column->values, capacity * sizeof(float));
+        if (values == NULL) return false;
+        column->values = values;
+
+        column->capacity = capacity;
+    }
+
+    // Nový prvok na začiatok reťazca rovnako ako v ht_insert
+    uint32_t index = (uint32_t)column->count++;
+    uint32_t *head = &column->buckets[ht_key_sum(key, &length) % HT_SIZE];
+    column->items[index] =
+        (ht_column_item_t){key, (uint32_t)length, *head};
+    column->values[index] = value;
+    *head = index;
+    return true;
+}
+
+/*
+ * Zmazanie prvku z tabuľky.
+ *
+ * Na miesto zmazaného prvku sa presunie posledný prvok, polia tak zostávajú
+ * súvislé. Pokiaľ prvok neexistuje, funkcia nerobí nič.
+ */
+void ht_column_delete(ht_column_t *column, char *key) {
+    size_t length;
+    uint32_t *link = column_find(column, key, &length);
+    uint32_t index = *link;
+    if (index == HT_COLUMN_NONE) return;
+
+    *link = column->items[index].next;
+
+    uint32_t last = (uint32_t)--column->count;
+    if (index != last) {
+        *column_link(column, last) = index;
+        column->items[index] = column->items[last];
+        column->values[index] = column->values[last];
+    }
+}
+
+/*
+ * Agregácia hodnôt všetkých prvkov stĺpcovej tabuľky.
+ */
+double ht_column_reduce(ht_column_t *column, ht_reduce_op_t op) {
+    const float *values = column->values;
+    size_t count = column->count;
+    size_t bulk = count - count % HT_REDUCE_LANES;
+    double lanes[HT_REDUCE_LANES];
+    double result = reduce_identity(op);
+
+    for (int lane = 0; lane < HT_REDUCE_LANES; lane++) {
+        lanes[lane] = result;
+    }
+
+    switch (op) {
+    case HT_REDUCE_MIN:
+        for (size_t i = 0; i < bulk; i += HT_REDUCE_LANES) {
+            for (int lane = 0; lane < HT_REDUCE_LANES; lane++) {
+                double value = values[i + lane];
+                lanes[lane] = value < lanes[lane] ? value : lanes[lane];
+            }
+        }
+        break;
+    case HT_REDUCE_MAX:
+        for (size_t i = 0; i < bulk; i += HT_REDUCE_LANES) {
+            for (int lane = 0; lane < HT_REDUCE_LANES; lane++) {
+                double value = values[i + lane];
+                lanes[lane] = value > lanes[lane] ? value : lanes[lane];
+            }
+        }
+        break;
+    default:
+        for (size_t i = 0; i < bulk; i += HT_REDUCE_LANES) {
+            for (int lane = 0; lane < HT_REDUCE_LANES; lane++) {
+                lanes[lane] += values[i + lane];
+            }
+        }
+        break;
+    }
+
+    for (int lane = 0; lane < HT_REDUCE_LANES; lane++) {
+        result = reduce_step(op, result, lanes[lane]);
+    }
+    for (size_t i = bulk; i < count; i++) {
+        result = reduce_step(op, result, values[i]);
+    }
+    return result;
+}
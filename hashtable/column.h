@@ -0,0 +1,65 @@
+/*
+ * Hlavičkový súbor pre stĺpcovú tabuľku s rozptýlenými položkami a agregácie
+ * hodnôt.
+ *
+ * Stĺpcová tabuľka ukladá prvky do dvoch súvislých polí: items s kľúčmi a
+ * reťazením synonym a values s hodnotami, pričom values[i] patrí prvku
+ * items[i]. Synonymá sa reťazia indexmi namiesto ukazovateľov, takže prvok
+ * zaberá 16 bajtov a hodnota 4 bajty (ht_item_t zaberá 24 bajtov plus réžiu
+ * alokátora). Agregácia hodnôt prechádza iba súvislé pole values.
+ *
+ * Zmazanie presunie posledný prvok na miesto zmazaného, indexy prvkov sa
+ * preto pri zmazaní menia.
+ *
+ * Stĺpcová tabuľka je samostatný typ, nie iné rozloženie ht_table_t: typ
+ * ht_item_t patrí k nemennému rozhraniu hashtable.h. Hľadanie sa započíta
+ * do štatistík (stats.h). Filter (filter.h) ani alokátor a spotreba pamäte
+ * z memory.h sa na ňu nevzťahujú, pretože sú priradené k ht_table_t; polia
+ * sa alokujú priamo funkciou realloc a ich veľkosť vráti ht_column_memory.
+ */
+
+#ifndef IAL_HASHTABLE_COLUMN_H
+#define IAL_HASHTABLE_COLUMN_H
+
+#include "hashtable.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Index označujúci koniec reťazca synonym
+#define HT_COLUMN_NONE UINT32_MAX
+
+// Agregačná operácia
+typedef enum ht_reduce_op {
+  HT_REDUCE_SUM, // súčet, pre prázdnu tabuľku 0
+  HT_REDUCE_MIN, // minimum, pre prázdnu tabuľku +nekonečno
+  HT_REDUCE_MAX  // maximum, pre prázdnu tabuľku -nekonečno
+} ht_reduce_op_t;
+
+// Prvok stĺpcovej tabuľky
+typedef struct ht_column_item {
+  char *key;           // kľúč prvku
+  uint32_t key_length; // dĺžka kľúča
+  uint32_t next;       // index ďalšieho synonyma alebo HT_COLUMN_NONE
+} ht_column_item_t;
+
+// Stĺpcová tabuľka
+typedef struct ht_column {
+  uint32_t buckets[MAX_HT_SIZE]; // index prvého prvku reťazca synonym
+  ht_column_item_t *items;
+  float *values;
+  size_t count;    // počet prvkov
+  size_t capacity; // veľkosť alokovaných polí
+} ht_column_t;
+
+double ht_reduce(ht_table_t *table, ht_reduce_op_t op);
+
+void ht_column_init(ht_column_t *column);
+void ht_column_dispose(ht_column_t *column);
+size_t ht_column_memory(const ht_column_t *column);
+float *ht_column_get(ht_column_t *column, char *key);
+bool ht_column_insert(ht_column_t *column, char *key, float value);
+void ht_column_delete(ht_column_t *column, char *key);
+double ht_column_reduce(ht_column_t *column, ht_reduce_op_t op);
+
+#endif
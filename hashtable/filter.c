@@ -0,0 +1,209 @@
+/*
+ * Pravdepodobnostný filter tabuľky s rozptýlenými položkami
+ *
+ * Pre n očakávaných prvkov a pravdepodobnosť falošnej zhody p má filter
+ * m = -n ln p / (ln 2)^2 počítadiel zaokrúhlených nahor na mocninu dvoch
+ * a k = m / n ln 2 hashovacích funkcií. Pozície počítadiel sa odvodia
+ * dvojitým hashovaním z 64-bitového FNV-1a kľúča: h1 + i * h2.
+ *
+ * Počítadlo, ktoré dosiahne hodnotu 15, sa už nezmenšuje. Filter tak pri
+ * pretečení stratí iba presnosť (kľúč zostane "možno prítomný"), nikdy
+ * nevráti nesprávnu zápornú odpoveď.
+ */
+
+#include "filter.h"
+#include "stats.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define FILTER_SATURATED 15
+#define FILTER_LN2 0.69314718055994530942
+#define FNV_OFFSET 14695981039346656037ull
+#define FNV_PRIME 1099511628211ull
+
+typedef struct filter_entry {
+    ht_table_t *table;
+    ht_filter_t *filter;
+} filter_entry_t;
+
+int ht_filter_registered = 0;
+static filter_entry_t filter_registry[HT_FILTER_MAX_TABLES];
+
+static uint64_t filter_hash(const char *key) {
+    uint64_t hash = FNV_OFFSET;
+    for (const unsigned char *c = (const unsigned char *)key; *c; c++) {
+        hash = (hash ^ *c) * FNV_PRIME;
+    }
+    return hash;
+}
+
+static unsigned filter_get(const ht_filter_t *filter, size_t position) {
+    return (filter->counters[position >> 1] >> ((position & 1) * 4)) & 0xF;
+}
+
+static void filter_set(ht_filter_t *filter, size_t position, unsigned value) {
+    int shift = (int)(position & 1) * 4;
+    uint8_t *byte = &filter->counters[position >> 1];
+    *byte = (uint8_t)((*byte & ~(0xF << shift)) | value << shift);
+}
+
+/*
+ * Inicializácia prázdneho filtra pre expected_items prvkov s
+ * pravdepodobnosťou falošnej zhody false_positive_rate z intervalu (0,1).
+ *
+ * Pri nedostatku pamäte vráti funkcia hodnotu false.
+ */
+bool ht_filter_init(ht_filter_t *filter, size_t expected_items,
+                    double false_positive_rate) {
+    if (expected_items == 0) expected_items = 1;
+    if (!(false_positive_rate > 0 && false_positive_rate < 1)) {
+        false_positive_rate = 0.01;
+    }
+
+    double bits = -(double)expected_items * log(false_positive_rate) /
+                  (FILTER_LN2 * FILTER_LN2);
+    size_t size = 64;
+    while (size < bits) size *= 2;
+
+    int hashes = (int)lround((double)size / expected_items * FILTER_LN2);
+    if (hashes < 1) hashes = 1;
+    if (hashes > HT_FILTER_MAX_HASHES) hashes = HT_FILTER_MAX_HASHES;
+
+    filter->counters = calloc(size / 2, 1);
+    if (filter->counters == NULL) return false;
+    filter->size = size;
+    filter->hashes = hashes;
+    filter->items = 0;
+    filter->checks = 0;
+    filter->rejections = 0;
+    return true;
+}
+
+/*
+ * Zrušenie filtra. Filter nesmie byť pripojený k tabuľke.
+ */
+void ht_filter_dispose(ht_filter_t *filter) {
+    free(filter->counters);
+    filter->counters = NULL;
+    filter->size = 0;
+    filter->items = 0;
+}
+
+/*
+ * Veľkosť pamäte filtra v bajtoch.
+ */
+size_t ht_filter_memory(const ht_filter_t *filter) {
+    return sizeof(ht_filter_t) + filter->size / 2;
+}
+
+/*
+ * Pripojenie filtra k tabuľke. Do filtra sa pridajú všetky prvky, ktoré už
+ * v tabuľke sú.
+ *
+ * Funkcia vráti hodnotu false, ak je register plný alebo tabuľka už má
+ * pripojený filter.
+ */
+bool ht_filter_attach(ht_table_t *table, ht_filter_t *filter) {
+    if (ht_filter_registered == HT_FILTER_MAX_TABLES ||
+        ht_filter_find(table) != NULL) {
+        return false;
+    }
+
+    ht_filter_clear(filter);
+    for (int i = 0; i < HT_SIZE; i++) {
+        for (ht_item_t *item = (*table)[i]; item != NULL; item = item->next) {
+            ht_filter_add(filter, item->key);
+        }
+    }
+    filter_registry[ht_filter_registered++] = (filter_entry_t){table, filter};
+    return true;
+}
+
+/*
+ * Odpojenie filtra od tabuľky. Pokiaľ tabuľka nemá filter, funkcia nerobí
+ * nič.
+ */
+void ht_filter_detach(ht_table_t *table) {
+    for (int i = 0; i < ht_filter_registered; i++) {
+        if (filter_registry[i].table == table) {
+            filter_registry[i] = filter_registry[--ht_filter_registered];
+            return;
+        }
+    }
+}
+
+/*
+ * Vyhľadanie filtra tabuľky v registri. Obvykle sa volá cez ht_filter_find.
+ */
+ht_filter_t *ht_filter_lookup(ht_table_t *table) {
+    for (int i = 0; i < ht_filter_registered; i++) {
+        if (filter_registry[i].table == table) {
+            return filter_registry[i].filter;
+        }
+    }
+    return NULL;
+}
+
+/*
+ * Otázka na prítomnosť kľúča.
+ *
+ * Hodnota false znamená, že kľúč vo filtri určite nie je; hodnota true, že
+ * v ňom môže byť.
+ */
+bool ht_filter_contains(ht_filter_t *filter, const char *key) {
+    uint64_t hash = filter_hash(key);
+    size_t h1 = (size_t)hash, h2 = (size_t)(hash >> 32) | 1;
+    size_t mask = filter->size - 1;
+
+    HT_STAT(filter->checks++;)
+    for (int i = 0; i < filter->hashes; i++) {
+        if (filter_get(filter, (h1 + i * h2) & mask) == 0) {
+            HT_STAT(filter->rejections++;)
+            return false;
+        }
+    }
+    return true;
+}
+
+/*
+ * Pridanie kľúča do filtra.
+ */
+void ht_filter_add(ht_filter_t *filter, const char *key) {
+    uint64_t hash = filter_hash(key);
+    size_t h1 = (size_t)hash, h2 = (size_t)(hash >> 32) | 1;
+    size_t mask = filter->size - 1;
+
+    for (int i = 0; i < filter->hashes; i++) {
+        size_t position = (h1 + i * h2) & mask;
+        unsigned count = filter_get(filter, position);
+        if (count < FILTER_SATURATED) filter_set(filter, position, count + 1);
+    }
+    filter->items++;
+}
+
+/*
+ * Odobratie kľúča, ktorý bol do filtra pridaný.
+ */
+void ht_filter_remove(ht_filter_t *filter, const char *key) {
+    uint64_t hash = filter_hash(key);
+    size_t h1 = (size_t)hash, h2 = (size_t)(hash >> 32) | 1;
+    size_t mask = filter->size - 1;
+
+    for (int i = 0; i < filter->hashes; i++) {
+        size_t position = (h1 + i * h2) & mask;
+        unsigned count = filter_get(filter, position);
+        if (count > 0 && count < FILTER_SATURATED) {
+            filter_set(filter, position, count - 1);
+        }
+    }
+    filter->items--;
+}
+
+/*
+ * Odobratie všetkých kľúčov. Štatistiky otázok zostávajú zachované.
+ */
+void ht_filter_clear(ht_filter_t *filter) {
+    memset(filter->counters, 0, filter->size / 2);
+    filter->items = 0;
+}
@@ -0,0 +1,67 @@
+/*
+ * Hlavičkový súbor pre pravdepodobnostný filter tabuľky s rozptýlenými
+ * položkami.
+ *
+ * Filter je počítací Bloomov filter so 4-bitovými počítadlami. Po pripojení
+ * k tabuľke ho udržiavajú funkcie ht_insert, ht_delete, ht_delete_all,
+ * ht_init aj ht_insert_bulk (a rovnako cache.h a ttl.h) a ht_search sa ho
+ * pýta ako prvého: kľúč, ktorý filter určite neobsahuje, sa vôbec nehľadá
+ * v reťazcoch synonym. Kladná odpoveď filtra je správna s pravdepodobnosťou
+ * danou pri inicializácii.
+ *
+ * Typ ht_table_t nemá miesto pre ďalšie údaje, filtre sa preto k tabuľkám
+ * priraďujú v malom globálnom registri. Pripájanie a odpájanie nie je
+ * bezpečné voči súbežnému používaniu tabuliek.
+ */
+
+#ifndef IAL_HASHTABLE_FILTER_H
+#define IAL_HASHTABLE_FILTER_H
+
+#include "hashtable.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Maximálny počet súčasne pripojených filtrov
+#define HT_FILTER_MAX_TABLES 16
+
+// Počet hashovacích funkcií je obmedzený na interval <1,HT_FILTER_MAX_HASHES>
+#define HT_FILTER_MAX_HASHES 16
+
+// Filter
+typedef struct ht_filter {
+  uint8_t *counters;       // dve 4-bitové počítadlá v každom bajte
+  size_t size;             // počet počítadiel (mocnina dvoch)
+  int hashes;              // počet hashovacích funkcií
+  size_t items;            // počet prvkov vo filtri
+  // Počítadlá sa zbierajú iba s IAL_STATS a rovnako ako stats.h nie sú
+  // atomické, pri súbežnom hľadaní sú preto iba orientačné
+  unsigned long checks;    // počet otázok funkcie ht_search
+  unsigned long rejections; // počet otázok s odpoveďou "určite nie"
+} ht_filter_t;
+
+extern int ht_filter_registered;
+
+bool ht_filter_init(ht_filter_t *filter, size_t expected_items,
+                    double false_positive_rate);
+void ht_filter_dispose(ht_filter_t *filter);
+size_t ht_filter_memory(const ht_filter_t *filter);
+
+bool ht_filter_attach(ht_table_t *table, ht_filter_t *filter);
+void ht_filter_detach(ht_table_t *table);
+ht_filter_t *ht_filter_lookup(ht_table_t *table);
+
+bool ht_filter_contains(ht_filter_t *filter, const char *key);
+void ht_filter_add(ht_filter_t *filter, const char *key);
+void ht_filter_remove(ht_filter_t *filter, const char *key);
+void ht_filter_clear(ht_filter_t *filter);
+
+/*
+ * Filter pripojený k tabuľke alebo NULL. Bez pripojených filtrov stojí
+ * jedno porovnanie.
+ */
+static inline ht_filter_t *ht_filter_find(ht_table_t *table) {
+  return ht_filter_registered == 0 ? NULL : ht_filter_lookup(table);
+}
+
+#endif
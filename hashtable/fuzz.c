@@ -0,0 +1,257 @@
+/*
+ * Diferenciálny test tabuľky s rozptýlenými položkami s náhodnými operáciami.
+ *
+ * Spustenie: ./fuzz [semienko] [počet operácií]
+ *
+ * Program vykonáva náhodnú postupnosť operácií ht_insert, ht_get, ht_search,
+ * ht_delete a ht_delete_all nad tabuľkou a rovnaké operácie nad referenčným
+ * modelom (poľom náhodne vygenerovaných kľúčov). Každý výsledok porovná
+ * s modelom a po každej operácii overí štatistiky: hľadanie neporovná viac
+ * prvkov, než má prehľadávaný zoznam synonym, vloženie existujúceho kľúča
+ * nealokuje a zmazanie chýbajúceho kľúča neuvoľňuje.
+ *
+ * Na konci každého kola prejde celú tabuľku a overí zoznamy synonym (prvok
+ * leží v správnom zozname, má správnu dĺžku kľúča a hodnotu a kľúč sa
+ * neopakuje), počet živých prvkov (únik pamäte), spotrebu pamäte podľa
+ * memory.h a dĺžku najdlhšieho zoznamu vzhľadom na zaplnenie tabuľky.
+ * Každé kolo zvolí inú veľkosť HT_SIZE, zapne alebo vypne HT_MOVE_TO_FRONT
+ * a pripojí alebo odpojí filter.
+ *
+ * Pri prvej chybe program vypíše semienko a číslo operácie a skončí
+ * s kódom 1. Na konci vypíše kontrolný súčet všetkých výsledkov.
+ *
+ * Počet živých prvkov sa kontroluje podľa štatistík. Skutočné úniky a chyby
+ * prístupu do pamäte odhalí preklad s make fuzz SANITIZE=1.
+ */
+
+#ifndef IAL_STATS
+#error "fuzz sa prekladá s -DIAL_STATS (make fuzz)"
+#endif
+
+#include "filter.h"
+#include "hashtable.h"
+#include "memory.h"
+#include "search.h"
+#include "stats.h"
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define FUZZ_KEYS 1024       // počet rôznych kľúčov
+#define FUZZ_KEY_SIZE 25     // najdlhší kľúč vrátane ukončovacieho znaku
+#define FUZZ_ROUND 16384     // počet operácií v jednom kole
+#define FUZZ_CHAIN_SLACK 12  // povolený presah najdlhšieho zoznamu nad priemer
+
+typedef struct fuzz_model {
+    bool present[FUZZ_KEYS];
+    float values[FUZZ_KEYS];
+    int size;
+} fuzz_model_t;
+
+static const int FUZZ_SIZES[] = {2, 3, 13, 31, 53, 101};
+
+static char fuzz_keys[FUZZ_KEYS][FUZZ_KEY_SIZE];
+static unsigned long fuzz_seed;
+static unsigned long fuzz_operation;
+static unsigned long fuzz_checksum = 14695981039346656037ul;
+
+static unsigned long fuzz_random(void) {
+    fuzz_seed = fuzz_seed * 6364136223846793005ul + 1442695040888963407ul;
+    return fuzz_seed >> 33;
+}
+
+static void fuzz_mix(unsigned long value) {
+    fuzz_checksum = (fuzz_checksum ^ value) * 1099511628211ul;
+}
+
+static void fuzz_fail(unsigned long seed, const char *message) {
+    fprintf(stderr, "FAIL seed=%lu operation=%lu HT_SIZE=%d: %s\n", seed,
+            fuzz_operation, HT_SIZE, message);
+    exit(1);
+}
+
+/*
+ * Vygenerovanie rôznych kľúčov dĺžky 4 až FUZZ_KEY_SIZE - 1. Kľúče sa
+ * navzájom líšia aspoň poslednými dvoma znakmi, ktoré kódujú poradie kľúča.
+ */
+static void fuzz_generate_keys(void) {
+    for (int i = 0; i < FUZZ_KEYS; i++) {
+        int length = 2 + (int)(fuzz_random() % (FUZZ_KEY_SIZE - 4));
+        for (int j = 0; j < length; j++) {
+            fuzz_keys[i][j] = (char)(' ' + 1 + fuzz_random() % 94);
+        }
+        snprintf(fuzz_keys[i] + length, FUZZ_KEY_SIZE - length, "%c%c",
+                 ' ' + 1 + i % 94, ' ' + 1 + i / 94);
+    }
+}
+
+/*
+ * Poradie kľúča prvku v poli fuzz_keys alebo -1 pre cudzí ukazovateľ.
+ */
+static int fuzz_key_index(const char *key) {
+    if (key < fuzz_keys[0] || key >= fuzz_keys[FUZZ_KEYS]) return -1;
+    ptrdiff_t offset = key - fuzz_keys[0];
+    return offset % FUZZ_KEY_SIZE == 0 ? (int)(offset / FUZZ_KEY_SIZE) : -1;
+}
+
+static int fuzz_chain_length(ht_table_t *table, char *key) {
+    int length = 0;
+    for (ht_item_t *item = (*table)[get_hash(key)]; item != NULL;
+         item = item->next) {
+        length++;
+    }
+    return length;
+}
+
+/*
+ * Úplná kontrola tabuľky: zoznamy synonym, zhoda s modelom, počet živých
+ * prvkov a dĺžka najdlhšieho zoznamu.
+ */
+static void fuzz_verify(unsigned long seed, ht_table_t *table,
+                        fuzz_model_t *model) {
+    bool seen[FUZZ_KEYS] = {false};
+    int count = 0;
+    int longest = 0;
+    size_t key_bytes = 0;
+
+    for (int i = 0; i < HT_SIZE; i++) {
+        int length = 0;
+        for (ht_item_t *item = (*table)[i]; item != NULL; item = item->next) {
+            int index = fuzz_key_index(item->key);
+            if (index < 0) fuzz_fail(seed, "item has a foreign key");
+            if (seen[index]) fuzz_fail(seed, "key is in the table twice");
+            if (get_hash(item->key) != i) {
+                fuzz_fail(seed, "item in wrong chain");
+            }
+            if (!model->present[index] || model->values[index] != item->value) {
+                fuzz_fail(seed, "item does not match the model");
+            }
+            seen[index] = true;
+            key_bytes += strlen(item->key) + 1;
+            length++;
+            if (++count > model->size) fuzz_fail(seed, "chain has a cycle");
+        }
+        if (length > longest) longest = length;
+    }
+
+    if (count != model->size) fuzz_fail(seed, "item count differs");
+    if (ht_stats.allocations - ht_stats.frees != (unsigned long)count) {
+        fuzz_fail(seed, "live item count differs (leak or double free)");
+    }
+
+    ht_memory_t usage;
+    ht_memory_usage(table, &usage);
+    if (usage.items != (size_t)count * sizeof(ht_item_t) ||
+        usage.keys != key_bytes) {
+        fuzz_fail(seed, "memory usage does not match the items");
+    }
+    if (longest > 2 * (count / HT_SIZE + 1) + FUZZ_CHAIN_SLACK) {
+        fuzz_fail(seed, "longest chain is too long for the load");
+    }
+}
+
+static void fuzz_run(unsigned long seed, unsigned long operations) {
+    ht_table_t table;
+    ht_filter_t filter;
+    ht_memory_t counters;
+    fuzz_model_t model = {{false}, {0}, 0};
+    char copy[FUZZ_KEY_SIZE];
+
+    fuzz_seed = seed;
+    fuzz_generate_keys();
+    if (!ht_filter_init(&filter, FUZZ_KEYS, 0.01)) {
+        fuzz_fail(seed, "filter could not be allocated");
+    }
+    ht_stats_reset();
+    ht_init(&table);
+    ht_memory_attach(&table, &counters);
+
+    for (fuzz_operation = 0; fuzz_operation < operations; fuzz_operation++) {
+        if (fuzz_operation % FUZZ_ROUND == 0) {
+            fuzz_verify(seed, &table, &model);
+            ht_delete_all(&table);
+            model = (fuzz_model_t){{false}, {0}, 0};
+            fuzz_verify(seed, &table, &model);
+
+            ht_filter_detach(&table);
+            HT_SIZE = FUZZ_SIZES[fuzz_random() % (sizeof(FUZZ_SIZES) /
+                                                  sizeof(FUZZ_SIZES[0]))];
+            HT_MOVE_TO_FRONT = fuzz_random() % 2 == 0;
+            if (fuzz_random() % 2 == 0) ht_filter_attach(&table, &filter);
+            ht_init(&table);
+        }
+
+        // Kľúče z menšej časti poľa sa vyberajú častejšie
+        int index = (int)(fuzz_random() % (fuzz_random() % 2 == 0
+                                               ? FUZZ_KEYS / 8
+                                               : FUZZ_KEYS));
+        char *key = fuzz_keys[index];
+        unsigned long allocations = ht_stats.allocations;
+        unsigned long frees = ht_stats.frees;
+        unsigned long probes = ht_stats.probes;
+        unsigned long choice = fuzz_random() % 16;
+
+        if (choice < 6) {
+            float value = (float)(fuzz_random() % 100000) / 8;
+            ht_insert(&table, key, value);
+            if (model.present[index] != (ht_stats.allocations == allocations)) {
+                fuzz_fail(seed, "insert allocated a wrong number of items");
+            }
+            if (!model.present[index]) {
+                model.present[index] = true;
+                model.size++;
+            }
+            model.values[index] = value;
+        } else if (choice < 9) {
+            ht_delete(&table, key);
+            if (model.present[index] != (ht_stats.frees == frees + 1) ||
+                ht_stats.frees > frees + 1) {
+                fuzz_fail(seed, "delete freed a wrong number of items");
+            }
+            if (model.present[index]) {
+                model.present[index] = false;
+                model.size--;
+            }
+        } else if (choice < 15) {
+            // Hľadá sa kópia kľúča, aby sa kľúče porovnávali obsahom
+            strcpy(copy, key);
+            int chain = fuzz_chain_length(&table, copy);
+            float *value = ht_get(&table, copy);
+            if ((value != NULL) != model.present[index] ||
+                (value != NULL && *value != model.values[index])) {
+                fuzz_fail(seed, "get differs from the model");
+            }
+            if (ht_stats.probes - probes > (unsigned long)chain) {
+                fuzz_fail(seed, "search compared more items than the chain");
+            }
+            fuzz_mix(value != NULL ? (unsigned long)(*value * 8) : 1ul << 32);
+        } else {
+            ht_item_t *item = ht_search(&table, key);
+            if ((item != NULL) != model.present[index] ||
+                (item != NULL && item->key != key)) {
+                fuzz_fail(seed, "search returned a wrong item");
+            }
+        }
+    }
+
+    fuzz_verify(seed, &table, &model);
+    ht_delete_all(&table);
+    ht_filter_detach(&table);
+    ht_filter_dispose(&filter);
+    ht_memory_detach(&table);
+    if (ht_stats.allocations != ht_stats.frees) {
+        fuzz_fail(seed, "items leaked after ht_delete_all");
+    }
+}
+
+int main(int argc, char *argv[]) {
+    unsigned long seed = argc > 1 ? strtoul(argv[1], NULL, 10) : 1;
+    unsigned long operations = argc > 2 ? strtoul(argv[2], NULL, 10) : 1000000;
+
+    fuzz_run(seed, operations);
+    printf("Seed: %lu\n", seed);
+    printf("Operations: %lu\n", operations);
+    printf("Checksum: %016lx\n", fuzz_checksum);
+    return 0;
+}
@@ -9,11 +9,17 @@
  */
 
 #include "hashtable.h"
+#include "filter.h"
+#include "key.h"
+#include "memory.h"
+#include "search.h"
+#include "stats.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
 int HT_SIZE = MAX_HT_SIZE;
+bool HT_MOVE_TO_FRONT = false;
 
 /*
  * Rozptyľovacia funkcia ktorá pridelí zadanému kľúču index z intervalu
@@ -21,12 +27,8 @@ int HT_SIZE = MAX_HT_SIZE;
  * rovnomerne po všetkých indexoch. Zamyslite sa nad kvalitou zvolenej funkcie.
  */
 int get_hash(char *key) {
-    int result = 1;
-    int length = strlen(key);
-    for (int i = 0; i < length; i++) {
-        result += key[i];
-    }
-    return (result % HT_SIZE);
+    size_t length;
+    return ht_key_sum(key, &length) % HT_SIZE;
 }
 
 /*
@@ -36,6 +38,11 @@ void ht_init(ht_table_t *table) {
     for (int i = 0; i < HT_SIZE; i++) {
         (*table)[i] = NULL;
     }
+    // Počítadlá sa vynulujú naraz, prvky sa preto neodpočítavajú jednotlivo
+    ht_memory_reset(table);
+
+    ht_filter_t *filter = ht_filter_find(table);
+    if (filter != NULL) ht_filter_clear(filter);
 }
 
 /*
@@ -43,16 +50,36 @@ void ht_init(ht_table_t *table) {
  *
  * V prípade úspechu vráti ukazovateľ na nájdený prvok; v opačnom prípade vráti
  * hodnotu NULL.
+ *
+ * Pri zapnutom HT_MOVE_TO_FRONT sa nájdený prvok presunie na začiatok
+ * zoznamu synonym, takže často hľadané kľúče sa nájdu na prvý pokus.
  */
 ht_item_t *ht_search(ht_table_t *table, char *key) {
-    int index = get_hash(key);
-    ht_item_t *item = (*table)[index];
-    while (item != NULL) {
+    ht_filter_t *filter = ht_filter_find(table);
+    if (filter != NULL && !ht_filter_contains(filter, key)) {
+        HT_STAT(ht_stats_search(0);)
+        return NULL;
+    }
+
+    size_t length;
+    int index = ht_key_sum(key, &length) % HT_SIZE;
+    ht_item_t **link = &(*table)[index];
+    HT_STAT(unsigned probes = 0;)
+    while (*link != NULL) {
+        ht_item_t *item = *link;
+        HT_STAT(probes++;)
         if (strcmp(item->key, key) == 0) {
+            if (HT_MOVE_TO_FRONT && link != &(*table)[index]) {
+                *link = item->next;
+                item->next = (*table)[index];
+                (*table)[index] = item;
+            }
+            HT_STAT(ht_stats_search(probes);)
             return item;
         }
-        item = item->next;
+        link = &item->next;
     }
+    HT_STAT(ht_stats_search(probes);)
     return NULL;
 }
 
@@ -71,12 +98,18 @@ void ht_insert(ht_table_t *table, char *key, float value) {
         return;
     }
 
-    int index = get_hash(key);
-    ht_item_t *new_item = malloc(sizeof(ht_item_t));
+    size_t length;
+    int index = ht_key_sum(key, &length) % HT_SIZE;
+    ht_item_t *new_item = ht_item_allocate(table, sizeof(ht_item_t), length);
+    if (new_item == NULL) return;
+    HT_STAT(ht_stats.allocations++;)
     new_item->key = key;
     new_item->value = value;
     new_item->next = (*table)[index];
     (*table)[index] = new_item;
+
+    ht_filter_t *filter = ht_filter_find(table);
+    if (filter != NULL) ht_filter_add(filter, key);
 }
 
 /*
@@ -102,7 +135,8 @@ float *ht_get(ht_table_t *table, char *key) {
  * Pri implementácii NEVYUŽÍVAJTE funkciu ht_search.
  */
 void ht_delete(ht_table_t *table, char *key) {
-    int index = get_hash(key);
+    size_t length;
+    int index = ht_key_sum(key, &length) % HT_SIZE;
     ht_item_t *item = (*table)[index];
     ht_item_t *prev = NULL;
     while (item != NULL) {
@@ -112,7 +146,11 @@ void ht_delete(ht_table_t *table, char *key) {
             } else {
                 prev->next = item->next;
             }
-            free(item);
+
+            ht_filter_t *filter = ht_filter_find(table);
+            if (filter != NULL) ht_filter_remove(filter, key);
+            ht_item_release(table, item, sizeof(ht_item_t), length);
+            HT_STAT(ht_stats.frees++;)
             return;
         }
         prev = item;
@@ -131,9 +169,15 @@ void ht_delete_all(ht_table_t *table) {
         ht_item_t *item = (*table)[i];
         while (item != NULL) {
             ht_item_t *next = item->next;
-            free(item);
+            ht_release(item, sizeof(ht_item_t));
+            HT_STAT(ht_stats.frees++;)
             item = next;
         }
         (*table)[i] = NULL;
     }
+    // Počítadlá sa vynulujú naraz, prvky sa preto neodpočítavajú jednotlivo
+    ht_memory_reset(table);
+
+    ht_filter_t *filter = ht_filter_find(table);
+    if (filter != NULL) ht_filter_clear(filter);
 }
@@ -0,0 +1,193 @@
+/*
+ * Operácie nad reťazcovými kľúčmi tabuľky
+ *
+ * Vektorové implementácie čítajú reťazec po zarovnaných blokoch, takže nikdy
+ * neprekročia hranicu stránky, aj keď prečítajú niekoľko bajtov pred
+ * začiatkom alebo za koncom kľúča. Tieto bajty sa maskou vynechajú zo súčtu.
+ */
+
+#include "key.h"
+#include <limits.h>
+#include <stdint.h>
+#include <string.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define HT_KEY_X86 1
+#endif
+
+// Najdlhší kľúč, ktorý ht_key_sum sčíta bez vektorových inštrukcií
+#define HT_KEY_SHORT 32
+
+static int scalar_sum(const char *key, size_t *length) {
+    int result = 1;
+    size_t i = 0;
+    for (; key[i] != '\0'; i++) {
+        result += key[i];
+    }
+    *length = i;
+    return result;
+}
+
+const ht_key_ops_t HT_KEY_SCALAR = {"scalar", scalar_sum};
+
+#ifdef HT_KEY_X86
+
+/*
+ * PREFIX_MASK + 32 - n je začiatok bloku, ktorého prvých n bajtov je 0xFF
+ * a zvyšok nulový (0 <= n <= 32).
+ */
+static const unsigned char PREFIX_MASK[64] = {
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
+
+/*
+ * Prevod súčtu bajtov bez znamienka na súčet hodnôt typu char.
+ *
+ * Pri znamienkovom char sa bajty pred sčítaním posunú o 128 (xor 0x80),
+ * aby ich bolo možné sčítať inštrukciou psadbw, a posun sa potom odčíta.
+ */
+#if CHAR_MIN < 0
+#define HT_KEY_BIAS 0x80
+#else
+#define HT_KEY_BIAS 0x00
+#endif
+
+static int finish_sum(uint64_t sum, size_t count) {
+    return (int)(1 + (int64_t)sum - (int64_t)HT_KEY_BIAS * (int64_t)count);
+}
+
+static inline __attribute__((target("sse2"))) __m128i
+sse2_prefix(unsigned n) {
+    return _mm_loadu_si128((const __m128i *)(PREFIX_MASK + 32 - n));
+}
+
+__attribute__((target("sse2"), no_sanitize_address)) static int
+sse2_sum(const char *key, size_t *length) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i bias = _mm_set1_epi8((char)HT_KEY_BIAS);
+    unsigned skip = (unsigned)((uintptr_t)key & 15);
+    const __m128i *block = (const __m128i *)(key - skip);
+    __m128i acc = zero;
+    size_t count = 0;
+
+    for (;;) {
+        __m128i data = _mm_load_si128(block);
+        unsigned nul = (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(data, zero));
+        nul = nul >> skip << skip;
+        unsigned end = nul != 0 ? (unsigned)__builtin_ctz(nul) : 16;
+
+        __m128i mask = _mm_andnot_si128(sse2_prefix(skip), sse2_prefix(end));
+        __m128i bytes = _mm_and_si128(_mm_xor_si128(data, bias), mask);
+        acc = _mm_add_epi64(acc, _mm_sad_epu8(bytes, zero));
+        count += end - skip;
+
+        if (nul != 0) break;
+        skip = 0;
+        block++;
+    }
+
+    uint64_t lanes[2];
+    _mm_storeu_si128((__m128i *)lanes, acc);
+    *length = count;
+    return finish_sum(lanes[0] + lanes[1], count);
+}
+
+static inline __attribute__((target("avx2"))) __m256i avx2_prefix(unsigned n) {
+    return _mm256_loadu_si256((const __m256i *)(PREFIX_MASK + 32 - n));
+}
+
+__attribute__((target("avx2"), no_sanitize_address)) static int
+avx2_sum(const char *key, size_t *length) {
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i bias = _mm256_set1_epi8((char)HT_KEY_BIAS);
+    unsigned skip = (unsigned)((uintptr_t)key & 31);
+    const __m256i *block = (const __m256i *)(key - skip);
+    __m256i acc = zero;
+    size_t count = 0;
+
+    for (;;) {
+        __m256i data = _mm256_load_si256(block);
+        unsigned nul =
+            (unsigned)_mm256_movemask_epi8(_mm256_cmpeq_epi8(data, zero));
+        nul = nul >> skip << skip;
+        unsigned end = nul != 0 ? (unsigned)__builtin_ctz(nul) : 32;
+
+        __m256i mask =
+            _mm256_andnot_si256(avx2_prefix(skip), avx2_prefix(end));
+        __m256i bytes = _mm256_and_si256(_mm256_xor_si256(data, bias), mask);
+        acc = _mm256_add_epi64(acc, _mm256_sad_epu8(bytes, zero));
+        count += end - skip;
+
+        if (nul != 0) break;
+        skip = 0;
+        block++;
+    }
+
+    uint64_t lanes[4];
+    _mm256_storeu_si256((__m256i *)lanes, acc);
+    *length = count;
+    return finish_sum(lanes[0] + lanes[1] + lanes[2] + lanes[3], count);
+}
+
+const ht_key_ops_t HT_KEY_SSE2 = {"sse2", sse2_sum};
+const ht_key_ops_t HT_KEY_AVX2 = {"avx2", avx2_sum};
+
+#endif
+
+/*
+ * Zistí, či aktuálny procesor podporuje danú implementáciu.
+ */
+bool ht_key_supported(const ht_key_ops_t *ops) {
+#ifdef HT_KEY_X86
+    __builtin_cpu_init();
+    if (ops == &HT_KEY_SSE2) return __builtin_cpu_supports("sse2");
+    if (ops == &HT_KEY_AVX2) return __builtin_cpu_supports("avx2");
+#endif
+    return ops == &HT_KEY_SCALAR;
+}
+
+static const ht_key_ops_t *key_selected = &HT_KEY_SCALAR;
+static int (*key_long_sum)(const char *, size_t *) = scalar_sum;
+
+/*
+ * Výber implementácie pre dlhé kľúče pred spustením main, keď ešte nebežia
+ * ďalšie vlákna; ht_key_sum potom nič nesynchronizuje.
+ */
+__attribute__((constructor)) static void key_select(void) {
+#ifdef HT_KEY_X86
+    if (ht_key_supported(&HT_KEY_AVX2)) {
+        key_selected = &HT_KEY_AVX2;
+    } else if (ht_key_supported(&HT_KEY_SSE2)) {
+        key_selected = &HT_KEY_SSE2;
+    }
+#endif
+    key_long_sum = key_selected->sum;
+}
+
+/*
+ * Implementácia vybraná pre dlhé kľúče na aktuálnom procesore.
+ */
+const ht_key_ops_t *ht_key_ops(void) {
+    return key_selected;
+}
+
+/*
+ * Súčet znakov kľúča (rovnaký ako v get_hash) spolu s jeho dĺžkou.
+ *
+ * Pri krátkych kľúčoch sa vektorové implementácie nevyplatia (AVX2 je pod 32
+ * bajtov pomalšia aj od SSE2), takže sa sčítajú rovnako ako v get_hash. Pre
+ * dlhšie kľúče sa priamo zavolá implementácia vybraná pri štarte.
+ */
+int ht_key_sum(const char *key, size_t *length) {
+    size_t n = strlen(key);
+    if (n > HT_KEY_SHORT) return key_long_sum(key, length);
+
+    int result = 1;
+    for (size_t i = 0; i < n; i++) {
+        result += key[i];
+    }
+    *length = n;
+    return result;
+}
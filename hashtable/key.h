@@ -0,0 +1,35 @@
+/*
+ * Hlavičkový súbor pre operácie nad reťazcovými kľúčmi tabuľky.
+ *
+ * Rozptyľovací súčet kľúča sa vracia spolu s jeho dĺžkou.
+ * K dispozícii sú skalárna, SSE2 a AVX2 implementácia; pre kľúče dlhšie ako
+ * 32 bajtov sa vhodná vyberie raz pri štarte programu podľa procesora, kratšie
+ * kľúče sa sčítajú skalárne. Výsledky všetkých implementácií sú zhodné so
+ * skalárnou.
+ */
+
+#ifndef IAL_HASHTABLE_KEY_H
+#define IAL_HASHTABLE_KEY_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+// Sada implementácií operácií nad kľúčmi
+typedef struct ht_key_ops {
+  const char *name;
+  // Súčet 1 + key[0] + ... + key[n-1] (ako v get_hash), do length zapíše n
+  int (*sum)(const char *key, size_t *length);
+} ht_key_ops_t;
+
+extern const ht_key_ops_t HT_KEY_SCALAR;
+#if defined(__x86_64__) || defined(__i386__)
+extern const ht_key_ops_t HT_KEY_SSE2;
+extern const ht_key_ops_t HT_KEY_AVX2;
+#endif
+
+bool ht_key_supported(const ht_key_ops_t *ops);
+const ht_key_ops_t *ht_key_ops(void);
+
+int ht_key_sum(const char *key, size_t *length);
+
+#endif
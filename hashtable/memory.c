@@ -0,0 +1,207 @@
+/*
+ * Alokátor a spotreba pamäte tabuľky s rozptýlenými položkami
+ *
+ * Réžiu predvoleného alokátora odhaduje model bežných implementácií malloc:
+ * blok má pred sebou hlavičku veľkosti size_t, jeho veľkosť sa zarovná na
+ * dvojnásobok size_t a najmenší blok má štyri size_t.
+ *
+ * Typ ht_table_t nemá miesto pre počítadlá. Počítadlá vlastní volajúci
+ * a pripája ich k tabuľkám v malom registri rovnako ako filtre (filter.c).
+ * Register sa mení iba pri pripájaní a odpájaní, operácie nad tabuľkami ho
+ * iba čítajú.
+ */
+
+#include "memory.h"
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MEMORY_HEADER sizeof(size_t)
+#define MEMORY_ALIGN (2 * sizeof(size_t))
+#define MEMORY_MIN_BLOCK (4 * sizeof(size_t))
+
+static void *memory_malloc(size_t size, void *context) {
+    return malloc(size);
+}
+
+static void memory_free(void *pointer, size_t size, void *context) {
+    free(pointer);
+}
+
+static size_t memory_malloc_reserved(size_t size, void *context) {
+    size_t block = (size + MEMORY_HEADER + MEMORY_ALIGN - 1) &
+                   ~(MEMORY_ALIGN - 1);
+    return (block < MEMORY_MIN_BLOCK ? MEMORY_MIN_BLOCK : block) - MEMORY_HEADER;
+}
+
+static const ht_allocator_t memory_default = {
+    memory_malloc, memory_free, memory_malloc_reserved, NULL};
+
+static ht_allocator_t memory_allocator = {
+    memory_malloc, memory_free, memory_malloc_reserved, NULL};
+
+typedef struct memory_entry {
+    ht_table_t *table;
+    ht_memory_t *usage;
+} memory_entry_t;
+
+int ht_memory_registered = 0;
+static memory_entry_t memory_registry[HT_MEMORY_MAX_TABLES];
+
+/*
+ * Pripojenie počítadiel usage k tabuľke. Prvky, ktoré už v tabuľke sú, sa
+ * započítajú ako prvky typu ht_item_t, cache a ttl preto treba pripojiť
+ * pred vložením prvého záznamu.
+ *
+ * Funkcia vráti hodnotu false, ak je register plný alebo tabuľka už má
+ * pripojené počítadlá.
+ */
+bool ht_memory_attach(ht_table_t *table, ht_memory_t *usage) {
+    if (ht_memory_registered == HT_MEMORY_MAX_TABLES ||
+        ht_memory_find(table) != NULL) {
+        return false;
+    }
+
+    *usage = (ht_memory_t){0};
+    memory_registry[ht_memory_registered++] = (memory_entry_t){table, usage};
+    for (int i = 0; i < HT_SIZE; i++) {
+        for (ht_item_t *item = (*table)[i]; item != NULL; item = item->next) {
+            ht_memory_account(table, sizeof(ht_item_t), 1,
+                              (long)strlen(item->key) + 1, 0);
+        }
+    }
+    return true;
+}
+
+/*
+ * Odpojenie počítadiel od tabuľky. Pokiaľ tabuľka nemá počítadlá, funkcia
+ * nerobí nič.
+ */
+void ht_memory_detach(ht_table_t *table) {
+    for (int i = 0; i < ht_memory_registered; i++) {
+        if (memory_registry[i].table == table) {
+            memory_registry[i] = memory_registry[--ht_memory_registered];
+            return;
+        }
+    }
+}
+
+/*
+ * Vyhľadanie počítadiel tabuľky v registri. Obvykle sa volá cez
+ * ht_memory_find.
+ */
+ht_memory_t *ht_memory_lookup(ht_table_t *table) {
+    for (int i = 0; i < ht_memory_registered; i++) {
+        if (memory_registry[i].table == table) {
+            return memory_registry[i].usage;
+        }
+    }
+    return NULL;
+}
+
+/*
+ * Vynulovanie počítadiel tabuľky table, ktorá už nemá žiadne prvky. Volá sa
+ * z ht_init a ht_delete_all; počítadlá zostanú pripojené.
+ */
+void ht_memory_reset(ht_table_t *table) {
+    ht_memory_t *usage = ht_memory_find(table);
+    if (usage != NULL) *usage = (ht_memory_t){0};
+}
+
+/*
+ * Nastavenie alokátora prvkov, NULL obnoví predvolený alokátor.
+ *
+ * Alokátor sa smie zmeniť iba vtedy, keď žiadna tabuľka nemá prvky, inak by
+ * sa prvky uvoľňovali iným alokátorom, než ktorým vznikli.
+ */
+void ht_set_allocator(const ht_allocator_t *allocator) {
+    memory_allocator = allocator != NULL ? *allocator : memory_default;
+}
+
+/*
+ * Alokácia size bajtov nastaveným alokátorom bez započítania do spotreby.
+ * Pri odmietnutí vráti funkcia hodnotu NULL.
+ */
+void *ht_allocate(size_t size) {
+    return memory_allocator.allocate(size, memory_allocator.context);
+}
+
+/*
+ * Uvoľnenie bloku pointer veľkosti size alokovaného funkciou ht_allocate.
+ */
+void ht_release(void *pointer, size_t size) {
+    memory_allocator.release(pointer, size, memory_allocator.context);
+}
+
+/*
+ * Započítanie count alokovaných (záporné count uvoľnených) blokov veľkosti
+ * size s kľúčmi, ktoré spolu majú key_bytes bajtov, a rejections
+ * odmietnutých alokácií do spotreby tabuľky table. Tabuľky bez
+ * pripojených počítadiel sa nezapočítavajú.
+ */
+void ht_memory_account(ht_table_t *table, size_t size, long count,
+                       long key_bytes, unsigned long rejections) {
+    ht_memory_t *usage = ht_memory_find(table);
+    if (usage == NULL) return;
+
+    size_t reserved = memory_allocator.reserved != NULL
+                          ? memory_allocator.reserved(size,
+                                                      memory_allocator.context)
+                          : size;
+    usage->items += (size_t)count * size;
+    usage->slack += (size_t)count * (reserved - size);
+    usage->keys += (size_t)key_bytes;
+    usage->rejections += rejections;
+}
+
+/*
+ * Alokácia prvku tabuľky table veľkosti size pre kľúč dĺžky key_length
+ * (bez '\0').
+ *
+ * V prípade úspechu vráti funkcia ukazovateľ na prvok a započíta ho do
+ * spotreby tabuľky, v opačnom prípade vráti hodnotu NULL.
+ */
+void *ht_item_allocate(ht_table_t *table, size_t size, size_t key_length) {
+    void *item = ht_allocate(size);
+    if (item != NULL) {
+        ht_memory_account(table, size, 1, (long)key_length + 1, 0);
+    } else {
+        ht_memory_account(table, size, 0, 0, 1);
+    }
+    return item;
+}
+
+/*
+ * Uvoľnenie prvku tabuľky table veľkosti size s kľúčom dĺžky key_length
+ * (bez '\0').
+ */
+void ht_item_release(ht_table_t *table, void *item, size_t size,
+                     size_t key_length) {
+    ht_memory_account(table, size, -1, -(long)key_length - 1, 0);
+    ht_release(item, size);
+}
+
+/*
+ * Spotreba pamäte tabuľky table.
+ *
+ * Pole tabuľky sa započíta celé bez ohľadu na HT_SIZE; prvky, kľúče a réžia
+ * iba pri pripojených počítadlách. Pre table == NULL vráti funkcia súčet
+ * prvkov, kľúčov a réžie za všetky tabuľky s pripojenými počítadlami bez
+ * ich polí.
+ */
+void ht_memory_usage(ht_table_t *table, ht_memory_t *usage) {
+    *usage = (ht_memory_t){0};
+    if (table != NULL) {
+        ht_memory_t *found = ht_memory_find(table);
+        if (found != NULL) *usage = *found;
+        usage->buckets = sizeof(*table);
+    } else {
+        for (int i = 0; i < ht_memory_registered; i++) {
+            usage->items += memory_registry[i].usage->items;
+            usage->keys += memory_registry[i].usage->keys;
+            usage->slack += memory_registry[i].usage->slack;
+            usage->rejections += memory_registry[i].usage->rejections;
+        }
+    }
+    usage->total = usage->buckets + usage->items + usage->keys + usage->slack;
+}
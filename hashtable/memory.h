@@ -0,0 +1,81 @@
+/*
+ * Hlavičkový súbor pre alokátor a spotrebu pamäte tabuľky s rozptýlenými
+ * položkami.
+ *
+ * Všetky prvky tabuliek (aj záznamy ht_cache_t a ht_ttl_t) sa alokujú cez
+ * nastaviteľný alokátor. Predvolený alokátor používa malloc a free. Vlastný
+ * alokátor môže alokáciu odmietnuť vrátením NULL; funkcia, ktorá prvok
+ * potrebovala, potom tabuľku nezmení (ht_insert_bulk a ht_batch vrátia
+ * false) a odmietnutie sa započíta.
+ *
+ * Spotreba pamäte sa udržiava priebežne pri každej alokácii a uvoľnení,
+ * ht_memory_usage preto tabuľku neprechádza. Počítadlá ht_memory_t vlastní
+ * volajúci a pripája ich k tabuľke funkciou ht_memory_attach; tabuľky bez
+ * nich sa nezapočítavajú a ich operácie stoja iba jedno porovnanie navyše.
+ * Počítadlá tabuľky mení iba operácia nad tou tabuľkou (ht_insert_bulk až
+ * po skončení vlákien), rôzne tabuľky je preto možné používať z rôznych
+ * vlákien. Pripájanie a odpájanie, rovnako ako pri filtroch, nie je
+ * bezpečné voči súbežnému používaniu tabuliek. Alokátor volaný
+ * z ht_insert_bulk musí byť bezpečný pre súbežné volanie.
+ *
+ * Dĺžka kľúča sa pri uvoľnení prvku zisťuje z kľúča (ht_ttl_clear), kľúče
+ * preto musia zostať platné, kým sú ich prvky v tabuľke.
+ */
+
+#ifndef IAL_HASHTABLE_MEMORY_H
+#define IAL_HASHTABLE_MEMORY_H
+
+#include "hashtable.h"
+#include <stdbool.h>
+#include <stddef.h>
+
+// Maximálny počet súčasne pripojených počítadiel
+#define HT_MEMORY_MAX_TABLES 16
+
+// Alokátor prvkov
+typedef struct ht_allocator {
+  void *(*allocate)(size_t size, void *context); // NULL alokáciu odmietne
+  void (*release)(void *pointer, size_t size, void *context);
+  // Počet bajtov, ktoré alokácia size skutočne obsadí (môže byť NULL)
+  size_t (*reserved)(size_t size, void *context);
+  void *context;
+} ht_allocator_t;
+
+// Spotreba pamäte v bajtoch (buckets a total dopĺňa ht_memory_usage)
+typedef struct ht_memory {
+  size_t buckets;           // pole tabuľky (MAX_HT_SIZE ukazovateľov)
+  size_t items;             // prvky a záznamy cache a ttl
+  size_t keys;              // reťazce kľúčov vrátane '\0' (tabuľka ich nevlastní)
+  size_t slack;             // réžia alokátora nad požadovanými veľkosťami
+  size_t total;             // súčet všetkých častí
+  unsigned long rejections; // počet odmietnutých alokácií
+} ht_memory_t;
+
+extern int ht_memory_registered;
+
+void ht_set_allocator(const ht_allocator_t *allocator);
+
+void *ht_allocate(size_t size);
+void ht_release(void *pointer, size_t size);
+void ht_memory_account(ht_table_t *table, size_t size, long count,
+                       long key_bytes, unsigned long rejections);
+void ht_memory_reset(ht_table_t *table);
+
+void *ht_item_allocate(ht_table_t *table, size_t size, size_t key_length);
+void ht_item_release(ht_table_t *table, void *item, size_t size,
+                     size_t key_length);
+
+bool ht_memory_attach(ht_table_t *table, ht_memory_t *usage);
+void ht_memory_detach(ht_table_t *table);
+ht_memory_t *ht_memory_lookup(ht_table_t *table);
+void ht_memory_usage(ht_table_t *table, ht_memory_t *usage);
+
+/*
+ * Počítadlá pripojené k tabuľke alebo NULL. Bez pripojených počítadiel stojí
+ * jedno porovnanie.
+ */
+static inline ht_memory_t *ht_memory_find(ht_table_t *table) {
+  return ht_memory_registered == 0 ? NULL : ht_memory_lookup(table);
+}
+
+#endif
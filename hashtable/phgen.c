@@ -0,0 +1,481 @@
+/*
+ * Generátor minimálnych perfektných tabuliek s rozptýlenými položkami
+ *
+ * Spustenie: ./phgen [-n názov] [-o výstup] kľúče.txt
+ *
+ * Vstupný súbor obsahuje na každom riadku kľúč a voliteľne za tabulátorom
+ * počiatočnú hodnotu (inak 0). Generátor zapíše súbory <výstup>.h a
+ * <výstup>.c s funkciami
+ *
+ *   float *<názov>_get(char *key);       // ako ht_get
+ *   int <názov>_index(const char *key);  // pozícia kľúča alebo -1
+ *
+ * Tabuľka má práve toľko pozícií, koľko je kľúčov, a je celá v statickej
+ * pamäti: nepotrebuje inicializáciu, ht_insert ani malloc. Hodnoty sa dajú
+ * meniť cez vrátený ukazovateľ, množina kľúčov je pevná.
+ *
+ * Použitá je metóda hash-and-displace: kľúč sa raz prečíta 64-bitovým
+ * FNV-1a, horná polovica súčtu určí skupinu a posun uložený pre skupinu
+ * určí pozíciu v tabuľke. Skupiny s jedným kľúčom ukazujú priamo na voľnú
+ * pozíciu (záporný posun). Vyhľadanie teda spočíta jeden súčet, prečíta
+ * jeden posun a porovná jeden kľúč.
+ */
+
+#include <ctype.h>
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Najväčší skúšaný posun pre jednu skupinu
+#define PHGEN_MAX_DISPLACEMENT (1u << 24)
+#define PHGEN_MAX_LINE 4096
+
+typedef struct phgen_key {
+    char *key;
+    size_t length;
+    float value;
+    uint64_t hash;
+} phgen_key_t;
+
+typedef struct phgen_bucket {
+    uint32_t index;
+    uint32_t size;
+    uint32_t *keys; // indexy kľúčov skupiny
+} phgen_bucket_t;
+
+/*
+ * Rozptyľovacie funkcie. Text funkcií, ktorý sa zapisuje do vygenerovaného
+ * súboru (PHGEN_HASH_SOURCE), musí zostať zhodný s týmito definíciami.
+ */
+static uint64_t phgen_hash(const char *key, size_t *length) {
+    uint64_t hash = 14695981039346656037u;
+    const char *start = key;
+    for (; *key != '\0'; key++) {
+        hash ^= (unsigned char)*key;
+        hash *= 1099511628211u;
+    }
+    *length = (size_t)(key - start);
+    return hash;
+}
+
+static uint32_t phgen_slot(uint64_t hash, uint32_t displacement,
+                           uint32_t size) {
+    hash += displacement * 0x9e3779b97f4a7c15u;
+    hash = (hash ^ (hash >> 30)) * 0xbf58476d1ce4e5b9u;
+    hash = (hash ^ (hash >> 27)) * 0x94d049bb133111ebu;
+    return (uint32_t)((hash ^ (hash >> 31)) % size);
+}
+
+static const char PHGEN_HASH_SOURCE[] =
+    "static uint64_t %s_hash(const char *key, size_t *length) {\n"
+    "    uint64_t hash = 14695981039346656037u;\n"
+    "    const char *start = key;\n"
+    "    for (; *key != '\\0'; key++) {\n"
+    "        hash ^= (unsigned char)*key;\n"
+    "        hash *= 1099511628211u;\n"
+    "    }\n"
+    "    *length = (size_t)(key - start);\n"
+    "    return hash;\n"
+    "}\n"
+    "\n"
+    "static uint32_t %s_slot(uint64_t hash, uint32_t displacement,\n"
+    "                        uint32_t size) {\n"
+    "    hash += displacement * 0x9e3779b97f4a7c15u;\n"
+    "    hash = (hash ^ (hash >> 30)) * 0xbf58476d1ce4e5b9u;\n"
+    "    hash = (hash ^ (hash >> 27)) * 0x94d049bb133111ebu;\n"
+    "    return (uint32_t)((hash ^ (hash >> 31)) %% size);\n"
+    "}\n";
+
+static int phgen_key_compare(const void *a, const void *b) {
+    return strcmp((*(const phgen_key_t *const *)a)->key,
+                  (*(const phgen_key_t *const *)b)->key);
+}
+
+static int phgen_bucket_compare(const void *a, const void *b) {
+    const phgen_bucket_t *x = a, *y = b;
+    if (x->size != y->size) return x->size < y->size ? 1 : -1;
+    return x->index < y->index ? -1 : x->index > y->index;
+}
+
+/*
+ * Načítanie kľúčov zo súboru. Pri chybe vráti funkcia hodnotu false.
+ */
+static bool phgen_read(const char *path, phgen_key_t **keys, uint32_t *count) {
+    FILE *file = fopen(path, "r");
+    if (file == NULL) {
+        fprintf(stderr, "phgen: %s sa nedá otvoriť\n", path);
+        return false;
+    }
+
+    char line[PHGEN_MAX_LINE];
+    uint32_t capacity = 16;
+    *keys = malloc(capacity * sizeof(phgen_key_t));
+    *count = 0;
+    if (*keys == NULL) abort();
+    while (fgets(line, sizeof(line), file) != NULL) {
+        size_t end = strcspn(line, "\r\n");
+        if (line[end] == '\0' && !feof(file)) {
+            fprintf(stderr, "phgen: príliš dlhý riadok v %s\n", path);
+            fclose(file);
+            return false;
+        }
+        line[end] = '\0';
+        if (end == 0) continue;
+
+        char *tab = strchr(line, '\t');
+        if (tab != NULL) *tab = '\0';
+        char *value = tab != NULL ? tab + 1 : "0";
+        char *parse_end;
+        float parsed = strtof(value, &parse_end);
+        if (*value == '\0' || *parse_end != '\0' || !isfinite(parsed)) {
+            fprintf(stderr, "phgen: neplatná hodnota \"%s\"\n", value);
+            fclose(file);
+            return false;
+        }
+
+        if (*count == capacity) {
+            capacity *= 2;
+            *keys = realloc(*keys, capacity * sizeof(phgen_key_t));
+            if (*keys == NULL) abort();
+        }
+        phgen_key_t *key = &(*keys)[(*count)++];
+        key->key = malloc(strlen(line) + 1);
+        if (key->key == NULL) abort();
+        strcpy(key->key, line);
+        key->value = parsed;
+        key->hash = phgen_hash(key->key, &key->length);
+    }
+    fclose(file);
+
+    if (*count == 0) {
+        fprintf(stderr, "phgen: %s neobsahuje žiadne kľúče\n", path);
+        return false;
+    }
+
+    // Opakovaný kľúč by sa nedal umiestniť, preto sa odmietne vopred
+    phgen_key_t **sorted = malloc(*count * sizeof(phgen_key_t *));
+    if (sorted == NULL) abort();
+    for (uint32_t i = 0; i < *count; i++) {
+        sorted[i] = &(*keys)[i];
+    }
+    qsort(sorted, *count, sizeof(phgen_key_t *), phgen_key_compare);
+    bool unique = true;
+    for (uint32_t i = 1; unique && i < *count; i++) {
+        if (strcmp(sorted[i - 1]->key, sorted[i]->key) == 0) {
+            fprintf(stderr, "phgen: kľúč \"%s\" sa opakuje\n",
+                    sorted[i]->key);
+            unique = false;
+        }
+    }
+    free(sorted);
+    return unique;
+}
+
+/*
+ * Výpočet posunov skupín a pozícií kľúčov.
+ *
+ * Skupiny sa spracujú od najväčšej; pre každú sa hľadá najmenší posun, pri
+ * ktorom všetky jej kľúče padnú na rôzne voľné pozície. Skupiny s jedným
+ * kľúčom dostanú zvyšné voľné pozície priamo.
+ */
+static bool phgen_build(phgen_key_t *keys, uint32_t count,
+                        int32_t *displacements, uint32_t *slots) {
+    phgen_bucket_t *buckets = calloc(count, sizeof(phgen_bucket_t));
+    uint32_t *members = malloc(count * sizeof(uint32_t));
+    bool *taken = calloc(count, sizeof(bool));
+    uint32_t *candidate = malloc(count * sizeof(uint32_t));
+    if (buckets == NULL || members == NULL || taken == NULL ||
+        candidate == NULL) {
+        abort();
+    }
+
+    for (uint32_t i = 0; i < count; i++) {
+        buckets[i].index = i;
+    }
+    for (uint32_t i = 0; i < count; i++) {
+        buckets[(uint32_t)(keys[i].hash >> 32) % count].size++;
+    }
+    uint32_t position = 0;
+    for (uint32_t b = 0; b < count; b++) {
+        buckets[b].keys = members + position;
+        position += buckets[b].size;
+        buckets[b].size = 0;
+    }
+    for (uint32_t i = 0; i < count; i++) {
+        phgen_bucket_t *bucket =
+            &buckets[(uint32_t)(keys[i].hash >> 32) % count];
+        bucket->keys[bucket->size++] = i;
+    }
+    qsort(buckets, count, sizeof(phgen_bucket_t), phgen_bucket_compare);
+
+    bool ok = true;
+    uint32_t free_slot = 0;
+    for (uint32_t b = 0; ok && b < count; b++) {
+        phgen_bucket_t *bucket = &buckets[b];
+        displacements[bucket->index] = 0;
+        if (bucket->size == 0) continue;
+
+        if (bucket->size == 1) {
+            while (taken[free_slot]) free_slot++;
+            taken[free_slot] = true;
+            slots[bucket->keys[0]] = free_slot;
+            displacements[bucket->index] = -(int32_t)free_slot - 1;
+            continue;
+        }
+
+        uint32_t displacement = 1;
+        for (; displacement < PHGEN_MAX_DISPLACEMENT; displacement++) {
+            uint32_t placed = 0;
+            for (; placed < bucket->size; placed++) {
+                uint32_t slot = phgen_slot(keys[bucket->keys[placed]].hash,
+                                           displacement, count);
+                if (taken[slot]) break;
+                taken[slot] = true;
+                candidate[placed] = slot;
+            }
+            if (placed == bucket->size) break;
+            for (uint32_t i = 0; i < placed; i++) {
+                taken[candidate[i]] = false;
+            }
+        }
+        if (displacement == PHGEN_MAX_DISPLACEMENT) {
+            fprintf(stderr, "phgen: posun pre skupinu sa nenašiel\n");
+            ok = false;
+            break;
+        }
+        for (uint32_t i = 0; i < bucket->size; i++) {
+            slots[bucket->keys[i]] = candidate[i];
+        }
+        displacements[bucket->index] = (int32_t)displacement;
+    }
+
+    free(buckets);
+    free(members);
+    free(taken);
+    free(candidate);
+    return ok;
+}
+
+/*
+ * Zápis hodnoty ako najkratšieho literálu typu float, ktorý sa prečíta
+ * presne ako value.
+ */
+static void phgen_write_float(FILE *file, float value) {
+    char text[32];
+    for (int precision = 6; precision <= 9; precision++) {
+        snprintf(text, sizeof(text), "%.*g", precision, value);
+        if (strtof(text, NULL) == value) break;
+    }
+    fprintf(file, "%s%sf", text, strpbrk(text, ".e") == NULL ? ".0" : "");
+}
+
+/*
+ * Zápis kľúča ako reťazcového literálu jazyka C.
+ */
+static void phgen_write_string(FILE *file, const char *key) {
+    fputc('"', file);
+    for (; *key != '\0'; key++) {
+        unsigned char c = (unsigned char)*key;
+        if (c == '"' || c == '\\') {
+            fprintf(file, "\\%c", c);
+        } else if (c < ' ' || c >= 127) {
+            fprintf(file, "\\%03o", c);
+        } else {
+            fputc(c, file);
+        }
+    }
+    fputc('"', file);
+}
+
+static bool phgen_write(const char *output, const char *name,
+                        const char *source, phgen_key_t *keys, uint32_t count,
+                        const int32_t *displacements, const uint32_t *slots) {
+    size_t path_length = strlen(output) + 3;
+    char *path = malloc(path_length);
+    if (path == NULL) abort();
+
+    uint32_t *order = malloc(count * sizeof(uint32_t));
+    if (order == NULL) abort();
+    for (uint32_t i = 0; i < count; i++) {
+        order[slots[i]] = i;
+    }
+
+    snprintf(path, path_length, "%s.h", output);
+    FILE *file = fopen(path, "w");
+    if (file == NULL) {
+        fprintf(stderr, "phgen: %s sa nedá vytvoriť\n", path);
+        free(path);
+        free(order);
+        return false;
+    }
+    const char *base = strrchr(output, '/');
+    base = base != NULL ? base + 1 : output;
+    fprintf(file,
+            "/*\n"
+            " * Perfektná tabuľka %s vygenerovaná programom phgen zo súboru\n"
+            " * %s. Súbor neupravujte, zmeňte zoznam kľúčov.\n"
+            " */\n\n",
+            name, source);
+    fprintf(file, "#ifndef PHGEN_%s_H\n#define PHGEN_%s_H\n\n", name, name);
+    fprintf(file, "// Počet kľúčov (a pozícií) tabuľky\n");
+    fprintf(file, "#define %s_SIZE %u\n\n", name, count);
+    fprintf(file, "float *%s_get(char *key);\n", name);
+    fprintf(file, "int %s_index(const char *key);\n\n#endif\n", name);
+    bool ok = fclose(file) == 0;
+
+    snprintf(path, path_length, "%s.c", output);
+    file = fopen(path, "w");
+    if (file == NULL) {
+        fprintf(stderr, "phgen: %s sa nedá vytvoriť\n", path);
+        free(path);
+        free(order);
+        return false;
+    }
+    fprintf(file,
+            "/*\n"
+            " * Perfektná tabuľka %s vygenerovaná programom phgen zo súboru\n"
+            " * %s. Súbor neupravujte, zmeňte zoznam kľúčov.\n"
+            " */\n\n",
+            name, source);
+    fprintf(file, "#include \"%s.h\"\n", base);
+    fprintf(file, "#include <stddef.h>\n#include <stdint.h>\n"
+                  "#include <string.h>\n\n");
+
+    fprintf(file, "static const int32_t %s_displacements[%u] = {", name,
+            count);
+    for (uint32_t i = 0; i < count; i++) {
+        fprintf(file, "%s%d,", i % 8 == 0 ? "\n    " : " ", displacements[i]);
+    }
+    fprintf(file, "\n};\n\n");
+
+    fprintf(file, "static const struct {\n    const char *key;\n"
+                  "    uint32_t length;\n} %s_keys[%u] = {\n",
+            name, count);
+    for (uint32_t s = 0; s < count; s++) {
+        fprintf(file, "    {");
+        phgen_write_string(file, keys[order[s]].key);
+        fprintf(file, ", %zu},\n", keys[order[s]].length);
+    }
+    fprintf(file, "};\n\n");
+
+    fprintf(file, "static float %s_values[%u] = {", name, count);
+    for (uint32_t s = 0; s < count; s++) {
+        fprintf(file, "%s", s % 4 == 0 ? "\n    " : " ");
+        phgen_write_float(file, keys[order[s]].value);
+        fputc(',', file);
+    }
+    fprintf(file, "\n};\n\n");
+
+    fprintf(file, PHGEN_HASH_SOURCE, name, name);
+    fprintf(file,
+            "\n"
+            "/*\n"
+            " * Pozícia kľúča v tabuľke alebo -1, ak kľúč do tabuľky nepatrí.\n"
+            " */\n"
+            "int %s_index(const char *key) {\n"
+            "    size_t length;\n"
+            "    uint64_t hash = %s_hash(key, &length);\n"
+            "    int32_t displacement =\n"
+            "        %s_displacements[(uint32_t)(hash >> 32) %% %uu];\n"
+            "    uint32_t slot =\n"
+            "        displacement < 0\n"
+            "            ? (uint32_t)(-(displacement + 1))\n"
+            "            : %s_slot(hash, (uint32_t)displacement, %uu);\n"
+            "\n"
+            "    if (%s_keys[slot].length != length ||\n"
+            "        memcmp(%s_keys[slot].key, key, length) != 0) {\n"
+            "        return -1;\n"
+            "    }\n"
+            "    return (int)slot;\n"
+            "}\n"
+            "\n"
+            "/*\n"
+            " * Získanie hodnoty z tabuľky.\n"
+            " *\n"
+            " * V prípade úspechu vráti funkcia ukazovateľ na hodnotu prvku,\n"
+            " * v opačnom prípade hodnotu NULL.\n"
+            " */\n"
+            "float *%s_get(char *key) {\n"
+            "    int slot = %s_index(key);\n"
+            "\n"
+            "    return slot < 0 ? NULL : &%s_values[slot];\n"
+            "}\n",
+            name, name, name, count, name, count, name, name, name, name,
+            name);
+    ok = fclose(file) == 0 && ok;
+
+    free(path);
+    free(order);
+    return ok;
+}
+
+/*
+ * Názov sa stáva súčasťou identifikátorov vo vygenerovanom kóde, musí byť
+ * preto platným identifikátorom jazyka C.
+ */
+static bool phgen_valid_name(const char *name) {
+    if (!isalpha((unsigned char)name[0]) && name[0] != '_') return false;
+    for (const char *c = name + 1; *c != '\0'; c++) {
+        if (!isalnum((unsigned char)*c) && *c != '_') return false;
+    }
+    return true;
+}
+
+int main(int argc, char *argv[]) {
+    const char *name = "perfect";
+    const char *output = NULL;
+    const char *source = NULL;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+            name = argv[++i];
+        } else if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+            output = argv[++i];
+        } else if (argv[i][0] != '-' && source == NULL) {
+            source = argv[i];
+        } else {
+            source = NULL;
+            break;
+        }
+    }
+    if (source == NULL) {
+        fprintf(stderr, "Použitie: %s [-n názov] [-o výstup] kľúče.txt\n",
+                argv[0]);
+        return 2;
+    }
+    if (!phgen_valid_name(name)) {
+        fprintf(stderr, "phgen: názov \"%s\" nie je identifikátor jazyka C\n",
+                name);
+        return 2;
+    }
+    if (output == NULL) output = name;
+
+    phgen_key_t *keys = NULL;
+    uint32_t count = 0;
+    if (!phgen_read(source, &keys, &count)) {
+        for (uint32_t i = 0; i < count; i++) {
+            free(keys[i].key);
+        }
+        free(keys);
+        return 1;
+    }
+
+    int32_t *displacements = malloc(count * sizeof(int32_t));
+    uint32_t *slots = malloc(count * sizeof(uint32_t));
+    if (displacements == NULL || slots == NULL) abort();
+
+    bool ok = phgen_build(keys, count, displacements, slots) &&
+              phgen_write(output, name, source, keys, count, displacements,
+                           slots);
+
+    for (uint32_t i = 0; i < count; i++) {
+        free(keys[i].key);
+    }
+    free(keys);
+    free(displacements);
+    free(slots);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,106 @@
+/*
+ * Prechod položkami tabuľky s rozptýlenými položkami
+ *
+ * Popis záruk prechodu je v súbore scan.h.
+ *
+ * Kurzor je index nasledujúceho zoznamu synonym. Keďže sa zoznam spracuje
+ * vždy celý a položka počas svojej existencie nemení index, stačí na
+ * záruku „práve raz“ postupovať po indexoch. Nulový kurzor začína prechod,
+ * návratová hodnota 0 ho ukončuje.
+ */
+
+#include "scan.h"
+#include <stdlib.h>
+#include <string.h>
+
+// Najväčší počet prázdnych zoznamov na jednu požadovanú položku
+#define SCAN_EMPTY_FACTOR 10
+
+/*
+ * Jeden krok kurzorového prechodu.
+ *
+ * Funkcia spracuje celé zoznamy synonym od indexu cursor, kým nenahlási
+ * aspoň count položiek alebo kým neprejde count * SCAN_EMPTY_FACTOR
+ * prázdnych zoznamov, a vráti kurzor pre ďalšie volanie (0 po poslednom
+ * zozname). Práca jedného volania je tak obmedzená aj pri riedkej tabuľke.
+ *
+ * Funkcia callback smie nahlásenú položku zmazať (ht_delete), iné zmeny
+ * tabuľky sú dovolené iba medzi volaniami.
+ */
+int ht_scan(ht_table_t *table, int cursor, int count,
+            ht_scan_callback_t callback, void *context) {
+    if (count < 1) count = 1;
+    if (cursor < 0 || cursor >= HT_SIZE) return 0;
+
+    int reported = 0;
+    int empty_budget = count * SCAN_EMPTY_FACTOR;
+    while (cursor < HT_SIZE && reported < count && empty_budget > 0) {
+        ht_item_t *item = (*table)[cursor];
+        if (item == NULL) empty_budget--;
+        while (item != NULL) {
+            ht_item_t *next = item->next;
+            callback(item, context);
+            reported++;
+            item = next;
+        }
+        cursor++;
+    }
+    return cursor < HT_SIZE ? cursor : 0;
+}
+
+static int iterator_compare(const void *a, const void *b) {
+    return strcmp(((const ht_item_t *)a)->key, ((const ht_item_t *)b)->key);
+}
+
+/*
+ * Vytvorenie iterátora nad kópiou všetkých položiek tabuľky.
+ *
+ * Pre sorted == true vracia iterátor položky vzostupne podľa kľúča (strcmp),
+ * inak v poradí indexov a zoznamov synonym. Pri nedostatku pamäte vráti
+ * funkcia hodnotu false.
+ */
+bool ht_iterator_init(ht_iterator_t *iterator, ht_table_t *table,
+                      bool sorted) {
+    size_t count = 0;
+    for (int i = 0; i < HT_SIZE; i++) {
+        for (ht_item_t *item = (*table)[i]; item != NULL; item = item->next) {
+            count++;
+        }
+    }
+
+    iterator->items = malloc((count > 0 ? count : 1) * sizeof(ht_item_t));
+    iterator->count = 0;
+    iterator->position = 0;
+    if (iterator->items == NULL) return false;
+
+    for (int i = 0; i < HT_SIZE; i++) {
+        for (ht_item_t *item = (*table)[i]; item != NULL; item = item->next) {
+            ht_item_t *copy = &iterator->items[iterator->count++];
+            *copy = *item;
+            copy->next = NULL;
+        }
+    }
+    if (sorted) {
+        qsort(iterator->items, iterator->count, sizeof(ht_item_t),
+              iterator_compare);
+    }
+    return true;
+}
+
+/*
+ * Nasledujúca položka iterátora alebo NULL na konci.
+ */
+ht_item_t *ht_iterator_next(ht_iterator_t *iterator) {
+    if (iterator->position == iterator->count) return NULL;
+    return &iterator->items[iterator->position++];
+}
+
+/*
+ * Zrušenie iterátora.
+ */
+void ht_iterator_dispose(ht_iterator_t *iterator) {
+    free(iterator->items);
+    iterator->items = NULL;
+    iterator->count = 0;
+    iterator->position = 0;
+}
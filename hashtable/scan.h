@@ -0,0 +1,43 @@
+/*
+ * Hlavičkový súbor pre prechod položkami tabuľky s rozptýlenými položkami.
+ *
+ * Kurzorový prechod (ht_scan) spracuje pri jednom volaní iba niekoľko
+ * zoznamov synonym a vráti kurzor, ktorým sa pokračuje. Medzi volaniami sa
+ * tabuľka môže ľubovoľne meniť: každá položka, ktorá je v tabuľke počas
+ * celého prechodu, sa nahlási práve raz; položky vložené alebo zmazané
+ * počas prechodu sa nahlásiť môžu aj nemusia. Tabuľka nemení počet
+ * indexov sama od seba; ak sa počas prechodu zmení HT_SIZE, kurzor stráca
+ * platnosť a prechod treba začať znova.
+ *
+ * Iterátor (ht_iterator_t) pri vytvorení skopíruje všetky položky, prípadne
+ * ich zoradí podľa kľúča, a ďalej už tabuľku nečíta. Vracia teda konzistentný
+ * obraz tabuľky v okamihu vytvorenia bez ohľadu na neskoršie zmeny. Kľúče
+ * sa nekopírujú, musia existovať až do zrušenia iterátora.
+ */
+
+#ifndef IAL_HASHTABLE_SCAN_H
+#define IAL_HASHTABLE_SCAN_H
+
+#include "hashtable.h"
+#include <stdbool.h>
+#include <stddef.h>
+
+// Funkcia volaná pre nahlásené položky
+typedef void (*ht_scan_callback_t)(ht_item_t *item, void *context);
+
+// Iterátor nad kópiou položiek tabuľky
+typedef struct ht_iterator {
+  ht_item_t *items; // kópie položiek (next je NULL)
+  size_t count;     // počet položiek
+  size_t position;  // index nasledujúcej vrátenej položky
+} ht_iterator_t;
+
+int ht_scan(ht_table_t *table, int cursor, int count,
+            ht_scan_callback_t callback, void *context);
+
+bool ht_iterator_init(ht_iterator_t *iterator, ht_table_t *table,
+                      bool sorted);
+ht_item_t *ht_iterator_next(ht_iterator_t *iterator);
+void ht_iterator_dispose(ht_iterator_t *iterator);
+
+#endif
@@ -0,0 +1,20 @@
+/*
+ * Hlavičkový súbor pre nastavenie hľadania v tabuľke s rozptýlenými
+ * položkami.
+ *
+ * Nastavenie je v samostatnom súbore, pretože hashtable.h sa nemení.
+ */
+
+#ifndef IAL_HASHTABLE_SEARCH_H
+#define IAL_HASHTABLE_SEARCH_H
+
+#include <stdbool.h>
+
+/*
+ * Presúvanie nájdeného prvku na začiatok zoznamu synonym (predvolene
+ * vypnuté). Hodí sa pri nerovnomernom prístupe, keď sa opakovane hľadá
+ * malá skupina kľúčov.
+ */
+extern bool HT_MOVE_TO_FRONT;
+
+#endif
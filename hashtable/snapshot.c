@@ -0,0 +1,246 @@
+/*
+ * Perzistentný snapshot tabuľky s rozptýlenými položkami
+ *
+ * Popis formátu je v súbore snapshot.h.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "snapshot.h"
+#include "key.h"
+#include "../common/snapshot_file.h"
+#include <stdio.h>
+#include <string.h>
+
+/*
+ * Rozptyľovacia funkcia zhodná s get_hash, ale pre veľkosť tabuľky uloženú
+ * v snapshote (nezávisle od aktuálnej hodnoty HT_SIZE).
+ */
+static uint32_t snapshot_hash(const char *key, uint32_t bucket_count) {
+    size_t length;
+    return (uint32_t)(ht_key_sum(key, &length) % (int)bucket_count);
+}
+
+static bool snapshot_write(FILE *file, const void *data, size_t size,
+                           uint32_t *checksum) {
+    *checksum = snapshot_file_checksum(*checksum, data, size);
+    return fwrite(data, 1, size, file) == size;
+}
+
+/*
+ * Uloženie tabuľky do súboru postupom zo súboru common/snapshot_file.h.
+ *
+ * V prípade úspechu vráti funkcia hodnotu true.
+ */
+bool ht_snapshot_save(ht_table_t *table, const char *path) {
+    ht_snapshot_header_t header = {
+        .magic = HT_SNAPSHOT_MAGIC,
+        .version = HT_SNAPSHOT_VERSION,
+        .endian = HT_SNAPSHOT_ENDIAN,
+        .bucket_count = (uint32_t)HT_SIZE,
+        .checksum = SNAPSHOT_FILE_CHECKSUM,
+    };
+
+    for (int i = 0; i < HT_SIZE; i++) {
+        for (ht_item_t *item = (*table)[i]; item != NULL; item = item->next) {
+            header.item_count++;
+            header.strings_size += strlen(item->key) + 1;
+        }
+    }
+    header.file_size = sizeof(header) +
+                       (header.bucket_count + 1) * sizeof(uint32_t) +
+                       header.item_count * sizeof(ht_snapshot_item_t) +
+                       header.strings_size;
+
+    snapshot_file_t output;
+    if (!snapshot_file_create(&output, path)) return false;
+    FILE *file = output.file;
+
+    bool ok = fwrite(&header, sizeof(header), 1, file) == 1;
+
+    uint32_t start = 0;
+    for (int i = 0; ok && i < HT_SIZE; i++) {
+        ok = snapshot_write(file, &start, sizeof(start), &header.checksum);
+        for (ht_item_t *item = (*table)[i]; item != NULL; item = item->next) {
+            start++;
+        }
+    }
+    if (ok) ok = snapshot_write(file, &start, sizeof(start), &header.checksum);
+
+    uint32_t offset = 0;
+    for (int i = 0; ok && i < HT_SIZE; i++) {
+        for (ht_item_t *item = (*table)[i]; ok && item != NULL;
+             item = item->next) {
+            ht_snapshot_item_t record = {offset, item->value};
+            ok = snapshot_write(file, &record, sizeof(record), &header.checksum);
+            offset += strlen(item->key) + 1;
+        }
+    }
+
+    for (int i = 0; ok && i < HT_SIZE; i++) {
+        for (ht_item_t *item = (*table)[i]; ok && item != NULL;
+             item = item->next) {
+            ok = snapshot_write(file, item->key, strlen(item->key) + 1,
+                                &header.checksum);
+        }
+    }
+
+    if (ok) ok = fseek(file, 0, SEEK_SET) == 0;
+    if (ok) ok = fwrite(&header, sizeof(header), 1, file) == 1;
+    return snapshot_file_finish(&output, ok);
+}
+
+/*
+ * Kontrola hlavičky a rozloženia namapovaného súboru.
+ *
+ * Overí iba údaje potrebné na bezpečné vyhľadávanie, kontrolný súčet
+ * neprepočítava.
+ */
+static bool snapshot_check_layout(ht_snapshot_t *snapshot) {
+    const ht_snapshot_header_t *header = snapshot->data;
+
+    if (snapshot->size < sizeof(*header)) return false;
+    if (header->magic != HT_SNAPSHOT_MAGIC ||
+        header->version != HT_SNAPSHOT_VERSION ||
+        header->endian != HT_SNAPSHOT_ENDIAN) {
+        return false;
+    }
+    if (header->bucket_count == 0 || header->bucket_count > MAX_HT_SIZE) {
+        return false;
+    }
+
+    uint64_t expected = sizeof(*header) +
+                        ((uint64_t)header->bucket_count + 1) * sizeof(uint32_t) +
+                        (uint64_t)header->item_count *
+                            sizeof(ht_snapshot_item_t) +
+                        header->strings_size;
+    if (header->file_size != expected || snapshot->size != expected) {
+        return false;
+    }
+
+    snapshot->header = header;
+    snapshot->buckets = (const uint32_t *)(header + 1);
+    snapshot->items = (const ht_snapshot_item_t *)(snapshot->buckets +
+                                                   header->bucket_count + 1);
+    snapshot->strings = (const char *)(snapshot->items + header->item_count);
+
+    if (snapshot->buckets[header->bucket_count] != header->item_count) {
+        return false;
+    }
+    if (header->strings_size > 0 &&
+        snapshot->strings[header->strings_size - 1] != '\0') {
+        return false;
+    }
+    return header->item_count == 0 || header->strings_size > 0;
+}
+
+/*
+ * Načítanie snapshotu namapovaním súboru do pamäte.
+ *
+ * Funkcia neprepočítava kontrolný súčet (na to slúži ht_snapshot_validate),
+ * overí iba hlavičku a rozloženie súboru. Indexy a offsety sa kontrolujú
+ * až pri ich použití.
+ *
+ * V prípade úspechu vráti funkcia hodnotu true.
+ */
+bool ht_snapshot_open(ht_snapshot_t *snapshot, const char *path) {
+    memset(snapshot, 0, sizeof(*snapshot));
+
+    snapshot->data = snapshot_file_map(path, &snapshot->size);
+    if (snapshot->data == NULL) return false;
+
+    if (!snapshot_check_layout(snapshot)) {
+        ht_snapshot_close(snapshot);
+        return false;
+    }
+    return true;
+}
+
+/*
+ * Uvoľnenie mapovania snapshotu.
+ *
+ * Kľúče položiek obnovených funkciou ht_snapshot_restore sa tým stanú
+ * neplatnými.
+ */
+void ht_snapshot_close(ht_snapshot_t *snapshot) {
+    snapshot_file_unmap(snapshot->data, snapshot->size);
+    memset(snapshot, 0, sizeof(*snapshot));
+}
+
+/*
+ * Úplná kontrola súboru so snapshotom.
+ *
+ * Okrem hlavičky overí kontrolný súčet, monotónnosť reťazcov synonym a
+ * platnosť všetkých offsetov kľúčov.
+ */
+bool ht_snapshot_validate(const char *path) {
+    ht_snapshot_t snapshot;
+    if (!ht_snapshot_open(&snapshot, path)) return false;
+
+    const ht_snapshot_header_t *header = snapshot.header;
+    bool ok = snapshot_file_checksum(SNAPSHOT_FILE_CHECKSUM, header + 1,
+                                     snapshot.size - sizeof(*header)) ==
+              header->checksum;
+
+    for (uint32_t i = 0; ok && i < header->bucket_count; i++) {
+        ok = snapshot.buckets[i] <= snapshot.buckets[i + 1];
+    }
+    for (uint32_t i = 0; ok && i < header->item_count; i++) {
+        ok = snapshot.items[i].key_offset < header->strings_size;
+    }
+
+    ht_snapshot_close(&snapshot);
+    return ok;
+}
+
+/*
+ * Vyhľadanie hodnoty priamo v namapovanom snapshote.
+ *
+ * V prípade úspechu vráti funkcia ukazovateľ na hodnotu (iba na čítanie),
+ * v opačnom prípade hodnotu NULL.
+ */
+const float *ht_snapshot_get(ht_snapshot_t *snapshot, char *key) {
+    const ht_snapshot_header_t *header = snapshot->header;
+    uint32_t index = snapshot_hash(key, header->bucket_count);
+    if (index >= header->bucket_count) return NULL;
+
+    uint32_t end = snapshot->buckets[index + 1];
+
+    if (end > header->item_count) return NULL;
+
+    for (uint32_t i = snapshot->buckets[index]; i < end; i++) {
+        const ht_snapshot_item_t *item = &snapshot->items[i];
+        if (item->key_offset >= header->strings_size) return NULL;
+        if (strcmp(snapshot->strings + item->key_offset, key) == 0) {
+            return &item->value;
+        }
+    }
+    return NULL;
+}
+
+/*
+ * Obnovenie tabuľky zo snapshotu.
+ *
+ * Kľúče vložených položiek ukazujú priamo do mapovania, preto musí snapshot
+ * zostať otvorený, kým sa tabuľka používa.
+ *
+ * Offsety kľúčov sa overia pred vložením prvej položky. Ak je niektorý
+ * mimo bloku s kľúčmi, tabuľka sa nezmení a funkcia vráti hodnotu false.
+ */
+bool ht_snapshot_restore(ht_snapshot_t *snapshot, ht_table_t *table) {
+    const ht_snapshot_header_t *header = snapshot->header;
+
+    for (uint32_t i = 0; i < header->item_count; i++) {
+        if (snapshot->items[i].key_offset >= header->strings_size) {
+            return false;
+        }
+    }
+
+    // Odzadu, aby ht_insert zachoval poradie synonym
+    for (uint32_t i = header->item_count; i-- > 0;) {
+        const ht_snapshot_item_t *item = &snapshot->items[i];
+        ht_insert(table, (char *)snapshot->strings + item->key_offset,
+                  item->value);
+    }
+    return true;
+}
@@ -0,0 +1,65 @@
+/*
+ * Hlavičkový súbor pre perzistentný snapshot tabuľky s rozptýlenými položkami.
+ *
+ * Snapshot je kompaktný binárny obraz tabuľky, ktorý sa pri načítaní iba
+ * namapuje do pamäte (mmap) a používa sa priamo — bez alokácie jednotlivých
+ * položiek. Namiesto ukazovateľov obsahuje iba indexy a offsety.
+ *
+ * Formát súboru (verzia 1, natívne poradie bajtov):
+ *   ht_snapshot_header_t                 hlavička
+ *   uint32_t buckets[bucket_count + 1]   začiatok reťazca synonym v poli položiek
+ *   ht_snapshot_item_t items[item_count] položky zoradené podľa indexu v tabuľke
+ *   char strings[strings_size]           kľúče ukončené znakom '\0'
+ *
+ * Kontrolný súčet (FNV-1a) pokrýva všetky dáta za hlavičkou.
+ */
+
+#ifndef IAL_HASHTABLE_SNAPSHOT_H
+#define IAL_HASHTABLE_SNAPSHOT_H
+
+#include "hashtable.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define HT_SNAPSHOT_MAGIC 0x53544849u // "IHTS"
+#define HT_SNAPSHOT_VERSION 1
+#define HT_SNAPSHOT_ENDIAN 0x0102
+
+// Hlavička súboru
+typedef struct ht_snapshot_header {
+  uint32_t magic;        // HT_SNAPSHOT_MAGIC
+  uint16_t version;      // HT_SNAPSHOT_VERSION
+  uint16_t endian;       // HT_SNAPSHOT_ENDIAN v poradí bajtov zapisovateľa
+  uint32_t bucket_count; // veľkosť tabuľky (HT_SIZE) v čase uloženia
+  uint32_t item_count;   // počet položiek
+  uint32_t strings_size; // veľkosť bloku s kľúčmi
+  uint32_t checksum;     // FNV-1a všetkých dát za hlavičkou
+  uint64_t file_size;    // celková veľkosť súboru
+} ht_snapshot_header_t;
+
+// Položka snapshotu
+typedef struct ht_snapshot_item {
+  uint32_t key_offset; // offset kľúča v bloku s kľúčmi
+  float value;         // hodnota položky
+} ht_snapshot_item_t;
+
+// Namapovaný snapshot
+typedef struct ht_snapshot {
+  void *data;                        // začiatok mapovania
+  size_t size;                       // veľkosť mapovania
+  const ht_snapshot_header_t *header;
+  const uint32_t *buckets;
+  const ht_snapshot_item_t *items;
+  const char *strings;
+} ht_snapshot_t;
+
+bool ht_snapshot_save(ht_table_t *table, const char *path);
+bool ht_snapshot_open(ht_snapshot_t *snapshot, const char *path);
+void ht_snapshot_close(ht_snapshot_t *snapshot);
+bool ht_snapshot_validate(const char *path);
+
+const float *ht_snapshot_get(ht_snapshot_t *snapshot, char *key);
+bool ht_snapshot_restore(ht_snapshot_t *snapshot, ht_table_t *table);
+
+#endif
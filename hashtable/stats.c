@@ -0,0 +1,49 @@
+/*
+ * Štatistiky tabuľky s rozptýlenými položkami
+ */
+
+#include "stats.h"
+#include <string.h>
+
+ht_stats_t ht_stats;
+
+/*
+ * Zaznamenanie jedného hľadania, pri ktorom sa porovnalo probes prvkov.
+ */
+void ht_stats_search(unsigned probes) {
+    ht_stats.searches++;
+    ht_stats.probes += probes;
+    ht_stats.probe_histogram[probes < HT_STATS_MAX_PROBE ? probes
+                                                         : HT_STATS_MAX_PROBE]++;
+}
+
+/*
+ * Vynulovanie všetkých počítadiel.
+ */
+void ht_stats_reset(void) {
+    memset(&ht_stats, 0, sizeof(ht_stats));
+}
+
+/*
+ * Výpis štatistík do súboru file.
+ */
+void ht_stats_dump(FILE *file) {
+#ifndef IAL_STATS
+    fprintf(file, "Statistics disabled (build with -DIAL_STATS)\n");
+#else
+    fprintf(file, "Searches: %lu\n", ht_stats.searches);
+    fprintf(file, "Average probe length: %.2f\n",
+            ht_stats.searches > 0
+                ? (double)ht_stats.probes / ht_stats.searches
+                : 0.0);
+    fprintf(file, "Probe length histogram:\n");
+    for (int i = 0; i <= HT_STATS_MAX_PROBE; i++) {
+        if (ht_stats.probe_histogram[i] == 0) continue;
+        fprintf(file, "  %s%2d: %lu\n", i == HT_STATS_MAX_PROBE ? ">=" : "  ",
+                i, ht_stats.probe_histogram[i]);
+    }
+    fprintf(file, "Allocations: %lu\n", ht_stats.allocations);
+    fprintf(file, "Frees: %lu\n", ht_stats.frees);
+    fprintf(file, "Live items: %lu\n", ht_stats.allocations - ht_stats.frees);
+#endif
+}
@@ -0,0 +1,39 @@
+/*
+ * Hlavičkový súbor pre štatistiky tabuľky s rozptýlenými položkami.
+ *
+ * Počítadlá sa zbierajú iba pri preklade s makrom IAL_STATS
+ * (make test STATS=1). Bez neho sa makro HT_STAT rozvinie na nič a
+ * štatistiky nemajú žiadnu réžiu. Počítadlá nie sú atomické, pri súbežnom
+ * používaní tabuľky sú preto iba orientačné.
+ */
+
+#ifndef IAL_HASHTABLE_STATS_H
+#define IAL_HASHTABLE_STATS_H
+
+#include <stdio.h>
+
+// Počet košov histogramu dĺžok prehľadávania, posledný kôš zahŕňa dlhšie
+#define HT_STATS_MAX_PROBE 16
+
+#ifdef IAL_STATS
+#define HT_STAT(STATEMENT) STATEMENT
+#else
+#define HT_STAT(STATEMENT)
+#endif
+
+// Štatistiky tabuľky
+typedef struct ht_stats {
+  unsigned long searches;    // počet volaní ht_search
+  unsigned long probes;      // počet porovnaných prvkov vo všetkých hľadaniach
+  unsigned long probe_histogram[HT_STATS_MAX_PROBE + 1]; // hľadania podľa dĺžky
+  unsigned long allocations; // počet alokovaných prvkov
+  unsigned long frees;       // počet uvoľnených prvkov
+} ht_stats_t;
+
+extern ht_stats_t ht_stats;
+
+void ht_stats_search(unsigned probes);
+void ht_stats_reset(void);
+void ht_stats_dump(FILE *file);
+
+#endif
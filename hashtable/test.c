@@ -1,7 +1,26 @@
+#define _DEFAULT_SOURCE
+
 #include "hashtable.h"
+#include "batch.h"
+#include "bulk.h"
+#include "cache.h"
+#include "column.h"
+#include "filter.h"
+#include "key.h"
+#include "memory.h"
+#include "perfect_test.h"
+#include "scan.h"
+#include "search.h"
+#include "snapshot.h"
+#include "stats.h"
+#include "ttl.h"
+#include "wal.h"
 #include "test_util.h"
+#include <signal.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
 
 #define INSERT_TEST_DATA(TABLE)                                                \
   ht_insert_many(TABLE, TEST_DATA, sizeof(TEST_DATA) / sizeof(TEST_DATA[0]));
@@ -13,6 +32,43 @@ const ht_item_t TEST_DATA[15] = {
     {"USD Coin", 0.86},    {"Uniswap", 21.68},    {"Terra", 30.67},
     {"Litecoin", 156.87},  {"Avalanche", 47.03},  {"Chainlink", 21.90}};
 
+void test_cache_removed(ht_item_t *item, ht_cache_reason_t reason,
+                        void *context) {
+  static const char *reasons[] = {"evicted", "removed", "cleared"};
+  ht_table_t *table = context;
+  printf("Removed (%s,%.2f): %s, in table: %s\n", item->key, item->value,
+         reasons[reason], ht_search(table, item->key) != NULL ? "yes" : "no");
+}
+
+void test_ttl_expired(ht_item_t *item, void *context) {
+  printf("Expired (%s,%.2f)\n", item->key, item->value);
+}
+
+void test_scan_print(ht_item_t *item, void *context) {
+  int *reported = context;
+  printf("(%s,%.2f)", item->key, item->value);
+  (*reported)++;
+}
+
+// Alokátor s obmedzením na limit bajtov
+typedef struct test_cap {
+  size_t used;
+  size_t limit;
+} test_cap_t;
+
+void *test_cap_allocate(size_t size, void *context) {
+  test_cap_t *cap = context;
+  if (cap->used + size > cap->limit) return NULL;
+  cap->used += size;
+  return malloc(size);
+}
+
+void test_cap_release(void *pointer, size_t size, void *context) {
+  test_cap_t *cap = context;
+  cap->used -= size;
+  free(pointer);
+}
+
 void init_test() {
   printf("Hash Table - testing script\n");
   printf("---------------------------\n");
@@ -76,6 +132,378 @@ INSERT_TEST_DATA(test_table)
 ht_delete_all(test_table);
 ENDTEST
 
+TEST(test_snapshot, "Save, validate and search a snapshot")
+ht_init(test_table);
+INSERT_TEST_DATA(test_table)
+ht_snapshot_t snapshot;
+ht_snapshot_save(test_table, "test_snapshot.bin");
+printf("Valid: %s\n", ht_snapshot_validate("test_snapshot.bin") ? "yes" : "no");
+if (ht_snapshot_open(&snapshot, "test_snapshot.bin")) {
+  const float *value = ht_snapshot_get(&snapshot, "Terra");
+  ht_print_item_value((float *)value);
+  value = ht_snapshot_get(&snapshot, "Monero");
+  ht_print_item_value((float *)value);
+  ht_snapshot_close(&snapshot);
+}
+remove("test_snapshot.bin");
+ENDTEST
+
+TEST(test_snapshot_restore, "Restore a table and reject a corrupt snapshot")
+ht_init(test_table);
+INSERT_TEST_DATA(test_table)
+ht_snapshot_save(test_table, "test_snapshot.bin");
+ht_delete_all(test_table);
+ht_snapshot_t snapshot;
+if (ht_snapshot_open(&snapshot, "test_snapshot.bin")) {
+  printf("Restored: %s\n",
+         ht_snapshot_restore(&snapshot, test_table) ? "yes" : "no");
+  ht_print_table(test_table);
+  ht_delete_all(test_table);
+  ht_snapshot_close(&snapshot);
+}
+FILE *file = fopen("test_snapshot.bin", "r+b");
+ht_snapshot_item_t bad = {UINT32_MAX, 0};
+fseek(file,
+      sizeof(ht_snapshot_header_t) + (HT_SIZE + 1) * sizeof(uint32_t) +
+          sizeof(ht_snapshot_item_t),
+      SEEK_SET);
+fwrite(&bad, sizeof(bad), 1, file);
+fclose(file);
+if (ht_snapshot_open(&snapshot, "test_snapshot.bin")) {
+  printf("Corrupt restored: %s\n",
+         ht_snapshot_restore(&snapshot, test_table) ? "yes" : "no");
+  ht_snapshot_close(&snapshot);
+}
+remove("test_snapshot.bin");
+ENDTEST
+
+TEST(test_wal_recover, "Replay the write-ahead log into a new table")
+ht_init(test_table);
+ht_wal_t wal;
+remove("test_wal.log");
+ht_wal_open(&wal, "test_wal.log", HT_WAL_SYNC_GROUP, 4);
+for (int i = 0; i < 5; i++) {
+  ht_wal_insert(&wal, test_table, TEST_DATA[i].key, TEST_DATA[i].value);
+}
+ht_wal_insert(&wal, test_table, "Ethereum", 12.34);
+ht_wal_delete(&wal, test_table, "Tether");
+ht_wal_close(&wal);
+ht_table_t *recovered_table;
+init_test_table(&recovered_table);
+ht_init(recovered_table);
+ht_wal_open(&wal, "test_wal.log", HT_WAL_SYNC_GROUP, 4);
+ht_wal_recover(&wal, recovered_table);
+ht_print_table(recovered_table);
+ht_delete_all(recovered_table);
+free(recovered_table);
+ht_wal_close(&wal);
+remove("test_wal.log");
+ENDTEST
+
+TEST(test_wal_partial_write, "Recover the log after a partial group write")
+ht_init(test_table);
+ht_wal_t wal;
+remove("test_wal.log");
+ht_wal_open(&wal, "test_wal.log", HT_WAL_SYNC_GROUP, 4);
+for (int i = 0; i < 4; i++) {
+  ht_wal_insert(&wal, test_table, TEST_DATA[i].key, TEST_DATA[i].value);
+}
+// Limit veľkosti súboru preruší zápis druhej skupiny v jej polovici
+struct rlimit limit, saved;
+getrlimit(RLIMIT_FSIZE, &saved);
+limit = saved;
+limit.rlim_cur = (rlim_t)wal.size + 40;
+signal(SIGXFSZ, SIG_IGN);
+setrlimit(RLIMIT_FSIZE, &limit);
+bool written = true;
+for (int i = 4; i < 8; i++) {
+  written = ht_wal_insert(&wal, test_table, TEST_DATA[i].key,
+                          TEST_DATA[i].value) && written;
+}
+setrlimit(RLIMIT_FSIZE, &saved);
+signal(SIGXFSZ, SIG_DFL);
+printf("Second group written: %s, failed: %s\n", written ? "yes" : "no",
+       wal.failed ? "yes" : "no");
+printf("Insert after failure: %s\n",
+       ht_wal_insert(&wal, test_table, "Monero", 1.0) ? "yes" : "no");
+ht_wal_close(&wal);
+ht_table_t *recovered_table;
+init_test_table(&recovered_table);
+ht_init(recovered_table);
+ht_wal_open(&wal, "test_wal.log", HT_WAL_SYNC_GROUP, 4);
+ht_wal_recover(&wal, recovered_table);
+printf("Log size after recovery: %llu\n", (unsigned long long)wal.size);
+ht_print_table(recovered_table);
+ht_delete_all(recovered_table);
+free(recovered_table);
+ht_wal_close(&wal);
+remove("test_wal.log");
+ENDTEST
+
+TEST(test_key_kernels, "Compare vectorized key sums with the scalar one")
+ht_init(test_table);
+INSERT_TEST_DATA(test_table)
+const ht_key_ops_t *kernels[] = {
+#if defined(__x86_64__) || defined(__i386__)
+    &HT_KEY_SSE2, &HT_KEY_AVX2,
+#endif
+    &HT_KEY_SCALAR};
+char key[80];
+bool identical = true;
+for (int length = 0; length < 70; length++) {
+  for (int offset = 0; offset < 8; offset++) {
+    for (int i = 0; i < offset + length; i++) {
+      key[i] = (char)(1 + (i * 37 + length) % 255);
+    }
+    key[offset + length] = '\0';
+    size_t expected_length;
+    int expected = HT_KEY_SCALAR.sum(key + offset, &expected_length);
+    for (size_t k = 0; k < sizeof(kernels) / sizeof(kernels[0]); k++) {
+      if (!ht_key_supported(kernels[k])) continue;
+      size_t kernel_length;
+      int sum = kernels[k]->sum(key + offset, &kernel_length);
+      identical &= sum == expected && kernel_length == expected_length;
+    }
+    size_t length;
+    int sum = ht_key_sum(key + offset, &length);
+    identical &= sum == expected && length == expected_length;
+  }
+}
+printf("Identical results: %s\n", identical ? "yes" : "no");
+ENDTEST
+
+TEST(test_insert_bulk, "Insert many items in parallel")
+ht_init(test_table);
+ht_insert_bulk(test_table, TEST_DATA, sizeof(TEST_DATA) / sizeof(TEST_DATA[0]),
+               4);
+ht_item_t updates[] = {{"Ethereum", 12.34}, {"Ethereum", 56.78}};
+ht_insert_bulk(test_table, updates, 2, 2);
+ht_print_item_value(ht_get(test_table, "Ethereum"));
+ENDTEST
+
+TEST(test_stats, "Collect probe length and allocation statistics")
+ht_stats_reset();
+ht_init(test_table);
+INSERT_TEST_DATA(test_table)
+for (int i = 0; i < 15; i++) {
+  ht_search(test_table, TEST_DATA[i].key);
+}
+ht_delete(test_table, "Terra");
+ht_stats_dump(stdout);
+ENDTEST
+
+TEST(test_cache, "Evict the least recently used items from a bounded cache")
+ht_cache_t cache;
+ht_cache_init(&cache, test_table, 4, test_cache_removed, test_table);
+for (int i = 0; i < 4; i++) {
+  ht_cache_put(&cache, TEST_DATA[i].key, TEST_DATA[i].value);
+}
+ht_print_item_value(ht_cache_get(&cache, "Bitcoin"));
+ht_print_item_value(ht_cache_get(&cache, "Solana"));
+ht_cache_put(&cache, "Solana", 134.50);
+ht_cache_put(&cache, "Tether", 0.86);
+ht_cache_remove(&cache, "Cardano");
+ht_print_item_value(ht_cache_get(&cache, "Ethereum"));
+printf("Hits: %lu, misses: %lu, evictions: %lu\n", cache.hits, cache.misses,
+       cache.evictions);
+ht_print_table(test_table);
+ht_cache_clear(&cache);
+ENDTEST
+
+TEST(test_ttl, "Expire items using the timer wheel")
+ht_ttl_t ttl;
+ht_ttl_init(&ttl, test_table, 1000, test_ttl_expired, NULL);
+for (int i = 0; i < 6; i++) {
+  ht_ttl_put(&ttl, TEST_DATA[i].key, TEST_DATA[i].value, 1000 + (i + 1) * 50);
+}
+ht_ttl_put(&ttl, "Solana", 134.50, 1000 + 1000000);
+ht_print_item_value(ht_ttl_get(&ttl, "Bitcoin", 1049));
+ht_print_item_value(ht_ttl_get(&ttl, "Bitcoin", 1050));
+printf("Expired at 1120: %zu\n", ht_ttl_advance(&ttl, 1120));
+ht_ttl_put(&ttl, "Tether", 0.86, 5000);
+printf("Expired at 2000: %zu\n", ht_ttl_advance(&ttl, 2000));
+ht_print_item_value(ht_ttl_get(&ttl, "Tether", 2000));
+printf("Expired at 1001000: %zu\n", ht_ttl_advance(&ttl, 1001000));
+printf("Items: %zu, expirations: %lu\n", ttl.count, ttl.expirations);
+ht_print_table(test_table);
+ht_ttl_clear(&ttl);
+ENDTEST
+
+TEST(test_column_reduce, "Aggregate values of a regular and a columnar table")
+ht_init(test_table);
+INSERT_TEST_DATA(test_table)
+ht_column_t column;
+ht_column_init(&column);
+for (int i = 0; i < sizeof(TEST_DATA) / sizeof(TEST_DATA[0]); i++) {
+  ht_column_insert(&column, TEST_DATA[i].key, TEST_DATA[i].value);
+}
+ht_delete(test_table, "Bitcoin");
+ht_column_delete(&column, "Bitcoin");
+ht_column_insert(&column, "Tether", 1.00);
+ht_insert(test_table, "Tether", 1.00);
+ht_print_item_value(ht_column_get(&column, "Chainlink"));
+ht_print_item_value(ht_column_get(&column, "Bitcoin"));
+printf("Sum: %.2f %.2f\n", ht_reduce(test_table, HT_REDUCE_SUM),
+       ht_column_reduce(&column, HT_REDUCE_SUM));
+printf("Min: %.2f %.2f\n", ht_reduce(test_table, HT_REDUCE_MIN),
+       ht_column_reduce(&column, HT_REDUCE_MIN));
+printf("Max: %.2f %.2f\n", ht_reduce(test_table, HT_REDUCE_MAX),
+       ht_column_reduce(&column, HT_REDUCE_MAX));
+printf("Items: %zu, capacity: %zu, memory: %zu bytes\n", column.count,
+       column.capacity, ht_column_memory(&column));
+ht_column_dispose(&column);
+ENDTEST
+
+TEST(test_filter, "Reject missing keys using an attached filter")
+ht_init(test_table);
+ht_filter_t filter;
+ht_filter_init(&filter, 32, 0.01);
+ht_filter_attach(test_table, &filter);
+INSERT_TEST_DATA(test_table)
+ht_delete(test_table, "Terra");
+const char *missing[] = {"Terra", "Monero", "Stellar", "Tron", "Cosmos"};
+int found = 0;
+for (int i = 0; i < 5; i++) {
+  found += ht_search(test_table, (char *)missing[i]) != NULL;
+}
+for (int i = 0; i < sizeof(TEST_DATA) / sizeof(TEST_DATA[0]); i++) {
+  found += ht_search(test_table, TEST_DATA[i].key) != NULL;
+}
+printf("Found: %d, filter items: %zu, memory: %zu bytes\n", found,
+       filter.items, ht_filter_memory(&filter));
+HT_STAT(printf("Filter answers: %lu, rejected: %lu\n", filter.checks,
+               filter.rejections);)
+ht_filter_detach(test_table);
+ht_filter_dispose(&filter);
+ENDTEST
+
+TEST(test_move_to_front, "Move found items to the front of their chains")
+ht_init(test_table);
+INSERT_TEST_DATA(test_table)
+HT_MOVE_TO_FRONT = true;
+ht_print_item(ht_search(test_table, "Terra"));
+ht_print_item_value(ht_get(test_table, "Bitcoin"));
+ht_print_item(ht_search(test_table, "Monero"));
+HT_MOVE_TO_FRONT = false;
+ENDTEST
+
+TEST(test_batch, "Apply a batch of operations grouped by bucket")
+ht_init(test_table);
+INSERT_TEST_DATA(test_table)
+ht_batch_op_t ops[] = {
+    {HT_BATCH_GET, "Terra"},          {HT_BATCH_DELETE, "Terra"},
+    {HT_BATCH_GET, "Terra"},          {HT_BATCH_INSERT, "Monero", 250.12},
+    {HT_BATCH_GET, "Monero"},         {HT_BATCH_INSERT, "Bitcoin", 60000},
+    {HT_BATCH_GET, "Bitcoin"},        {HT_BATCH_DELETE, "Stellar"},
+    {HT_BATCH_INSERT, "Terra", 1.23}, {HT_BATCH_GET, "Chainlink"}};
+int op_count = sizeof(ops) / sizeof(ops[0]);
+ht_batch(test_table, ops, op_count);
+for (int i = 0; i < op_count; i++) {
+  static const char *types[] = {"get", "insert", "delete"};
+  printf("%s %s: found %s", types[ops[i].type], ops[i].key,
+         ops[i].found ? "true" : "false");
+  if (ops[i].type == HT_BATCH_GET && ops[i].found) {
+    printf(", value %.2f", ops[i].value);
+  }
+  printf("\n");
+}
+ENDTEST
+
+TEST(test_scan, "Scan the table with a cursor while modifying it")
+ht_init(test_table);
+INSERT_TEST_DATA(test_table)
+int cursor = 0, reported = 0, calls = 0;
+do {
+  cursor = ht_scan(test_table, cursor, 3, test_scan_print, &reported);
+  printf(" -> %d\n", cursor);
+  if (calls++ == 0) {
+    ht_delete(test_table, "Bitcoin");
+    ht_insert(test_table, "Monero", 250.12);
+  }
+} while (cursor != 0);
+printf("Reported: %d in %d calls\n", reported, calls);
+ENDTEST
+
+TEST(test_iterator, "Iterate over a sorted snapshot of the table")
+ht_init(test_table);
+INSERT_TEST_DATA(test_table)
+ht_iterator_t iterator;
+ht_iterator_init(&iterator, test_table, true);
+ht_delete(test_table, "Terra");
+ht_insert(test_table, "Ethereum", 12.34);
+ht_item_t *item;
+while ((item = ht_iterator_next(&iterator)) != NULL) {
+  printf("(%s,%.2f)", item->key, item->value);
+}
+printf("\n");
+ht_iterator_dispose(&iterator);
+ENDTEST
+
+TEST(test_perfect, "Look up keys in a generated perfect table")
+ht_init(test_table);
+printf("Size: %d\n", perfect_test_SIZE);
+int perfect_slots = 0;
+for (int i = 0; i < sizeof(TEST_DATA) / sizeof(TEST_DATA[0]); i++) {
+  float *value = perfect_test_get(TEST_DATA[i].key);
+  if (value != NULL && *value == TEST_DATA[i].value) {
+    perfect_slots |= 1 << perfect_test_index(TEST_DATA[i].key);
+  }
+}
+printf("Distinct slots: %s\n",
+       perfect_slots == (1 << perfect_test_SIZE) - 1 ? "true" : "false");
+ht_print_item_value(perfect_test_get("Monero"));
+ht_print_item_value(perfect_test_get("Bitcoi"));
+*perfect_test_get("Terra") = 1.23;
+ht_print_item_value(perfect_test_get("Terra"));
+ENDTEST
+
+TEST(test_memory, "Report memory usage and reject growth over a cap")
+ht_init(test_table);
+ht_memory_t counters, other_counters;
+ht_memory_attach(test_table, &counters);
+ht_table_t *other_table = malloc(sizeof(ht_table_t));
+ht_init(other_table);
+INSERT_TEST_DATA(test_table)
+ht_insert(other_table, "Tether", 1.00);
+ht_memory_attach(other_table, &other_counters);
+ht_memory_t usage;
+ht_memory_usage(test_table, &usage);
+printf("Buckets: %zu\n", usage.buckets);
+printf("Items: %zu\n", usage.items);
+printf("Keys: %zu\n", usage.keys);
+printf("Slack: %zu\n", usage.slack);
+ht_memory_usage(other_table, &usage);
+printf("Other table items: %zu, keys: %zu\n", usage.items / sizeof(ht_item_t),
+       usage.keys);
+ht_memory_usage(NULL, &usage);
+printf("All tables items: %zu\n", usage.items / sizeof(ht_item_t));
+ht_memory_detach(other_table);
+ht_delete_all(other_table);
+free(other_table);
+ht_delete_all(test_table);
+ht_memory_usage(test_table, &usage);
+printf("Items after delete: %zu\n", usage.items);
+test_cap_t cap = {0, 4 * sizeof(ht_item_t)};
+ht_allocator_t allocator = {test_cap_allocate, test_cap_release, NULL, &cap};
+ht_set_allocator(&allocator);
+INSERT_TEST_DATA(test_table)
+ht_memory_usage(test_table, &usage);
+printf("Items under cap: %zu\n", usage.items / sizeof(ht_item_t));
+printf("Slack under cap: %zu\n", usage.slack);
+printf("Rejections: %lu\n", usage.rejections);
+ht_delete_all(test_table);
+bool bulk_ok = ht_insert_bulk(
+    test_table, TEST_DATA, sizeof(TEST_DATA) / sizeof(TEST_DATA[0]), 1);
+ht_memory_usage(test_table, &usage);
+printf("Bulk under cap: %s, items: %zu, rejections: %lu\n",
+       bulk_ok ? "yes" : "no", usage.items / sizeof(ht_item_t),
+       usage.rejections);
+ht_delete_all(test_table);
+ht_set_allocator(NULL);
+ht_memory_detach(test_table);
+printf("Cap used: %zu\n", cap.used);
+ENDTEST
+
 int main(int argc, char *argv[]) {
   init_uninitialized_item();
   init_test();
@@ -90,6 +518,23 @@ int main(int argc, char *argv[]) {
   test_get();
   test_delete();
   test_delete_all();
+  test_snapshot();
+  test_snapshot_restore();
+  test_wal_recover();
+  test_wal_partial_write();
+  test_key_kernels();
+  test_insert_bulk();
+  test_stats();
+  test_cache();
+  test_ttl();
+  test_column_reduce();
+  test_filter();
+  test_move_to_front();
+  test_batch();
+  test_scan();
+  test_iterator();
+  test_perfect();
+  test_memory();
 
   free(uninitialized_item);
 }
@@ -0,0 +1,289 @@
+/*
+ * Expirácia prvkov tabuľky s rozptýlenými položkami
+ *
+ * Invariant kolesa: záznam na úrovni l > 0 v slote s sa má presunúť v čase
+ * T, ktorý je prvým násobkom HT_TTL_SLOTS^l väčším ako ttl->now s indexom
+ * slotu s na úrovni l; záznam na úrovni 0 expiruje práve v čase svojho
+ * slotu. Každý takýto čas leží v intervale (now, now + HT_TTL_SLOTS^(l+1)]
+ * a dá sa zo slotu jednoznačne určiť, takže najbližšiu udalosť úrovne
+ * nájde jedno rotovanie bitovej mapy a počítanie koncových núl.
+ */
+
+#include "ttl.h"
+#include "filter.h"
+#include "key.h"
+#include "memory.h"
+#include "stats.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define TTL_SLOT_BITS 6
+#define TTL_NONE UINT64_MAX
+
+_Static_assert(HT_TTL_SLOTS == 1 << TTL_SLOT_BITS,
+               "HT_TTL_SLOTS must match TTL_SLOT_BITS");
+
+/*
+ * Vyňatie záznamu z tabuľky. Funkcia vráti dĺžku jeho kľúča.
+ */
+static size_t ttl_unlink_table(ht_ttl_t *ttl, ht_ttl_entry_t *entry) {
+    size_t length;
+    int index = ht_key_sum(entry->item.key, &length) % HT_SIZE;
+    ht_item_t **link = &(*ttl->table)[index];
+
+    while (*link != &entry->item) {
+        link = &(*link)->next;
+    }
+    *link = entry->item.next;
+
+    ht_filter_t *filter = ht_filter_find(ttl->table);
+    if (filter != NULL) ht_filter_remove(filter, entry->item.key);
+    return length;
+}
+
+static void ttl_wheel_remove(ht_ttl_t *ttl, ht_ttl_entry_t *entry) {
+    *entry->previous = entry->next;
+    if (entry->next != NULL) {
+        entry->next->previous = entry->previous;
+    }
+    if (ttl->slots[entry->level][entry->slot] == NULL) {
+        ttl->occupied[entry->level] &= ~(UINT64_C(1) << entry->slot);
+    }
+}
+
+/*
+ * Zaradenie záznamu do kolesa podľa jeho vzdialenosti od ttl->now.
+ * Záznam vzdialený viac, ako pokrýva najvyššia úroveň, sa zaradí na jej
+ * koniec a pri presune sa zaradí znova.
+ */
+static void ttl_wheel_insert(ht_ttl_t *ttl, ht_ttl_entry_t *entry) {
+    uint64_t expires =
+        entry->expires > ttl->now ? entry->expires : ttl->now + 1;
+    uint64_t delta = expires - ttl->now;
+    int level = 0;
+
+    while (level < HT_TTL_LEVELS - 1 &&
+           delta >> (TTL_SLOT_BITS * (level + 1)) != 0) {
+        level++;
+    }
+    if (level == HT_TTL_LEVELS - 1 &&
+        delta >> (TTL_SLOT_BITS * HT_TTL_LEVELS) != 0) {
+        expires = ttl->now +
+                  (UINT64_C(1) << (TTL_SLOT_BITS * HT_TTL_LEVELS)) - 1;
+    }
+
+    int slot = (int)(expires >> (TTL_SLOT_BITS * level)) & (HT_TTL_SLOTS - 1);
+    ht_ttl_entry_t **head = &ttl->slots[level][slot];
+
+    entry->level = (uint8_t)level;
+    entry->slot = (uint8_t)slot;
+    entry->next = *head;
+    entry->previous = head;
+    if (*head != NULL) {
+        (*head)->previous = &entry->next;
+    }
+    *head = entry;
+    ttl->occupied[level] |= UINT64_C(1) << slot;
+}
+
+static void ttl_expire(ht_ttl_t *ttl, ht_ttl_entry_t *entry) {
+    size_t length = ttl_unlink_table(ttl, entry);
+    if (ttl->on_expire != NULL) {
+        ttl->on_expire(&entry->item, ttl->context);
+    }
+    ht_item_release(ttl->table, entry, sizeof(*entry), length);
+    HT_STAT(ht_stats.frees++;)
+    ttl->count--;
+    ttl->expirations++;
+}
+
+/*
+ * Čas najbližšej udalosti na úrovni level alebo TTL_NONE.
+ */
+static uint64_t ttl_next_event(ht_ttl_t *ttl, int level) {
+    uint64_t occupied = ttl->occupied[level];
+    if (occupied == 0) return TTL_NONE;
+
+    int shift = TTL_SLOT_BITS * level;
+    int current = (int)(ttl->now >> shift) & (HT_TTL_SLOTS - 1);
+    int start = (current + 1) & (HT_TTL_SLOTS - 1);
+    uint64_t rotated =
+        start == 0 ? occupied
+                   : occupied >> start | occupied << (HT_TTL_SLOTS - start);
+    int slot = (start + __builtin_ctzll(rotated)) & (HT_TTL_SLOTS - 1);
+
+    uint64_t span = UINT64_C(1) << (shift + TTL_SLOT_BITS);
+    uint64_t event = (ttl->now & ~(span - 1)) + ((uint64_t)slot << shift);
+    if (event <= ttl->now) {
+        event += span;
+    }
+    return event;
+}
+
+/*
+ * Inicializácia prázdnej tabuľky s expiráciou v čase now. Tabuľka sa
+ * inicializuje funkciou ht_init.
+ *
+ * Funkcia on_expire (môže byť NULL) sa zavolá pre každý expirovaný prvok,
+ * keď už nie je v tabuľke; môže teda uvoľniť jeho kľúč.
+ */
+void ht_ttl_init(ht_ttl_t *ttl, ht_table_t *table, uint64_t now,
+                 ht_ttl_expire_t on_expire, void *context) {
+    ht_init(table);
+    ttl->table = table;
+    ttl->now = now;
+    for (int level = 0; level < HT_TTL_LEVELS; level++) {
+        ttl->occupied[level] = 0;
+        for (int slot = 0; slot < HT_TTL_SLOTS; slot++) {
+            ttl->slots[level][slot] = NULL;
+        }
+    }
+    ttl->on_expire = on_expire;
+    ttl->context = context;
+    ttl->count = 0;
+    ttl->expirations = 0;
+}
+
+/*
+ * Vloženie prvku, ktorý je platný do času expires (nevrátane).
+ *
+ * Pokiaľ prvok s daným kľúčom už existuje, nahradí sa jeho hodnota aj čas
+ * expirácie. Prvok, ktorého čas expirácie už uplynul, odstráni až najbližší
+ * posun kolesa; funkcia ht_ttl_get ho však už nevráti.
+ */
+void ht_ttl_put(ht_ttl_t *ttl, char *key, float value, uint64_t expires) {
+    ht_item_t *item = ht_search(ttl->table, key);
+    ht_ttl_entry_t *entry = (ht_ttl_entry_t *)item;
+
+    if (entry != NULL) {
+        ttl_wheel_remove(ttl, entry);
+    } else {
+        entry = ht_item_allocate(ttl->table, sizeof(ht_ttl_entry_t),
+                                 strlen(key));
+        if (entry == NULL) return;
+        HT_STAT(ht_stats.allocations++;)
+
+        size_t length;
+        int index = ht_key_sum(key, &length) % HT_SIZE;
+        entry->item.key = key;
+        entry->item.next = (*ttl->table)[index];
+        (*ttl->table)[index] = &entry->item;
+        ttl->count++;
+
+        ht_filter_t *filter = ht_filter_find(ttl->table);
+        if (filter != NULL) ht_filter_add(filter, key);
+    }
+
+    entry->item.value = value;
+    entry->expires = expires;
+    ttl_wheel_insert(ttl, entry);
+}
+
+/*
+ * Získanie hodnoty platnej v čase now.
+ *
+ * V prípade úspechu vráti funkcia ukazovateľ na hodnotu prvku. Pokiaľ prvok
+ * neexistuje alebo už expiroval, vráti hodnotu NULL; expirovaný prvok sa
+ * zároveň odstráni.
+ */
+float *ht_ttl_get(ht_ttl_t *ttl, char *key, uint64_t now) {
+    ht_ttl_entry_t *entry = (ht_ttl_entry_t *)ht_search(ttl->table, key);
+    if (entry == NULL) return NULL;
+
+    if (entry->expires <= now) {
+        ttl_wheel_remove(ttl, entry);
+        ttl_expire(ttl, entry);
+        return NULL;
+    }
+    return &entry->item.value;
+}
+
+/*
+ * Odstránenie prvku bez ohľadu na čas expirácie. Funkcia on_expire sa
+ * nezavolá.
+ *
+ * V prípade úspechu vráti funkcia hodnotu true, pokiaľ prvok neexistuje,
+ * vráti hodnotu false.
+ */
+bool ht_ttl_remove(ht_ttl_t *ttl, char *key) {
+    ht_ttl_entry_t *entry = (ht_ttl_entry_t *)ht_search(ttl->table, key);
+    if (entry == NULL) return false;
+
+    ttl_wheel_remove(ttl, entry);
+    size_t length = ttl_unlink_table(ttl, entry);
+    ht_item_release(ttl->table, entry, sizeof(*entry), length);
+    HT_STAT(ht_stats.frees++;)
+    ttl->count--;
+    return true;
+}
+
+/*
+ * Posun kolesa do času now a odstránenie všetkých prvkov, ktorých čas
+ * expirácie je menší alebo rovný now.
+ *
+ * Funkcia vráti počet expirovaných prvkov. Čas sa nevracia: pre now menšie
+ * ako čas predchádzajúceho posunu funkcia nerobí nič.
+ */
+size_t ht_ttl_advance(ht_ttl_t *ttl, uint64_t now) {
+    unsigned long expirations = ttl->expirations;
+
+    while (ttl->now < now) {
+        uint64_t events[HT_TTL_LEVELS];
+        uint64_t next = TTL_NONE;
+        for (int level = 0; level < HT_TTL_LEVELS; level++) {
+            events[level] = ttl_next_event(ttl, level);
+            if (events[level] < next) next = events[level];
+        }
+        if (next > now) {
+            ttl->now = now;
+            break;
+        }
+        ttl->now = next;
+
+        // Vyššie úrovne sa presúvajú skôr, presunuté záznamy nikdy
+        // nepadnú do slotu s udalosťou v čase next
+        for (int level = HT_TTL_LEVELS - 1; level >= 0; level--) {
+            if (events[level] != next) continue;
+
+            int shift = TTL_SLOT_BITS * level;
+            int slot = (int)(next >> shift) & (HT_TTL_SLOTS - 1);
+            ht_ttl_entry_t *entry = ttl->slots[level][slot];
+            ttl->slots[level][slot] = NULL;
+            ttl->occupied[level] &= ~(UINT64_C(1) << slot);
+
+            while (entry != NULL) {
+                ht_ttl_entry_t *following = entry->next;
+                if (entry->expires <= next) {
+                    ttl_expire(ttl, entry);
+                } else {
+                    ttl_wheel_insert(ttl, entry);
+                }
+                entry = following;
+            }
+        }
+    }
+
+    return ttl->expirations - expirations;
+}
+
+/*
+ * Odstránenie všetkých prvkov. Funkcia on_expire sa nezavolá.
+ */
+void ht_ttl_clear(ht_ttl_t *ttl) {
+    for (int level = 0; level < HT_TTL_LEVELS; level++) {
+        for (int slot = 0; slot < HT_TTL_SLOTS; slot++) {
+            ht_ttl_entry_t *entry = ttl->slots[level][slot];
+            while (entry != NULL) {
+                ht_ttl_entry_t *next = entry->next;
+                ht_item_release(ttl->table, entry, sizeof(*entry),
+                                strlen(entry->item.key));
+                HT_STAT(ht_stats.frees++;)
+                entry = next;
+            }
+            ttl->slots[level][slot] = NULL;
+        }
+        ttl->occupied[level] = 0;
+    }
+    ht_init(ttl->table);
+    ttl->count = 0;
+}
@@ -0,0 +1,66 @@
+/*
+ * Hlavičkový súbor pre expiráciu prvkov tabuľky s rozptýlenými položkami.
+ *
+ * Každý prvok má čas expirácie v tikoch, ktorých význam (milisekundy,
+ * sekundy, ...) určuje volajúci; čas sa funkciám odovzdáva explicitne.
+ * Prvky čakajúce na expiráciu sú zaradené v hierarchickom časovom kolese
+ * (timer wheel) s HT_TTL_LEVELS úrovňami po HT_TTL_SLOTS slotoch. Úroveň l
+ * pokrýva časy vzdialené najviac HT_TTL_SLOTS^(l+1) tikov; pri prechode
+ * slotom vyššej úrovne sa jeho prvky presunú do nižších úrovní.
+ *
+ * Obsadené sloty každej úrovne sú označené v bitovej mape, takže posun
+ * kolesa preskočí prázdne sloty a jeho cena závisí od počtu expirovaných
+ * prvkov, nie od veľkosti tabuľky ani od dĺžky preskočeného času.
+ *
+ * Prvky sú intrusívne rovnako ako v cache.h: ht_item_t je prvou položkou
+ * záznamu. Kým tabuľku používa koleso, smú ju meniť iba funkcie ht_ttl_*.
+ * Záznamy uvoľňuje ht_ttl_clear; ht_delete_all by ich v spotrebe pamäte
+ * (memory.h) odpočítala ako ht_item_t.
+ */
+
+#ifndef IAL_HASHTABLE_TTL_H
+#define IAL_HASHTABLE_TTL_H
+
+#include "hashtable.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Počet úrovní kolesa a počet slotov jednej úrovne
+#define HT_TTL_LEVELS 6
+#define HT_TTL_SLOTS 64
+
+// Funkcia volaná pri odstránení expirovaného prvku
+typedef void (*ht_ttl_expire_t)(ht_item_t *item, void *context);
+
+// Záznam s časom expirácie
+typedef struct ht_ttl_entry {
+  ht_item_t item;                 // prvok tabuľky, musí byť prvý
+  uint64_t expires;               // prvok je neplatný od tohto času
+  struct ht_ttl_entry *next;      // ďalší záznam v slote kolesa
+  struct ht_ttl_entry **previous; // odkaz na tento záznam v slote kolesa
+  uint8_t level;                  // poloha záznamu v kolese
+  uint8_t slot;
+} ht_ttl_entry_t;
+
+// Tabuľka s expiráciou
+typedef struct ht_ttl {
+  ht_table_t *table;
+  uint64_t now;                   // čas, do ktorého je koleso spracované
+  uint64_t occupied[HT_TTL_LEVELS]; // bitové mapy obsadených slotov
+  ht_ttl_entry_t *slots[HT_TTL_LEVELS][HT_TTL_SLOTS];
+  ht_ttl_expire_t on_expire;
+  void *context;                  // argument funkcie on_expire
+  size_t count;                   // počet prvkov v tabuľke
+  unsigned long expirations;      // počet expirovaných prvkov
+} ht_ttl_t;
+
+void ht_ttl_init(ht_ttl_t *ttl, ht_table_t *table, uint64_t now,
+                 ht_ttl_expire_t on_expire, void *context);
+void ht_ttl_put(ht_ttl_t *ttl, char *key, float value, uint64_t expires);
+float *ht_ttl_get(ht_ttl_t *ttl, char *key, uint64_t now);
+bool ht_ttl_remove(ht_ttl_t *ttl, char *key);
+size_t ht_ttl_advance(ht_ttl_t *ttl, uint64_t now);
+void ht_ttl_clear(ht_ttl_t *ttl);
+
+#endif
@@ -0,0 +1,326 @@
+/*
+ * Žurnál zmien (write-ahead log) tabuľky s rozptýlenými položkami
+ *
+ * Popis formátu je v súbore wal.h.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "wal.h"
+#include "snapshot.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define FNV_OFFSET 2166136261u
+#define FNV_PRIME 16777619u
+
+// Najdlhší kľúč, ktorý prehranie žurnálu považuje za platný
+#define HT_WAL_MAX_KEY (1u << 20)
+#define HT_WAL_CHUNK_SIZE 4096
+
+static uint32_t wal_checksum(const ht_wal_record_t *record, const char *key) {
+    uint32_t hash = FNV_OFFSET;
+    const unsigned char *bytes = (const unsigned char *)record;
+
+    for (size_t i = sizeof(record->checksum); i < sizeof(*record); i++) {
+        hash ^= bytes[i];
+        hash *= FNV_PRIME;
+    }
+    for (uint32_t i = 0; i < record->key_length; i++) {
+        hash ^= (unsigned char)key[i];
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+static bool wal_write_all(int fd, const void *data, size_t size) {
+    const unsigned char *bytes = data;
+    while (size > 0) {
+        ssize_t written = write(fd, bytes, size);
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        bytes += written;
+        size -= (size_t)written;
+    }
+    return true;
+}
+
+/*
+ * Zápis celého bloku do žurnálu. Pri chybe sa žurnál skráti na poslednú
+ * úplne zapísanú dĺžku, aby sa čiastočne zapísané bajty pri ďalšom zápise
+ * nezopakovali, a prejde do chybového stavu.
+ */
+static bool wal_write(ht_wal_t *wal, const void *data, size_t size) {
+    if (!wal_write_all(wal->fd, data, size)) {
+        if (ftruncate(wal->fd, (off_t)wal->size) != 0) {
+            // Neúplný záznam, ktorý sa nepodarí odrezať, zahodí ht_wal_recover
+        }
+        wal->failed = true;
+        return false;
+    }
+    wal->size += size;
+    return true;
+}
+
+static bool wal_read_all(int fd, void *data, size_t size, off_t offset) {
+    unsigned char *bytes = data;
+    while (size > 0) {
+        ssize_t count = pread(fd, bytes, size, offset);
+        if (count < 0 && errno == EINTR) continue;
+        if (count <= 0) return false;
+        bytes += count;
+        size -= (size_t)count;
+        offset += count;
+    }
+    return true;
+}
+
+/*
+ * Zapísanie obsahu vyrovnávacej pamäte jedným volaním write.
+ *
+ * Pri chybe sa rozpracovaná skupina zahodí. Zlyhaný fsync tiež prevedie
+ * žurnál do chybového stavu, pretože nie je známe, čo z neho je na disku.
+ */
+static bool wal_flush(ht_wal_t *wal, bool sync) {
+    if (wal->failed) return false;
+    if (wal->used > 0) {
+        bool ok = wal_write(wal, wal->buffer, wal->used);
+        wal->used = 0;
+        wal->pending = 0;
+        if (!ok) return false;
+    }
+    if (sync && fsync(wal->fd) != 0) {
+        wal->failed = true;
+        return false;
+    }
+    return true;
+}
+
+static bool wal_append(ht_wal_t *wal, ht_wal_op_t op, char *key, float value) {
+    if (wal->failed) return false;
+
+    size_t key_length = strlen(key);
+    ht_wal_record_t record = {
+        .key_length = (uint32_t)key_length,
+        .value = value,
+        .op = (uint8_t)op,
+    };
+    record.checksum = wal_checksum(&record, key);
+
+    size_t size = sizeof(record) + key_length;
+    if (wal->used + size > HT_WAL_BUFFER_SIZE && !wal_flush(wal, false)) {
+        return false;
+    }
+
+    if (size > HT_WAL_BUFFER_SIZE) {
+        // Celý záznam sa zapíše naraz, aby chyba nenechala v súbore jeho časť
+        unsigned char *data = malloc(size);
+        if (data == NULL) return false;
+        memcpy(data, &record, sizeof(record));
+        memcpy(data + sizeof(record), key, key_length);
+        bool ok = wal_write(wal, data, size);
+        free(data);
+        if (!ok) return false;
+    } else {
+        memcpy(wal->buffer + wal->used, &record, sizeof(record));
+        memcpy(wal->buffer + wal->used + sizeof(record), key, key_length);
+        wal->used += size;
+    }
+
+    wal->pending++;
+    if (wal->sync == HT_WAL_SYNC_ALWAYS) {
+        return wal_flush(wal, true);
+    }
+    if (wal->pending >= wal->group_size) {
+        return wal_flush(wal, wal->sync == HT_WAL_SYNC_GROUP);
+    }
+    return true;
+}
+
+/*
+ * Uloženie kópie kľúča obnoveného zo žurnálu.
+ *
+ * Kľúče žijú v blokoch pamäte žurnálu až do jeho zatvorenia.
+ */
+static char *wal_store_key(ht_wal_t *wal, size_t length) {
+    ht_wal_chunk_t *chunk = wal->keys;
+
+    if (chunk == NULL || chunk->capacity - chunk->used < length + 1) {
+        size_t capacity = length + 1 > HT_WAL_CHUNK_SIZE ? length + 1
+                                                         : HT_WAL_CHUNK_SIZE;
+        chunk = malloc(sizeof(ht_wal_chunk_t) + capacity);
+        if (chunk == NULL) return NULL;
+        chunk->next = wal->keys;
+        chunk->used = 0;
+        chunk->capacity = capacity;
+        wal->keys = chunk;
+    }
+
+    char *key = chunk->data + chunk->used;
+    chunk->used += length + 1;
+    return key;
+}
+
+/*
+ * Otvorenie žurnálu.
+ *
+ * Záznamy sa zapisujú po skupinách najviac group_size záznamov (alebo
+ * HT_WAL_BUFFER_SIZE bajtov). Politika sync určuje, kedy sa volá fsync.
+ *
+ * V prípade úspechu vráti funkcia hodnotu true.
+ */
+bool ht_wal_open(ht_wal_t *wal, const char *path, ht_wal_sync_t sync,
+                 int group_size) {
+    memset(wal, 0, sizeof(*wal));
+    wal->sync = sync;
+    wal->group_size = group_size > 0 ? group_size : 1;
+
+    wal->buffer = malloc(HT_WAL_BUFFER_SIZE);
+    if (wal->buffer == NULL) return false;
+
+    wal->fd = open(path, O_RDWR | O_CREAT | O_APPEND, 0644);
+    struct stat info;
+    if (wal->fd >= 0 && fstat(wal->fd, &info) != 0) {
+        close(wal->fd);
+        wal->fd = -1;
+    }
+    if (wal->fd < 0) {
+        free(wal->buffer);
+        wal->buffer = NULL;
+        return false;
+    }
+    wal->size = (uint64_t)info.st_size;
+    return true;
+}
+
+/*
+ * Zatvorenie žurnálu.
+ *
+ * Zapíše a zosynchronizuje zvyšné záznamy a uvoľní kľúče obnovené zo
+ * žurnálu — tabuľka ich po zatvorení nesmie používať.
+ */
+bool ht_wal_close(ht_wal_t *wal) {
+    bool ok = wal_flush(wal, true);
+    if (close(wal->fd) != 0) ok = false;
+
+    while (wal->keys != NULL) {
+        ht_wal_chunk_t *next = wal->keys->next;
+        free(wal->keys);
+        wal->keys = next;
+    }
+    free(wal->buffer);
+    wal->buffer = NULL;
+    return ok;
+}
+
+/*
+ * Vloženie prvku do tabuľky so zápisom do žurnálu.
+ *
+ * Ak sa záznam nepodarí zapísať, tabuľka sa nezmení a funkcia vráti
+ * hodnotu false.
+ */
+bool ht_wal_insert(ht_wal_t *wal, ht_table_t *table, char *key, float value) {
+    if (!wal_append(wal, HT_WAL_INSERT, key, value)) return false;
+    ht_insert(table, key, value);
+    return true;
+}
+
+/*
+ * Zmazanie prvku z tabuľky so zápisom do žurnálu.
+ *
+ * Ak sa záznam nepodarí zapísať, tabuľka sa nezmení a funkcia vráti
+ * hodnotu false.
+ */
+bool ht_wal_delete(ht_wal_t *wal, ht_table_t *table, char *key) {
+    if (!wal_append(wal, HT_WAL_DELETE, key, 0)) return false;
+    ht_delete(table, key);
+    return true;
+}
+
+/*
+ * Vynútené zapísanie rozpracovanej skupiny a jej synchronizácia na disk.
+ *
+ * Po návrate s hodnotou true sú všetky doterajšie zmeny trvalé.
+ */
+bool ht_wal_commit(ht_wal_t *wal) {
+    return wal_flush(wal, true);
+}
+
+/*
+ * Prehranie žurnálu do tabuľky.
+ *
+ * Záznamy sa aplikujú v poradí, v akom boli zapísané. Prehrávanie skončí pri
+ * prvom neúplnom alebo poškodenom zázname (typicky posledná skupina pred
+ * pádom) a žurnál sa na tomto mieste skráti, aby ďalšie záznamy nasledovali
+ * za posledným platným.
+ *
+ * Keďže každý záznam určuje výsledný stav kľúča, je bezpečné prehrať žurnál
+ * aj nad snapshotom, ktorý už jeho zmeny obsahuje (pád počas kompakcie).
+ */
+bool ht_wal_recover(ht_wal_t *wal, ht_table_t *table) {
+    if (!wal_flush(wal, false)) return false;
+    wal->size = 0;
+
+    struct stat info;
+    if (fstat(wal->fd, &info) != 0) return false;
+
+    off_t offset = 0;
+    while (offset < info.st_size) {
+        ht_wal_record_t record;
+        if (!wal_read_all(wal->fd, &record, sizeof(record), offset)) break;
+        if (record.key_length > HT_WAL_MAX_KEY ||
+            (record.op != HT_WAL_INSERT && record.op != HT_WAL_DELETE)) {
+            break;
+        }
+
+        char *key = wal_store_key(wal, record.key_length);
+        if (key == NULL) return false;
+        if (!wal_read_all(wal->fd, key, record.key_length,
+                          offset + (off_t)sizeof(record))) {
+            break;
+        }
+        key[record.key_length] = '\0';
+        if (wal_checksum(&record, key) != record.checksum) break;
+
+        if (record.op == HT_WAL_INSERT) {
+            ht_insert(table, key, record.value);
+        } else {
+            ht_delete(table, key);
+        }
+        offset += (off_t)(sizeof(record) + record.key_length);
+    }
+
+    wal->size = (uint64_t)offset;
+    if (offset < info.st_size) {
+        return ftruncate(wal->fd, offset) == 0 && fsync(wal->fd) == 0;
+    }
+    return true;
+}
+
+/*
+ * Kompakcia žurnálu.
+ *
+ * Aktuálny stav tabuľky sa uloží ako snapshot do súboru snapshot_path a
+ * žurnál sa vyprázdni. Pri obnove sa najprv načíta snapshot
+ * (ht_snapshot_restore) a potom sa prehrá žurnál (ht_wal_recover).
+ *
+ * Žurnál v chybovom stave sa kompakciou obnoví: snapshot obsahuje aj zmeny,
+ * ktorých záznamy sa nepodarilo zapísať.
+ */
+bool ht_wal_compact(ht_wal_t *wal, ht_table_t *table,
+                    const char *snapshot_path) {
+    if (!wal->failed && !wal_flush(wal, true)) return false;
+    if (!ht_snapshot_save(table, snapshot_path)) return false;
+    if (ftruncate(wal->fd, 0) != 0 || fsync(wal->fd) != 0) return false;
+    wal->used = 0;
+    wal->pending = 0;
+    wal->size = 0;
+    wal->failed = false;
+    return true;
+}
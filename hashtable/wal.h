@@ -0,0 +1,84 @@
+/*
+ * Hlavičkový súbor pre žurnál zmien (write-ahead log) tabuľky s rozptýlenými
+ * položkami.
+ *
+ * Každá zmena tabuľky sa pred aplikovaním zapíše do žurnálu. Záznamy sa
+ * zhromažďujú v pamäti a zapisujú sa po skupinách jedným volaním write
+ * (group commit). Po páde procesu sa tabuľka obnoví zo snapshotu a následným
+ * prehraním žurnálu.
+ *
+ * Ak zápis skupiny zlyhá (napríklad pri zaplnení disku po čiastočnom
+ * zápise), žurnál sa skráti späť na koniec poslednej úplne zapísanej skupiny
+ * a prejde do chybového stavu. Zmeny z nezapísanej skupiny nie sú trvalé,
+ * rovnako ako pri páde, a všetky ďalšie zápisy vrátia hodnotu false.
+ * Chybový stav zruší až ht_wal_compact, ktorý uloží aktuálny stav tabuľky.
+ *
+ * Formát záznamu (natívne poradie bajtov):
+ *   ht_wal_record_t  hlavička záznamu
+ *   char key[key_length]  kľúč bez ukončovacieho znaku '\0'
+ */
+
+#ifndef IAL_HASHTABLE_WAL_H
+#define IAL_HASHTABLE_WAL_H
+
+#include "hashtable.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Predvolená veľkosť vyrovnávacej pamäte žurnálu
+#define HT_WAL_BUFFER_SIZE 65536
+
+// Politika synchronizácie žurnálu na disk
+typedef enum ht_wal_sync {
+  HT_WAL_SYNC_NONE,   // fsync iba pri ht_wal_commit a ht_wal_close
+  HT_WAL_SYNC_GROUP,  // fsync po každom zápise skupiny
+  HT_WAL_SYNC_ALWAYS  // každá operácia je samostatná skupina s fsync
+} ht_wal_sync_t;
+
+// Typ záznamu
+typedef enum ht_wal_op { HT_WAL_INSERT = 1, HT_WAL_DELETE = 2 } ht_wal_op_t;
+
+// Hlavička záznamu
+typedef struct ht_wal_record {
+  uint32_t checksum;   // FNV-1a zvyšku hlavičky a kľúča
+  uint32_t key_length; // dĺžka kľúča
+  float value;         // hodnota (pri mazaní 0)
+  uint8_t op;          // ht_wal_op_t
+  uint8_t padding[3];
+} ht_wal_record_t;
+
+// Blok pamäte pre kľúče obnovené zo žurnálu
+typedef struct ht_wal_chunk {
+  struct ht_wal_chunk *next;
+  size_t used;
+  size_t capacity;
+  char data[];
+} ht_wal_chunk_t;
+
+// Žurnál
+typedef struct ht_wal {
+  int fd;                 // popisovač súboru žurnálu
+  ht_wal_sync_t sync;     // politika synchronizácie
+  int group_size;         // maximálny počet záznamov v skupine
+  int pending;            // počet záznamov vo vyrovnávacej pamäti
+  unsigned char *buffer;  // vyrovnávacia pamäť
+  size_t used;            // obsadená časť vyrovnávacej pamäte
+  uint64_t size;          // dĺžka úplne zapísanej časti súboru
+  bool failed;            // zápis zlyhal, žurnál odmieta ďalšie zápisy
+  ht_wal_chunk_t *keys;   // kľúče obnovené zo žurnálu
+} ht_wal_t;
+
+bool ht_wal_open(ht_wal_t *wal, const char *path, ht_wal_sync_t sync,
+                 int group_size);
+bool ht_wal_close(ht_wal_t *wal);
+
+bool ht_wal_insert(ht_wal_t *wal, ht_table_t *table, char *key, float value);
+bool ht_wal_delete(ht_wal_t *wal, ht_table_t *table, char *key);
+bool ht_wal_commit(ht_wal_t *wal);
+
+bool ht_wal_recover(ht_wal_t *wal, ht_table_t *table);
+bool ht_wal_compact(ht_wal_t *wal, ht_table_t *table,
+                    const char *snapshot_path);
+
+#endif